@@ -60,6 +60,12 @@ if ! groups "$TARGET_USER" | grep -q "\bsudo\b"; then
     sudo usermod -aG sudo "$TARGET_USER"
 fi
 
+# Backlight write access (brightnessctl's udev rule grants it to video)
+if ! groups "$TARGET_USER" | grep -q "\bvideo\b"; then
+    echo "Adding '$TARGET_USER' to video group..."
+    sudo usermod -aG video "$TARGET_USER"
+fi
+
 echo ""
 echo "---------------------------------------------------------------------------------------"
 echo "User setup complete. Username set to: $TARGET_USER"
@@ -121,7 +127,7 @@ sudo nala install -y \
     xwallpaper pkg-config libpoppler-qt5-dev htop python3-pip curl git fuse\
     python3-venv picom redshift onboard samba xdotool alacritty aria2 sqlite3\
     synaptic brightnessctl pavucontrol pulseaudio alsa-utils flatpak libevdev-dev\
-    snapd power-profiles-daemon xprintidle libx11-dev libxtst-dev ntfs-3g \
+    snapd power-profiles-daemon xprintidle libx11-dev libxtst-dev libxrandr-dev libsystemd-dev ntfs-3g \
     kalk vlc qt5-style-kvantum network-manager libpolkit-agent-1-dev aria2 \
     libpolkit-gobject-1-dev peazip aptitude timeshift xdg-utils python3-lxml\
     python3-yaml python3-dateutil python3-pyqt5 python3-packaging python3-request
@@ -332,17 +338,23 @@ echo "[7/10] Building wosp-os apps..."
 cd "$ALT_ROOT" || { echo "ERROR: $ALT_ROOT not found"; exit 1; }
 
 echo "• Building wosp-shell..."
-g++ wosp-shell.cpp -o wosp-shell -std=c++17 -fPIC $(pkg-config --cflags --libs Qt5Widgets)
+g++ wosp-shell.cpp -o wosp-shell -std=c++17 -fPIC $(pkg-config --cflags --libs Qt5Widgets) -lX11 -lXrandr
 chmod +x wosp-shell && sudo mv wosp-shell /usr/local/bin/
+# Host components (see apps/wosp-host.cpp) live in /usr/local/lib/wosp/host
+sudo mkdir -p /usr/local/lib/wosp/host
+g++ -shared -fPIC -DWOSP_HOST_ENTRY wosp-shell.cpp -o wosp-shell.so -std=c++17 $(pkg-config --cflags --libs Qt5Widgets) -lX11 -lXrandr
+sudo mv wosp-shell.so /usr/local/lib/wosp/host/
+# Pre-decode the shell images (1x, so valid on any screen)
+QT_QPA_PLATFORM=offscreen wosp-shell --pack-atlas || true
 
 # ────────────────────────────────────────────────
 
 echo "• Building quick-settings..."
-g++ quicksettings.cpp -o quicksettings.so -shared -fPIC -O2 $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+g++ quicksettings.cpp -o quicksettings.so -shared -fPIC -O2 $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core libsystemd)
 sudo mv quicksettings.so /usr/local/bin/
 
 echo "• Building Left Page..."
-g++ -shared -fPIC -std=c++17 pageLeft.cpp -o pageLeft.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+g++ -shared -fPIC -std=c++17 pageLeft.cpp -o pageLeft.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core) -lX11
 sudo mv pageLeft.so /usr/local/bin/
 
 echo "• Building Right Page..."
@@ -355,6 +367,11 @@ echo "• Building osm-power..."
 g++ -fPIC apps/osm-power.cpp -o osm-power $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
 chmod +x osm-power && sudo mv osm-power /usr/local/bin/
 
+# Zygote entry points (see apps/osm-zygote.cpp) live in /usr/local/lib/wosp
+sudo mkdir -p /usr/local/lib/wosp
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY apps/osm-power.cpp -o osm-power.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+sudo mv osm-power.so /usr/local/lib/wosp/
+
 
 echo "• Compiling osm-powerd daemon..."
 sudo g++ -O2 apps/osm-powerd.cpp -o osm-powerd
@@ -362,6 +379,25 @@ sudo chmod +x osm-powerd && sudo mv osm-powerd /usr/local/bin/
 sudo chown root:root /usr/local/bin/osm-powerd
 sudo chmod 4755 /usr/local/bin/osm-powerd
 
+echo "• Building osm-zygote + osm-launch..."
+g++ -O2 apps/osm-zygote.cpp -o osm-zygote -ldl
+g++ -O2 apps/osm-launch.cpp -o osm-launch
+chmod +x osm-zygote osm-launch && sudo mv osm-zygote osm-launch /usr/local/bin/
+
+echo "• Building wosp-stated..."
+g++ -O2 apps/wosp-stated.cpp -o wosp-stated -lX11 -lXext
+chmod +x wosp-stated && sudo mv wosp-stated /usr/local/bin/
+
+echo "• Building wosp-bus..."
+g++ -O2 apps/wosp-bus.cpp -o wosp-bus
+chmod +x wosp-bus && sudo mv wosp-bus /usr/local/bin/
+
+echo "• Building wosp-host..."
+g++ -fPIC apps/wosp-host.cpp -o wosp-host -ldl $(pkg-config --cflags --libs Qt5Widgets)
+chmod +x wosp-host && sudo mv wosp-host /usr/local/bin/
+g++ -shared -fPIC -DWOSP_HOST_ENTRY apps/wosp-keyboard.cpp -o wosp-keyboard.so $(pkg-config --cflags --libs Qt5Widgets) -lX11 -lXtst
+sudo mv wosp-keyboard.so /usr/local/lib/wosp/host/
+
 
 
 # ────────────────────────────────────────────────
@@ -375,14 +411,20 @@ chmod +x wosp-lock && sudo mv wosp-lock /usr/local/bin/
 echo "• Building wosp-running..."
 g++ osm-running.cpp -o osm-running -fPIC -ldl $(pkg-config --cflags --libs Qt5Widgets) -lX11
 chmod +x osm-running && sudo mv osm-running /usr/local/bin/
+g++ -shared -fPIC -DWOSP_HOST_ENTRY osm-running.cpp -o osm-running.so $(pkg-config --cflags --libs Qt5Widgets) -lX11
+sudo mv osm-running.so /usr/local/lib/wosp/host/
 
 echo "• Building wosp-notification..."
 g++ osm-status.cpp -o osm-status -fPIC -ldl $(pkg-config --cflags --libs Qt5Widgets) -lX11
 chmod +x osm-status && sudo mv osm-status /usr/local/bin/
+g++ -shared -fPIC -DWOSP_HOST_ENTRY osm-status.cpp -o osm-status.so $(pkg-config --cflags --libs Qt5Widgets) -lX11
+sudo mv osm-status.so /usr/local/lib/wosp/host/
 
 echo "• Building osm-paper..."
 g++ -fPIC osm-paper.cpp -o osm-paper $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
 chmod +x osm-paper && sudo mv osm-paper /usr/local/bin/
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY osm-paper.cpp -o osm-paper.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+sudo mv osm-paper.so /usr/local/lib/wosp/
 
 # Icons
 if [ -f "icons/osm-paper.png" ]; then
@@ -395,7 +437,7 @@ cat <<EOF > "$HOME/.local/share/applications/osm-paper.desktop"
 Type=Application
 Name=Wallpapers
 Comment=Picture Manager for wosp-os / OSM-Phone
-Exec=/usr/local/bin/osm-paper
+Exec=/usr/local/bin/osm-launch osm-paper
 Icon=osm-paper
 Terminal=false
 Categories=Utility;FileManager;
@@ -410,8 +452,10 @@ chmod +x osm-paper-restore && sudo cp osm-paper-restore /usr/local/bin/
 
 
 echo "• Building osm-files..."
-g++ -fPIC osm-files.cpp -o osm-files $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+g++ -fPIC osm-files.cpp -o osm-files $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core) -lX11
 chmod +x osm-files && sudo mv osm-files /usr/local/bin/
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY osm-files.cpp -o osm-files.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core) -lX11
+sudo mv osm-files.so /usr/local/lib/wosp/
 
 # Icons
 if [ -f "icons/osm-files.png" ]; then
@@ -424,7 +468,7 @@ cat <<EOF > "$HOME/.local/share/applications/osm-files.desktop"
 Type=Application
 Name=Files
 Comment=File Manager for wosp-os / OSM-Phone
-Exec=/usr/local/bin/osm-files
+Exec=/usr/local/bin/osm-launch osm-files
 Icon=osm-files
 Terminal=false
 Categories=Utility;FileManager;
@@ -437,6 +481,8 @@ chmod +x "$HOME/.local/share/applications/osm-files.desktop"
 echo "• Building osm-viewer..."
 g++ -fPIC osm-viewer.cpp -o osm-viewer $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core poppler-qt5) -Wno-deprecated-declarations
 chmod +x osm-viewer && sudo mv osm-viewer /usr/local/bin/
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY osm-viewer.cpp -o osm-viewer.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core poppler-qt5) -Wno-deprecated-declarations
+sudo mv osm-viewer.so /usr/local/lib/wosp/
 
 if [ -f "icons/osm-viewer.png" ]; then
     sudo cp icons/osm-viewer.png /usr/share/icons/hicolor/64x64/apps/osm-viewer.png
@@ -447,7 +493,7 @@ cat <<EOF > "$HOME/.local/share/applications/osm-viewer.desktop"
 Type=Application
 Name=File Editor/Viewer
 Comment=File Viewer for wosp-os / OSM-Phone
-Exec=/usr/local/bin/osm-viewer %U
+Exec=/usr/local/bin/osm-launch osm-viewer %U
 Icon=osm-viewer
 Terminal=false
 MimeType=application/octet-stream;application/pdf;text/plain;image/*;inode/directory;
@@ -461,6 +507,8 @@ chmod +x "$HOME/.local/share/applications/osm-viewer.desktop"
 echo "• Building osm-draw..."
 g++ -fPIC osm-draw.cpp -o osm-draw -std=c++17 $(pkg-config --cflags --libs Qt5Widgets)
 chmod +x osm-draw && sudo mv osm-draw /usr/local/bin/
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY osm-draw.cpp -o osm-draw.so -std=c++17 $(pkg-config --cflags --libs Qt5Widgets)
+sudo mv osm-draw.so /usr/local/lib/wosp/
 
 if [ -f "icons/osm-draw.png" ]; then
     sudo cp icons/osm-draw.png /usr/share/icons/hicolor/64x64/apps/osm-draw.png
@@ -471,7 +519,7 @@ cat <<EOF > "$HOME/.local/share/applications/osm-draw.desktop"
 Type=Application
 Name=Draw
 Comment=Drawing App for wosp-os / OSM-Phone
-Exec=/usr/local/bin/osm-draw %U
+Exec=/usr/local/bin/osm-launch osm-draw %U
 Icon=osm-draw
 Terminal=false
 Categories=Utility;Drawing;
@@ -484,6 +532,8 @@ chmod +x "$HOME/.local/share/applications/osm-draw.desktop"
 echo "• Building osm-rocker..."
 g++ -fPIC osm-rocker.cpp -o osm-rocker $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
 chmod +x osm-rocker && sudo mv osm-rocker /usr/local/bin/
+g++ -fPIC -shared -DOSM_ZYGOTE_ENTRY osm-rocker.cpp -o osm-rocker.so $(pkg-config --cflags --libs Qt5Widgets Qt5Gui Qt5Core)
+sudo mv osm-rocker.so /usr/local/lib/wosp/
 
 
 # ────────────────────────────────────────────────
@@ -517,11 +567,11 @@ chmod +x "$HOME/.local/share/applications/osm-settings.desktop"
 
 
 echo "• Building wifi.so..."
-g++ -fPIC -shared wifi.cpp -o wifi.so $(pkg-config --cflags --libs Qt5Widgets)
+g++ -fPIC -shared wifi.cpp -o wifi.so $(pkg-config --cflags --libs Qt5Widgets libsystemd)
 sudo mv wifi.so /usr/local/bin/
 
 echo "• Building bluetooth.so..."
-g++ -fPIC -shared bluetooth.cpp -o bluetooth.so $(pkg-config --cflags --libs Qt5Widgets)
+g++ -fPIC -shared bluetooth.cpp -o bluetooth.so $(pkg-config --cflags --libs Qt5Widgets libsystemd)
 sudo mv bluetooth.so /usr/local/bin/
 
 echo "• Building apps.so..."
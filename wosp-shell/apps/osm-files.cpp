@@ -36,6 +36,26 @@
 #include <QPropertyAnimation>
 #include <QEasingCurve>
 #include <QFileDialog>
+#include <QElapsedTimer>
+
+#include "../lib/wosp-appdb.h"
+#include "../lib/wosp-launchtrace.h"
+#include "../lib/wosp-theme.h"
+
+// File entries: one shape per mode and selection state, swapped on select
+static WospTheme::Shape entryShape(const char *bg, const char *hover, const char *pressed,
+                                   int radius, Qt::Alignment align)
+{
+    WospTheme::Shape s;
+    s.background = QColor(bg);
+    s.hover = QColor(hover);
+    s.pressed = QColor(pressed);
+    s.text = Qt::white;
+    s.radius = radius;
+    s.padding = QMargins(10, 10, 10, 10);
+    s.align = align;
+    return s;
+}
 
 class FileBrowser : public QWidget {
 public:
@@ -81,7 +101,8 @@ public:
           shortcutDeleteMode(false),
           settings(nullptr),
           shortcutsAnim(nullptr),
-          shortcutsTargetVisible(false)
+          shortcutsTargetVisible(false),
+          launchTrace(nullptr)
     {
         setStyleSheet("background:#282828; color:white;");
 
@@ -90,63 +111,19 @@ public:
                                  QSettings::IniFormat);
         loadShortcuts();
 
+        launchTrace = new WospLaunchTrace::Tracer(this);
+
         // Card-style list (wide)
-        listNormalStyle =
-            "QPushButton {"
-            " background:#444;"
-            " color:white;"
-            " border:none;"
-            " border-radius:8px;"
-            " padding:10px;"
-            " font-size:15px;"
-            " text-align:left;"
-            "}"
-            "QPushButton:hover { background:#555; }"
-            "QPushButton:pressed { background:#333; }";
-
-        listSelectedStyle =
-            "QPushButton {"
-            " background:#777;"
-            " color:white;"
-            " border:none;"
-            " border-radius:8px;"
-            " padding:10px;"
-            " font-size:15px;"
-            " text-align:left;"
-            "}"
-            "QPushButton:hover { background:#888; }"
-            "QPushButton:pressed { background:#666; }";
+        listNormalShape   = entryShape("#444444", "#555555", "#333333", 8, Qt::AlignLeft | Qt::AlignVCenter);
+        listSelectedShape = entryShape("#777777", "#888888", "#666666", 8, Qt::AlignLeft | Qt::AlignVCenter);
 
         // Card-style grid (tiles)
-        gridNormalStyle =
-            "QPushButton {"
-            " background:#3a3a3a;"
-            " color:white;"
-            " border:none;"
-            " border-radius:12px;"
-            " padding:10px;"
-            " font-size:15px;"
-            " text-align:center;"
-            "}"
-            "QPushButton:hover { background:#4a4a4a; }"
-            "QPushButton:pressed { background:#2a2a2a; }";
-
-        gridSelectedStyle =
-            "QPushButton {"
-            " background:#6a6a6a;"
-            " color:white;"
-            " border:none;"
-            " border-radius:12px;"
-            " padding:10px;"
-            " font-size:15px;"
-            " text-align:center;"
-            "}"
-            "QPushButton:hover { background:#7a7a7a; }"
-            "QPushButton:pressed { background:#5a5a5a; }";
+        gridNormalShape   = entryShape("#3a3a3a", "#4a4a4a", "#2a2a2a", 12, Qt::AlignCenter);
+        gridSelectedShape = entryShape("#6a6a6a", "#7a7a7a", "#5a5a5a", 12, Qt::AlignCenter);
 
         // Start in list mode styles
-        currentNormalStyle = listNormalStyle;
-        currentSelectedStyle = listSelectedStyle;
+        currentNormalShape = listNormalShape;
+        currentSelectedShape = listSelectedShape;
 
         QVBoxLayout *root = new QVBoxLayout(this);
         root->setContentsMargins(20,20,20,20);
@@ -436,8 +413,8 @@ public:
         connect(viewToggleBtn, &QPushButton::toggled, this, [this](bool checked) {
             gridMode = checked;
             viewToggleBtn->setText(checked ? "☷" : "☴");
-            currentNormalStyle  = gridMode ? gridNormalStyle  : listNormalStyle;
-            currentSelectedStyle = gridMode ? gridSelectedStyle : listSelectedStyle;
+            currentNormalShape  = gridMode ? gridNormalShape  : listNormalShape;
+            currentSelectedShape = gridMode ? gridSelectedShape : listSelectedShape;
             listDirectory(currentPath);
         });
 
@@ -599,13 +576,14 @@ private:
     QStringList shortcutsList;
     QPropertyAnimation *shortcutsAnim;
     bool shortcutsTargetVisible;
+    WospLaunchTrace::Tracer *launchTrace;
 
-    QString listNormalStyle;
-    QString listSelectedStyle;
-    QString gridNormalStyle;
-    QString gridSelectedStyle;
-    QString currentNormalStyle;
-    QString currentSelectedStyle;
+    WospTheme::Shape listNormalShape;
+    WospTheme::Shape listSelectedShape;
+    WospTheme::Shape gridNormalShape;
+    WospTheme::Shape gridSelectedShape;
+    WospTheme::Shape currentNormalShape;
+    WospTheme::Shape currentSelectedShape;
 
     QHash<QString, QPushButton*> pathToButton;
     QSet<QString> selectedPaths;
@@ -670,36 +648,18 @@ private:
         QString icon;
     };
 
+    // Served from the shared ~/.cache/wosp-shell/apps.db index
     static QVector<DesktopApp> loadDesktopApps() {
         QVector<DesktopApp> apps;
-        QStringList dirs;
-        dirs << "/usr/share/applications"
-             << QDir::homePath() + "/.local/share/applications";
-
-        for (const QString &dirPath : dirs) {
-            QDir d(dirPath);
-            if (!d.exists())
+        for (const WospAppDb::Entry &e : WospAppDb::load()) {
+            if (e.name.isEmpty() || e.exec.isEmpty())
                 continue;
 
-            QStringList files = d.entryList(QStringList() << "*.desktop", QDir::Files);
-            for (const QString &file : files) {
-                QString full = d.absoluteFilePath(file);
-                QSettings s(full, QSettings::IniFormat);
-                s.beginGroup("Desktop Entry");
-                QString name = s.value("Name").toString();
-                QString exec = s.value("Exec").toString();
-                QString icon = s.value("Icon").toString();
-                s.endGroup();
-
-                if (name.isEmpty() || exec.isEmpty())
-                    continue;
-
-                DesktopApp app;
-                app.name = name;
-                app.exec = exec;
-                app.icon = icon;
-                apps.push_back(app);
-            }
+            DesktopApp app;
+            app.name = e.name;
+            app.exec = e.exec;
+            app.icon = e.icon;
+            apps.push_back(app);
         }
 
         return apps;
@@ -896,9 +856,13 @@ private:
         QString fullPath = fi.absoluteFilePath();
         bool isImg = (!isDir && isImageFile(name));
 
+        // Entry text stays at the 15px the old entry stylesheet forced
+        QFont btnFont = entryFont;
+        btnFont.setPixelSize(15);
+
         QPushButton *btn = new QPushButton;
-        btn->setFont(entryFont);
-        btn->setStyleSheet(currentNormalStyle);
+        btn->setFont(btnFont);
+        WospTheme::setShape(btn, currentNormalShape);
 
         if (gridMode) {
             btn->setMinimumHeight(220);
@@ -973,7 +937,7 @@ private:
                 toggleSelection(p);
             } else {
                 if (isDir) listDirectory(p);
-                else QProcess::startDetached("osm-viewer", QStringList() << p);
+                else launchTraced("osm-viewer", "osm-launch", QStringList() << "osm-viewer" << p);
             }
         });
 
@@ -1096,7 +1060,7 @@ private:
     void applySelectionStyle(const QString &p, bool sel) {
         if (pathToButton.contains(p)) {
             QPushButton *b = pathToButton[p];
-            b->setStyleSheet(sel ? currentSelectedStyle : currentNormalStyle);
+            WospTheme::setShape(b, sel ? currentSelectedShape : currentNormalShape);
         }
     }
 
@@ -1544,9 +1508,11 @@ private:
         QListWidgetItem *cur = list->currentItem();
         QString custom = cmdEdit->text().trimmed();
 
+        QString traceId = "osm-files:custom";
         if (cur) {
             QString execTemplate = cur->data(Qt::UserRole).toString();
             cmd = buildExecCommand(execTemplate, filePath);
+            traceId = "osm-files:" + cur->text();
         } else if (!custom.isEmpty()) {
             if (custom.contains("%f"))
                 cmd = buildExecCommand(custom, filePath);
@@ -1556,11 +1522,19 @@ private:
             return;
         }
 
-        QProcess::startDetached("sh", QStringList() << "-c" << cmd);
+        launchTraced(traceId, "sh", QStringList() << "-c" << cmd);
         clearSelection(true);
         updateActionButtons();
     }
 
+    void launchTraced(const QString &id, const QString &program, const QStringList &args) {
+        QElapsedTimer since;
+        since.start();
+        qint64 pid = 0;
+        if (QProcess::startDetached(program, args, QString(), &pid))
+            launchTrace->begin(id, pid, since);
+    }
+
     void processNextThumbnail() {
         if (imageButtons.isEmpty()) {
             thumbTimer->stop();
@@ -1645,8 +1619,15 @@ private:
     }
 };
 
-int main(int argc, char *argv[]) {
+#ifdef OSM_ZYGOTE_ENTRY
+// Built as /usr/local/lib/wosp/osm-files.so and forked by osm-zygote
+extern "C" int osm_main(int argc, char *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
     QApplication app(argc, argv);
+    WospTheme::install();
 
     QString start;
     if (argc > 1)
@@ -0,0 +1,33 @@
+// osm-launch — start an osm app through osm-zygote, or exec it directly
+//
+//   osm-launch <app> [args...]
+//
+// Sends the app name, cwd, argv and environment to the zygote socket and
+// exits once the zygote reports the forked pid. If the zygote is not
+// running or does not know the app, the app is exec'd in place, so callers
+// can always use osm-launch. The wire format is in lib/wosp-zygote.h.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <unistd.h>
+
+#include "../lib/wosp-zygote.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: osm-launch <app> [args...]\n";
+        return 2;
+    }
+
+    // app name is argv[0] for the child
+    if (!getenv("OSM_NO_ZYGOTE")
+        && WospZygote::launch(std::vector<std::string>(argv + 1, argv + argc)) > 0)
+        return 0;
+
+    execvp(argv[1], argv + 1);
+    perror("osm-launch: execvp");
+    return 127;
+}
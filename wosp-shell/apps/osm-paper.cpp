@@ -487,7 +487,12 @@ private:
     }
 };
 
+#ifdef OSM_ZYGOTE_ENTRY
+// Built as /usr/local/lib/wosp/osm-paper.so and forked by osm-zygote
+extern "C" int osm_main(int argc, char *argv[])
+#else
 int main(int argc, char *argv[])
+#endif
 {
     QApplication app(argc, argv);
 
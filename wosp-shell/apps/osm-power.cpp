@@ -14,6 +14,8 @@
 #include <QFileInfo>
 #include <QDebug>
 
+#include "../lib/wosp-timers.h"
+
 class PowerMenuWindow : public QWidget {
 public:
     explicit PowerMenuWindow(QWidget *parent = nullptr)
@@ -110,9 +112,7 @@ public:
         panelLayout->addWidget(statsPanel);
 
         // Timer to update clock every second
-        QTimer *timer = new QTimer(this);
-        connect(timer, &QTimer::timeout, this, &PowerMenuWindow::updateClock);
-        timer->start(1000);
+        WospTimers::Periodic::minute("power-clock", this, [this]{ updateClock(); });
         updateClock();
 
         updateStyles();
@@ -290,7 +290,13 @@ private slots:
 // ────────────────────────────────
 // main
 // ────────────────────────────────
-int main(int argc, char *argv[]) {
+#ifdef OSM_ZYGOTE_ENTRY
+// Built as /usr/local/lib/wosp/osm-power.so and forked by osm-zygote
+extern "C" int osm_main(int argc, char *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication app(argc, argv);
 
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <chrono>
 #include <fcntl.h>
 #include <unistd.h>
 #include <linux/input.h>
@@ -14,6 +15,10 @@
 #include <dirent.h>
 #include <ctype.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../lib/wosp-bus.h"
 
 static const int MAX_EVENTS = 32;
 
@@ -175,11 +180,56 @@ void run_osm_power_as_user() {
     }
 
     // At this point, getuid() should be the user; env has HOME/USER set.
-    execlp("osm-power", "osm-power", (char*)nullptr);
-    perror("execlp osm-power");
+    // osm-launch forks it from osm-zygote when running, else execs it
+    execlp("osm-launch", "osm-launch", "osm-power", (char*)nullptr);
+    perror("execlp osm-launch");
     _exit(1);
 }
 
+// Ask the user's wosp-shell to open the menu over wosp-bus; saves the
+// fork/setuid/exec round when the session is up. Root may connect to the
+// user's 0600 socket, so only the path has to point at their runtime dir.
+// Never blocks: returns the connection the ACK will arrive on (watched by
+// the epoll loop), or -1 to fall back to spawning right away.
+int request_power_menu_over_bus() {
+    passwd *pw = getTargetUserPw();
+    if (!pw) return -1;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    int len = snprintf(addr.sun_path, sizeof(addr.sun_path),
+                       "/run/user/%u/wosp-bus.sock", unsigned(pw->pw_uid));
+    if (len <= 0 || size_t(len) >= sizeof(addr.sun_path)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+
+    // A short frame on a fresh socket goes out whole or not at all
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || wosp_bus_frame(fd, WOSP_BUS_SEND, "power.menu", nullptr, 0, 1) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Handlers the daemon reached, from the ACK waiting on fd; 0 on anything else
+uint32_t read_bus_ack(int fd) {
+    char buf[sizeof(wosp_bus_header) + WOSP_BUS_MAX_VERB];
+    ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+    if (n < ssize_t(sizeof(wosp_bus_header))) return 0;
+
+    wosp_bus_header h;
+    memcpy(&h, buf, sizeof(h));
+    return h.type == WOSP_BUS_ACK ? h.value : 0;
+}
+
+void spawn_power_menu() {
+    if (fork() == 0) {
+        run_osm_power_as_user();
+    }
+}
+
 int main() {
     std::vector<MonitoredDevice> devices;
 
@@ -251,15 +301,42 @@ int main() {
 
     struct epoll_event events[MAX_EVENTS];
 
+    // power.menu sent over wosp-bus, ACK not in yet
+    int busFd = -1;
+    std::chrono::steady_clock::time_point busDeadline;
+    auto finishBus = [&](bool handled) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, busFd, nullptr);
+        close(busFd);
+        busFd = -1;
+        if (!handled) spawn_power_menu();
+    };
+
     while (true) {
-        int n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+        int timeout = -1;
+        if (busFd >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                busDeadline - std::chrono::steady_clock::now()).count();
+            timeout = left > 0 ? int(left) : 0;
+        }
+        int n = epoll_wait(epfd, events, MAX_EVENTS, timeout);
         if (n < 0)
             continue;
 
+        // Daemon up but nobody answered in time
+        if (n == 0 && busFd >= 0) {
+            finishBus(false);
+            continue;
+        }
+
         for (int i = 0; i < n; i++) {
             int fd = events[i].data.fd;
             struct input_event ev;
 
+            if (fd == busFd) {
+                finishBus(read_bus_ack(fd) > 0);
+                continue;
+            }
+
             while (read(fd, &ev, sizeof(ev)) > 0) {
                 if (ev.type == EV_KEY &&
                     ev.code == KEY_POWER &&
@@ -287,9 +364,18 @@ int main() {
                     // ⚠ Only trigger osm-power if this event came from the
                     // grabbed real "Power Button" device. This prevents Intel
                     // Virtual Buttons / F10 from acting as a power key.
-                    if (src && src->grabbed) {
-                        if (fork() == 0) {
-                            run_osm_power_as_user();
+                    // Key repeats while a request is in flight are the same press
+                    if (src && src->grabbed && busFd < 0) {
+                        busFd = request_power_menu_over_bus();
+                        if (busFd < 0) {
+                            spawn_power_menu();
+                        } else {
+                            busDeadline = std::chrono::steady_clock::now()
+                                        + std::chrono::milliseconds(WOSP_BUS_ACK_TIMEOUT_MS);
+                            struct epoll_event bev;
+                            bev.events = EPOLLIN;
+                            bev.data.fd = busFd;
+                            epoll_ctl(epfd, EPOLL_CTL_ADD, busFd, &bev);
                         }
                     }
                 }
@@ -10,14 +10,16 @@
 #include <QDateTime>
 #include <QDir>
 #include <QStandardPaths>
-#include <QSettings>
 #include <QProcess>
 #include <QMouseEvent>
 #include <QVector>
 #include <QDebug>
 #include <QTimer>
 #include <QThread>
-#include <QGraphicsDropShadowEffect>
+
+#include "../lib/wosp-bus.h"
+#include "../lib/wosp-config.h"
+#include "../lib/wosp-shadow.h"
 
 class OverlayPanel : public QWidget {
 public:
@@ -60,11 +62,7 @@ public:
         );
 
         // Shadow behind panel — same style as osm-running
-        auto *shadow = new QGraphicsDropShadowEffect(panel);
-        shadow->setOffset(0, 0);
-        shadow->setBlurRadius(32);
-        shadow->setColor(QColor(0, 0, 0, 220));
-        panel->setGraphicsEffect(shadow);
+        WospShadow::attach(panel, 32, 26, QColor(0, 0, 0, 220));
 
         QStringList items = {
             "🔊 Volume",
@@ -242,10 +240,11 @@ private:
     }
 
     void setGpioMode(const QString &mode) {
-        QSettings s(QDir::homePath()+"/.config/Alternix/.osm-gpio-mode.ini",
-                    QSettings::IniFormat);
-        s.setValue("mode", mode);
-        s.sync();
+        // Written off the GUI thread; quitting waits for it to land
+        WospConfig::Store *s = WospConfig::Store::open(
+            QDir::homePath() + "/.config/Alternix/.osm-gpio-mode.ini");
+        s->setValue("mode", mode);
+        s->flush();
     }
 
     QWidget* buildToast(const QString &message) {
@@ -317,13 +316,22 @@ private:
     }
 
     void openPowerMenu() {
+        if (WospCommands::send("power.menu")) return;
+
+        // No wosp-bus: let qtile's Super+p binding do it
         QStringList args;
         args << "key" << "Super+p";
         QProcess::startDetached("xdotool", args);
     }
 };
 
-int main(int argc, char *argv[]) {
+#ifdef OSM_ZYGOTE_ENTRY
+// Built as /usr/local/lib/wosp/osm-rocker.so and forked by osm-zygote
+extern "C" int osm_main(int argc, char *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
     QApplication app(argc, argv);
 
     OverlayPanel o;
@@ -9,7 +9,6 @@
 #include <QPushButton>
 #include <QScreen>
 #include <QTimer>
-#include <QGraphicsDropShadowEffect>
 #include <QMouseEvent>
 #include <QLockFile>
 #include <QDir>
@@ -24,13 +23,13 @@
 
 #include <functional>
 
-#include <X11/Xlib.h>
-#include <X11/Xatom.h>
-#include <X11/Xutil.h>
+#include "../lib/wosp-shadow.h"
+#include "../lib/wosp-timers.h"
+#include "../lib/wosp-stacking.h"     // brings in wosp-x11.h
 
 // ───────────────────────────────────────────── X11 helpers
 static Atom getAtom(Display *dpy, const char *name) {
-    return XInternAtom(dpy, name, False);
+    return XInternAtom(dpy, name, 0);
 }
 
 static QString getWindowTitle(Display *dpy, Window win) {
@@ -42,9 +41,9 @@ static QString getWindowTitle(Display *dpy, Window win) {
     unsigned long nitems, after;
     unsigned char *data = nullptr;
 
-    if (XGetWindowProperty(dpy, win, prop, 0, (~0L), False, utf8,
+    if (XGetWindowProperty(dpy, win, prop, 0, (~0L), 0, utf8,
                            &type, &format, &nitems, &after, &data)
-        == Success && data)
+        == 0 && data)
     {
         QString out = QString::fromUtf8((char*)data);
         XFree(data);
@@ -80,9 +79,9 @@ static QPixmap getNetWmIcon(Display *dpy, Window win, int size = 28) {
     unsigned long nitems, after;
     unsigned char *raw = nullptr;
 
-    if (XGetWindowProperty(dpy, win, prop, 0, (~0L), False,
+    if (XGetWindowProperty(dpy, win, prop, 0, (~0L), 0,
                            AnyPropertyType,
-                           &type, &format, &nitems, &after, &raw) != Success || !raw)
+                           &type, &format, &nitems, &after, &raw) != 0 || !raw)
     {
         if (raw) XFree(raw);
         return QPixmap();
@@ -252,16 +251,11 @@ SidePanel::SidePanel(Display *dpy, QWidget *parent)
     inner->addWidget(m_scroll);
     outer->addWidget(m_inner);
 
-    // shadow
-    QGraphicsDropShadowEffect *sh = new QGraphicsDropShadowEffect(this);
-    sh->setBlurRadius(32);
-    sh->setOffset(0, 0);
-    sh->setColor(QColor(0, 0, 0, 220));
-    m_inner->setGraphicsEffect(sh);
+    // shadow, blurred once and cached
+    WospShadow::attach(m_inner, 32, 26, QColor(0, 0, 0, 220));
 
-    QTimer *t = new QTimer(this);
-    t->setInterval(600);
-    connect(t, &QTimer::timeout, [this](){ refreshWindows(); });
+    auto *t = new WospTimers::Periodic("running-poll", 600, this,
+                                       [this](){ refreshWindows(); });
     t->start();
 
     refreshWindows();
@@ -282,7 +276,7 @@ void SidePanel::activateWindow(Window w) {
     e.xclient.data.l[0] = 1;
     e.xclient.data.l[1] = CurrentTime;
 
-    XSendEvent(m_dpy,root,False,
+    XSendEvent(m_dpy,root,0,
                SubstructureNotifyMask|SubstructureRedirectMask,&e);
     XFlush(m_dpy);
 }
@@ -323,8 +317,8 @@ void SidePanel::refreshWindows() {
     unsigned char *data=nullptr;
 
     if(XGetWindowProperty(m_dpy,DefaultRootWindow(m_dpy),
-                          listA,0,(~0L),False,XA_WINDOW,
-                          &type,&format,&n,&after,&data)!=Success || !data)
+                          listA,0,(~0L),0,XA_WINDOW,
+                          &type,&format,&n,&after,&data)!=0 || !data)
     {
         if(data) XFree(data);
         return;
@@ -338,8 +332,8 @@ void SidePanel::refreshWindows() {
     unsigned long ni,ba;
     Window active=0;
     if(XGetWindowProperty(m_dpy,DefaultRootWindow(m_dpy),
-                          actA,0,(~0L),False,AnyPropertyType,
-                          &type,&format,&ni,&ba,&awD)==Success && awD)
+                          actA,0,(~0L),0,AnyPropertyType,
+                          &type,&format,&ni,&ba,&awD)==0 && awD)
     {
         active=*(Window*)awD;
         XFree(awD);
@@ -579,13 +573,8 @@ public:
         show();
         raise();
 
-        // Keep stubbornly on top, like a real gesture edge.
-        m_raiseTimer = new QTimer(this);
-        m_raiseTimer->setInterval(1500);   // 1.5s is usually enough
-        connect(m_raiseTimer, &QTimer::timeout, this, [this]() {
-            this->raise();
-        });
-        m_raiseTimer->start();
+        // Keep stubbornly on top, like a real gesture edge
+        WospStacking::keepOnTop(this);
     }
 
 protected:
@@ -628,26 +617,48 @@ private:
     OverlayRoot *m_overlay;
     bool m_dragging;
     QPoint m_pressPos;
-    QTimer *m_raiseTimer;
 };
 
 // ───────────────────────────────────────────── main
 
-int main(int argc,char**argv) {
-    QApplication app(argc,argv);
-
-    QLockFile lock(QDir::temp().absoluteFilePath("osm-running.lock"));
-    lock.setStaleLockTime(0);
-    if(!lock.tryLock(20))
+// Single-instance lock, X connection and windows; shared by main() and wosp-host
+static int startRunning() {
+    QLockFile *lock = new QLockFile(QDir::temp().absoluteFilePath("osm-running.lock"));
+    lock->setStaleLockTime(0);
+    if(!lock->tryLock(20)) {
+        delete lock;
         return 0;
+    }
 
     Display *dpy=XOpenDisplay(nullptr);
-    if(!dpy) return 1;
+    if(!dpy) {
+        delete lock;
+        return -1;
+    }
+    QObject::connect(qApp, &QCoreApplication::aboutToQuit, [lock, dpy](){
+        delete lock;
+        XCloseDisplay(dpy);
+    });
+
+    OverlayRoot *root = new OverlayRoot(dpy);   // overlay window
+    new ActivationEdgeBar(root);                // always-on-top gesture edge
+    return 1;
+}
+
+#ifdef WOSP_HOST_ENTRY
+// Built as /usr/local/lib/wosp/host/osm-running.so and loaded by wosp-host
+extern "C" int wosp_host_main(int, char **)
+{
+    return startRunning() > 0 ? 0 : 1;
+}
+#else
+int main(int argc,char**argv) {
+    QApplication app(argc,argv);
 
-    OverlayRoot root(dpy);          // overlay window
-    ActivationEdgeBar bar(&root);   // always-on-top gesture edge
+    int started = startRunning();
+    if(started <= 0)
+        return started < 0 ? 1 : 0;
 
-    int r=app.exec();
-    XCloseDisplay(dpy);
-    return r;
+    return app.exec();
 }
+#endif
@@ -23,30 +23,17 @@
 
 #include <unistd.h>  // sysconf
 
+#include "../../lib/wosp-config.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Alternix compact button style
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
@@ -76,37 +63,6 @@ static QString cfgFile()
     return QDir::homePath() + "/.config/Alternix/osm-settings.conf";
 }
 
-static QMap<QString,QString> loadCfg()
-{
-    QMap<QString,QString> map;
-    QFile f(cfgFile());
-    if (!f.exists()) return map;
-
-    if (f.open(QFile::ReadOnly))
-    {
-        QTextStream s(&f);
-        while (!s.atEnd())
-        {
-            QString line = s.readLine().trimmed();
-            if (line.startsWith("#") || !line.contains("="))
-                continue;
-            QStringList parts = line.split("=");
-            if (parts.size() == 2)
-                map[parts[0].trimmed()] = parts[1].trimmed();
-        }
-    }
-    return map;
-}
-
-static void saveCfg(const QMap<QString,QString> &map)
-{
-    QFile f(cfgFile());
-    f.open(QFile::WriteOnly | QFile::Truncate);
-    QTextStream s(&f);
-    for (auto it = map.begin(); it != map.end(); ++it)
-        s << it.key() << "=" << it.value() << "\n";
-}
-
 // -----------------------------------------------------
 // Helper: run command and capture output
 // -----------------------------------------------------
@@ -151,7 +107,7 @@ public:
     {
         setStyleSheet("background:#282828; color:white; font-family:Sans;");
 
-        cfg = loadCfg();
+        cfg = WospConfig::Store::open(cfgFile());
         gatherUserInfo();
 
         QVBoxLayout *root = new QVBoxLayout(this);
@@ -209,7 +165,7 @@ private:
     };
 
     QStackedWidget *m_stack = nullptr;
-    QMap<QString,QString> cfg;
+    WospConfig::Store *cfg = nullptr;
 
     QString m_username;
     QString m_fullName;
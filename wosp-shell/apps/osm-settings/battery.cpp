@@ -18,30 +18,17 @@
 #include <QtMath>
 #include <algorithm>   // for std::max_element
 
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Alternix helpers
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
@@ -351,9 +338,8 @@ public:
         root->addWidget(back, 0, Qt::AlignCenter);
 
         // Timer: 2s refresh
-        m_timer = new QTimer(this);
-        m_timer->setInterval(2000);
-        connect(m_timer, &QTimer::timeout, this, &BatteryPage::refreshBattery);
+        m_timer = new WospTimers::Periodic("settings-battery", 2000, this,
+                                           [this]{ refreshBattery(); });
 
         if (m_stack) {
             connect(m_stack, &QStackedWidget::currentChanged,
@@ -408,7 +394,7 @@ private:
     QLabel *m_statsLabel     = nullptr;
 
     QString m_batteryPath;
-    QTimer *m_timer = nullptr;
+    WospTimers::Periodic *m_timer = nullptr;
 
     QVector<double> m_healthHistory;
     QVector<double> m_dischargeHistory;
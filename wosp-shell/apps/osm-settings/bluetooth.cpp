@@ -7,15 +7,17 @@
 #include <QFrame>
 #include <QScrollArea>
 #include <QScroller>
-#include <QProcess>
-#include <QInputDialog>
 #include <QMessageBox>
+#include <QInputDialog>
+#include <QPointer>
 #include <QFont>
 #include <QList>
 #include <QStringList>
 #include <QSpacerItem>
-#include <QLineEdit>
-#include <QTimer>
+#include <QHash>
+
+#include "../../lib/wosp-bluez.h"
+#include "../../lib/wosp-theme.h"
 
 // ---------------------------------------------------------
 // Helpers
@@ -24,146 +26,13 @@
 static QPushButton* smallBtnBT(const QString &txt) {
     QPushButton *b = new QPushButton(txt);
     b->setFixedSize(180, 60);
-    b->setStyleSheet(
-        "QPushButton {"
-        " background:#444444;"
-        " color:white;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:26px;"
-        " font-weight:bold;"
-        " padding:10px 24px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    );
+    WospTheme::setShape(b, WospTheme::toggleButton(Qt::white));
+    b->setFont(WospTheme::font(26, true));
     return b;
 }
 
-static QString runCommandBT(const QString &program, const QStringList &args)
-{
-    QProcess proc;
-    proc.start(program, args);
-    proc.waitForFinished();
-    QString out = proc.readAllStandardOutput();
-    out += proc.readAllStandardError();
-    return out;
-}
-
-// Non-blocking 60-second bluetoothctl scan
-static void startBluetoothScanLong()
-{
-    // Detach so we do not block the UI / plugin
-    QProcess::startDetached(
-        "bash",
-        QStringList() << "-c"
-                      << "bluetoothctl --timeout 60 scan on >/dev/null 2>&1"
-    );
-}
-
-static bool isBluetoothPowered()
-{
-    QString out = runCommandBT("bluetoothctl", {"show"});
-    // Look for "Powered: yes" or "Powered: no"
-    for (const QString &line : out.split('\n')) {
-        QString trimmed = line.trimmed();
-        if (trimmed.startsWith("Powered:", Qt::CaseInsensitive)) {
-            if (trimmed.contains("yes", Qt::CaseInsensitive))
-                return true;
-            if (trimmed.contains("no", Qt::CaseInsensitive))
-                return false;
-        }
-    }
-    // Fallback: assume off
-    return false;
-}
-
-static void setBluetoothPowered(bool on)
-{
-    if (on)
-        runCommandBT("bluetoothctl", {"power", "on"});
-    else
-        runCommandBT("bluetoothctl", {"power", "off"});
-}
-
-static bool isBluetoothDiscoverable()
-{
-    QString out = runCommandBT("bluetoothctl", {"show"});
-    for (const QString &line : out.split('\n')) {
-        QString trimmed = line.trimmed();
-        if (trimmed.startsWith("Discoverable:", Qt::CaseInsensitive)) {
-            if (trimmed.contains("yes", Qt::CaseInsensitive))
-                return true;
-            if (trimmed.contains("no", Qt::CaseInsensitive))
-                return false;
-        }
-    }
-    return false;
-}
-
-static void setBluetoothDiscoverable(bool on, int timeoutSec = 0)
-{
-    if (on) {
-        if (timeoutSec > 0) {
-            QString script = QString(
-                "echo -e 'discoverable-timeout %1\\ndiscoverable on\\nquit' | bluetoothctl"
-            ).arg(timeoutSec);
-            runCommandBT("bash", {"-c", script});
-        } else {
-            runCommandBT("bash",
-                         {"-c", "echo -e 'discoverable on\nquit' | bluetoothctl"});
-        }
-    } else {
-        runCommandBT("bash",
-                     {"-c", "echo -e 'discoverable off\nquit' | bluetoothctl"});
-    }
-}
-
-struct BluetoothDevice {
-    QString mac;
-    QString name;
-    bool connected = false;
-    bool paired = false;
-};
-
-static QList<BluetoothDevice> getBluetoothDevices()
-{
-    QList<BluetoothDevice> devices;
-
-    // List all known devices
-    QString out = runCommandBT("bluetoothctl", {"devices"});
-    const QStringList lines = out.split('\n', Qt::SkipEmptyParts);
-
-    for (const QString &line : lines) {
-        // Example: "Device AA:BB:CC:DD:EE:FF DeviceName"
-        if (!line.startsWith("Device "))
-            continue;
-
-        QString rest = line.mid(QString("Device ").length()).trimmed();
-        int spaceIdx = rest.indexOf(' ');
-        if (spaceIdx <= 0)
-            continue;
-
-        BluetoothDevice dev;
-        dev.mac = rest.left(spaceIdx).trimmed();
-        dev.name = rest.mid(spaceIdx + 1).trimmed();
-
-        // Query info for paired/connected status
-        QString info = runCommandBT("bluetoothctl", {"info", dev.mac});
-        for (const QString &infLine : info.split('\n')) {
-            QString t = infLine.trimmed();
-            if (t.startsWith("Connected:", Qt::CaseInsensitive)) {
-                dev.connected = t.contains("yes", Qt::CaseInsensitive);
-            } else if (t.startsWith("Paired:", Qt::CaseInsensitive)) {
-                dev.paired = t.contains("yes", Qt::CaseInsensitive);
-            }
-        }
-
-        devices.append(dev);
-    }
-
-    return devices;
-}
+static const int SCAN_SECONDS = 60;
+static const uint VISIBLE_SECONDS = 30;
 
 // ---------------------------------------------------------
 // BluetoothPage widget
@@ -236,7 +105,7 @@ public:
         rootLayout->addWidget(listFrame);
 
         // -------------------------------------------------
-        // Card 2: Empty adapter/info card (same height as WiFi)
+        // Card 2: Adapter status (same height as WiFi)
         // -------------------------------------------------
         QFrame *infoFrame = new QFrame(this);
         infoFrame->setStyleSheet(
@@ -250,7 +119,12 @@ public:
         QVBoxLayout *infoLayout = new QVBoxLayout(infoFrame);
         infoLayout->setContentsMargins(20, 20, 20, 20);
         infoLayout->setSpacing(8);
-        // Intentionally empty for now, just for symmetry with WiFi
+
+        statusLabel = new QLabel(infoFrame);
+        statusLabel->setAlignment(Qt::AlignCenter);
+        statusLabel->setWordWrap(true);
+        statusLabel->setStyleSheet("font-size:26px; background:transparent;");
+        infoLayout->addWidget(statusLabel);
 
         rootLayout->addWidget(infoFrame);
 
@@ -293,51 +167,31 @@ public:
         rootLayout->addLayout(backLayout);
 
         // -------------------------------------------------
-        // Scan refresh timer (for live updates while scanning)
+        // BlueZ: every change arrives as a D-Bus signal
         // -------------------------------------------------
-        scanRefreshTimer = new QTimer(this);
-        scanRefreshTimer->setInterval(2000); // every 2 seconds
-        connect(scanRefreshTimer, &QTimer::timeout, this, [this]() {
-            if (scanInProgress) {
-                refreshDevices();
-            } else {
-                scanRefreshTimer->stop();
-            }
+        bluez = new WospBluez::Client(this);
+        bluez->listen([this]() { updateFromBluez(); });
+        bluez->setAgent([this](const WospBluez::AgentRequest &req, WospBluez::AgentAnswer answer) {
+            showPairingPrompt(req, answer);
         });
 
         // Connections
-        connect(powerButton, &QPushButton::clicked, this, &BluetoothPage::togglePower);
+        connect(powerButton, &QPushButton::clicked, this, [this]() {
+            bluez->setPowered(!bluez->state().powered);
+        });
 
         connect(scanButton, &QPushButton::clicked, this, [this]() {
-            if (!bluetoothPowered) {
+            if (!bluez->state().powered) {
                 QMessageBox::warning(this, "Bluetooth Off",
                                      "Bluetooth is currently turned off.\n"
                                      "Please turn it on before scanning.");
                 return;
             }
 
-            if (scanInProgress)
-                return;
-
-            scanInProgress = true;
-            scanButton->setEnabled(false);
-
-            // Start non-blocking 60s scan
-            startBluetoothScanLong();
-
-            // Start periodic refresh while scanning
-            scanRefreshTimer->start();
-            refreshDevices(); // immediate refresh at start
-
-            // After 60s, re-enable and final refresh
-            QTimer::singleShot(60000, this, [this]() {
-                scanInProgress = false;
-                scanButton->setEnabled(true);
-                refreshDevices();
-            });
-
-            QMessageBox::information(this, "Bluetooth Scan",
-                                     "Scanning for devices for 60 seconds...");
+            if (bluez->scanning())
+                bluez->stopDiscovery();
+            else
+                bluez->startDiscovery(SCAN_SECONDS);
         });
 
         connect(visibleButton, &QPushButton::clicked, this, &BluetoothPage::toggleVisible);
@@ -348,341 +202,320 @@ public:
             }
         });
 
-        // Initial state
-        bluetoothPowered   = isBluetoothPowered();
-        discoverable       = isBluetoothDiscoverable();
-
-        updatePowerButton();
-        updateVisibleButton();
-        refreshDevices();
+        // Placeholder state until the first reply
+        updateFromBluez();
     }
 
 private:
+    struct Row {
+        QFrame *frame = nullptr;
+        QPushButton *deviceButton = nullptr;
+        QPushButton *disconnectBtn = nullptr;
+    };
+
     QStackedWidget *stackedWidget = nullptr;
     QScrollArea *scrollArea = nullptr;
     QWidget *deviceContainer = nullptr;
     QVBoxLayout *deviceLayout = nullptr;
+    QLabel *emptyLbl = nullptr;
+    QLabel *statusLabel = nullptr;
     QPushButton *powerButton = nullptr;
     QPushButton *scanButton = nullptr;
     QPushButton *visibleButton = nullptr;
 
-    bool bluetoothPowered = false;
-    bool discoverable = false;
-    bool scanInProgress = false;
-    QTimer *scanRefreshTimer = nullptr;
+    WospBluez::Client *bluez = nullptr;
+    QHash<QString, Row> rows;   // by BlueZ object path
+    QPointer<QDialog> pairingPrompt;
+    WospBluez::AgentRequest::Kind promptKind = WospBluez::AgentRequest::Cancel;
+    QString promptPath;             // device the open prompt is about
 
-    void clearDeviceList()
+    void updateFromBluez()
     {
-        int count = deviceLayout->count();
-        for (int i = count - 1; i >= 0; --i) {
-            QLayoutItem *item = deviceLayout->itemAt(i);
-            if (item->spacerItem())
-                continue; // keep the final stretch
-            QWidget *w = item->widget();
-            if (w) {
-                deviceLayout->removeWidget(w);
-                w->deleteLater();
-            } else {
-                deviceLayout->removeItem(item);
-                delete item;
-            }
-        }
+        const WospBluez::State &st = bluez->state();
+
+        updatePowerButton(st.powered);
+        updateVisibleButton(st.discoverable);
+        scanButton->setText(st.discovering ? "Stop" : "Scan");
+
+        if (!st.available)
+            statusLabel->setText("No Bluetooth adapter");
+        else if (st.discovering)
+            statusLabel->setText("Scanning for devices...");
+        else if (st.discoverable)
+            statusLabel->setText("Visible to nearby devices");
+        else
+            statusLabel->setText(st.powered ? "Bluetooth is on" : "Bluetooth is off");
+
+        updateDeviceList();
     }
 
-    void refreshDevices()
+    // Keyed on object path: rows are created, updated and moved in place
+    void updateDeviceList()
     {
-        clearDeviceList();
-
-        QList<BluetoothDevice> devices = getBluetoothDevices();
-
-        QFont itemFont;
-        itemFont.setPointSize(itemFont.pointSize() + 4); // roughly 26px equivalent
-
-        for (const BluetoothDevice &dev : devices) {
-            QFrame *rowFrame = new QFrame(deviceContainer);
-            rowFrame->setStyleSheet(
-                "QFrame { "
-                "  background-color:#444444; "
-                "  border-radius:20px; "
-                "  border:1px solid #222222; "
-                "}"
-            );
-            QHBoxLayout *rowLayout = new QHBoxLayout(rowFrame);
-            rowLayout->setContentsMargins(14, 10, 14, 10);
-            rowLayout->setSpacing(10);
-
-            QPushButton *deviceButton = new QPushButton(dev.name, rowFrame);
-            deviceButton->setFlat(true);
-            deviceButton->setStyleSheet(
-                "QPushButton { "
-                "  background-color:transparent; "
-                "  border:none; "
-                "  text-align:left; "
-                "  color:white; "
-                "  font-size:26px;"
-                "}"
-                "QPushButton:pressed { "
-                "  background-color:rgba(255,255,255,30); "
-                "  border-radius:20px; "
-                "}"
-            );
-            deviceButton->setFont(itemFont);
-
-            rowLayout->addWidget(deviceButton, 1);
-
-            // 🕱 Remove device button (always shown) – no color set so emoji keeps native colouring
-            QPushButton *removeBtn = new QPushButton(QStringLiteral("🕱"), rowFrame);
-            removeBtn->setFixedWidth(48);
-            removeBtn->setStyleSheet(
-                "QPushButton { "
-                "  background-color:transparent; "
-                "  border:none; "
-                "  color:#ff4a6a; "
-                "  font-size:32px; "
-                "}"
-        		"QPushButton:hover { color:#ff1616; background:#ad1236; border-radius:18px; }"
-        		"QPushButton:pressed { color:#ffffff; background:#550000; border-radius:18px; }"
-            );
-            rowLayout->addWidget(removeBtn, 0, Qt::AlignRight);
-
-            connect(removeBtn, &QPushButton::clicked, this, [this, dev]() {
-                onRemoveDevice(dev);
-            });
-
-            // Red X disconnect button (only if connected)
-            if (dev.connected) {
-                QPushButton *disconnectBtn = new QPushButton(QStringLiteral("❌"), rowFrame);
-                disconnectBtn->setFixedWidth(40);
-                disconnectBtn->setStyleSheet(
-                    "QPushButton { "
-                    "  background-color:transparent; "
-                    "  border:none; "
-                    "  color:#ff4a6a; "
-                    "  font-size:32px; "
-                    "}"
-        		    "QPushButton:hover { color:#ff1616; background:#ad1236; border-radius:18px; }"
-        		    "QPushButton:pressed { color:#ffffff; background:#550000; border-radius:18px; }"
-
-                );
-                rowLayout->addWidget(disconnectBtn, 0, Qt::AlignRight);
-
-                connect(disconnectBtn, &QPushButton::clicked, this, [this, dev]() {
-                    onDisconnectDevice(dev);
-                });
+        const QList<WospBluez::Device> devices = bluez->devices();
+
+        QHash<QString, Row> kept;
+        for (int i = 0; i < devices.size(); ++i) {
+            const WospBluez::Device &dev = devices[i];
+            Row row = rows.take(dev.path);
+            if (!row.frame) row = makeRow(dev.path);
+
+            QString text = dev.name;
+            if (dev.inRange && !dev.connected)
+                text += QString("  (%1 dBm)").arg(dev.rssi);
+            row.deviceButton->setText(text);
+            row.disconnectBtn->setVisible(dev.connected);
+
+            if (deviceLayout->indexOf(row.frame) != i) {
+                deviceLayout->removeWidget(row.frame);
+                deviceLayout->insertWidget(i, row.frame);
             }
+            kept.insert(dev.path, row);
+        }
 
-            connect(deviceButton, &QPushButton::clicked, this, [this, dev]() {
-                onDeviceClicked(dev);
-            });
-
-            deviceLayout->insertWidget(deviceLayout->count() - 1, rowFrame);
+        // Whatever is left has disappeared from BlueZ
+        for (const Row &row : rows) {
+            deviceLayout->removeWidget(row.frame);
+            row.frame->deleteLater();
         }
+        rows = kept;
 
-        if (devices.isEmpty()) {
-            QLabel *emptyLbl = new QLabel(
-                bluetoothPowered
-                    ? "No Bluetooth devices found"
-                    : "Bluetooth is off",
-                deviceContainer
-            );
+        if (devices.isEmpty() && !emptyLbl) {
+            emptyLbl = new QLabel(deviceContainer);
             emptyLbl->setStyleSheet("font-size:26px;"); // color from QLabel rule
             emptyLbl->setAlignment(Qt::AlignCenter);
-            deviceLayout->insertWidget(deviceLayout->count() - 1, emptyLbl);
+            deviceLayout->insertWidget(0, emptyLbl);
+        } else if (!devices.isEmpty() && emptyLbl) {
+            deviceLayout->removeWidget(emptyLbl);
+            emptyLbl->deleteLater();
+            emptyLbl = nullptr;
         }
+        if (emptyLbl)
+            emptyLbl->setText(bluez->state().powered
+                                  ? "No Bluetooth devices found"
+                                  : "Bluetooth is off");
     }
 
-    void updatePowerButton()
+    Row makeRow(const QString &path)
     {
-        if (bluetoothPowered) {
-            powerButton->setText("On");
-            powerButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#7CFC00;"      // bright green
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
-        } else {
-            powerButton->setText("Off");
-            powerButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#CC6666;"      // dim red
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
-        }
+        QFont itemFont;
+        itemFont.setPointSize(itemFont.pointSize() + 4); // roughly 26px equivalent
+
+        Row row;
+        row.frame = new QFrame(deviceContainer);
+        row.frame->setStyleSheet(
+            "QFrame { "
+            "  background-color:#444444; "
+            "  border-radius:20px; "
+            "  border:1px solid #222222; "
+            "}"
+        );
+        QHBoxLayout *rowLayout = new QHBoxLayout(row.frame);
+        rowLayout->setContentsMargins(14, 10, 14, 10);
+        rowLayout->setSpacing(10);
+
+        row.deviceButton = new QPushButton(row.frame);
+        row.deviceButton->setFlat(true);
+        row.deviceButton->setStyleSheet(
+            "QPushButton { "
+            "  background-color:transparent; "
+            "  border:none; "
+            "  text-align:left; "
+            "  color:white; "
+            "  font-size:26px;"
+            "}"
+            "QPushButton:pressed { "
+            "  background-color:rgba(255,255,255,30); "
+            "  border-radius:20px; "
+            "}"
+        );
+        row.deviceButton->setFont(itemFont);
+
+        rowLayout->addWidget(row.deviceButton, 1);
+
+        // 🕱 Remove device button (always shown) – no color set so emoji keeps native colouring
+        QPushButton *removeBtn = new QPushButton(QStringLiteral("🕱"), row.frame);
+        removeBtn->setFixedWidth(48);
+        removeBtn->setStyleSheet(
+            "QPushButton { "
+            "  background-color:transparent; "
+            "  border:none; "
+            "  color:#ff4a6a; "
+            "  font-size:32px; "
+            "}"
+    		"QPushButton:hover { color:#ff1616; background:#ad1236; border-radius:18px; }"
+    		"QPushButton:pressed { color:#ffffff; background:#550000; border-radius:18px; }"
+        );
+        rowLayout->addWidget(removeBtn, 0, Qt::AlignRight);
+
+        // Red X disconnect button (only while connected)
+        row.disconnectBtn = new QPushButton(QStringLiteral("❌"), row.frame);
+        row.disconnectBtn->setFixedWidth(40);
+        row.disconnectBtn->setStyleSheet(
+            "QPushButton { "
+            "  background-color:transparent; "
+            "  border:none; "
+            "  color:#ff4a6a; "
+            "  font-size:32px; "
+            "}"
+    	    "QPushButton:hover { color:#ff1616; background:#ad1236; border-radius:18px; }"
+    	    "QPushButton:pressed { color:#ffffff; background:#550000; border-radius:18px; }"
+        );
+        rowLayout->addWidget(row.disconnectBtn, 0, Qt::AlignRight);
+
+        connect(removeBtn, &QPushButton::clicked, this, [this, path]() {
+            onRemoveDevice(path);
+        });
+        connect(row.disconnectBtn, &QPushButton::clicked, this, [this, path]() {
+            onDisconnectDevice(path);
+        });
+        connect(row.deviceButton, &QPushButton::clicked, this, [this, path]() {
+            onDeviceClicked(path);
+        });
+
+        return row;
     }
 
-    void updateVisibleButton()
+    WospBluez::Device deviceAt(const QString &path) const
     {
-        if (discoverable) {
-            visibleButton->setText("Visible");
-            visibleButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#7CFC00;"
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
-        } else {
-            visibleButton->setText("Visible");
-            visibleButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#CC6666;"
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
-        }
+        for (const WospBluez::Device &d : bluez->devices())
+            if (d.path == path) return d;
+        return {};
     }
 
-    void togglePower()
+    void updatePowerButton(bool on)
     {
-        bluetoothPowered = !bluetoothPowered;
-        setBluetoothPowered(bluetoothPowered);
-        updatePowerButton();
-        refreshDevices();
+        powerButton->setText(on ? "On" : "Off");
+        WospTheme::setShape(powerButton, WospTheme::toggleButton(on ? QColor("#7CFC00")      // bright green
+                                                                    : QColor("#CC6666"))); // dim red
+    }
+
+    void updateVisibleButton(bool on)
+    {
+        visibleButton->setText("Visible");
+        WospTheme::setShape(visibleButton, WospTheme::toggleButton(QColor(on ? "#7CFC00" : "#CC6666")));
     }
 
     void toggleVisible()
     {
-        if (!bluetoothPowered) {
+        if (!bluez->state().powered) {
             QMessageBox::warning(this, "Bluetooth Off",
                                  "Bluetooth is currently turned off.\n"
                                  "Please turn it on before enabling visibility.");
             return;
         }
 
-        if (!discoverable) {
-            // Enable discoverable with 30-second timeout
-            setBluetoothDiscoverable(true, 30);
-            discoverable = true;
-            updateVisibleButton();
-
-            // Try to auto-refresh discoverable state after ~30s
-            QTimer::singleShot(32000, this, [this]() {
-                discoverable = isBluetoothDiscoverable();
-                updateVisibleButton();
-            });
-        } else {
-            // Manually turn off discoverable
-            setBluetoothDiscoverable(false, 0);
-            discoverable = false;
-            updateVisibleButton();
-        }
+        // BlueZ clears Discoverable itself when the timeout runs out
+        bluez->setDiscoverable(!bluez->state().discoverable, VISIBLE_SECONDS);
     }
 
-    void onDeviceClicked(const BluetoothDevice &dev)
+    void onDeviceClicked(const QString &path)
     {
-        if (!bluetoothPowered) {
+        if (!bluez->state().powered) {
             QMessageBox::warning(this, "Bluetooth Off",
                                  "Bluetooth is currently turned off.\n"
                                  "Please turn it on before connecting.");
             return;
         }
 
-        QString script;
-        QString title = "Bluetooth";
+        WospBluez::Device dev = deviceAt(path);
+        QString name = dev.name;
+        auto report = [this, name](const QString &err) {
+            if (err.isEmpty()) return;   // the row shows the new state
+            QMessageBox::warning(this, "Bluetooth",
+                                 QString("Failed to connect to %1.\n\nDetails:\n%2")
+                                     .arg(name, err));
+        };
+
+        // Unpaired devices pair first; PIN and passkey prompts come back
+        // through showPairingPrompt()
+        if (dev.paired)
+            bluez->connectDevice(path, report);
+        else
+            bluez->pairAndConnect(path, report);
+    }
 
-        if (dev.paired) {
-            // Simple connect for already paired device
-            script = QString(
-                "echo -e '"
-                "connect %1\n"
-                "quit\n' | bluetoothctl"
-            ).arg(dev.mac);
-        } else {
-            // Not paired: (optional) PIN dialog, then simple pair + connect
-            bool ok = false;
-            QString pin = QInputDialog::getText(
-                this,
-                "Bluetooth Pairing",
-                QString("Enter PIN / passkey for %1\n(leave blank if not required):").arg(dev.name),
-                QLineEdit::Normal,
-                "",
-                &ok
-            );
-
-            if (!ok)
-                return;
+    static QString passkeyText(const WospBluez::AgentRequest &req)
+    {
+        QString text = QString("Type %1 on %2, then press Enter there.").arg(req.code, req.name);
+        if (req.entered > 0)
+            text += QString("\n\n%1 of %2 digits typed").arg(req.entered).arg(req.code.size());
+        return text;
+    }
 
-            Q_UNUSED(pin); // script is intentionally simple: just pair/connect by MAC
+    // Non-modal, so BlueZ can still cancel it while it is open
+    void showPairingPrompt(const WospBluez::AgentRequest &req, WospBluez::AgentAnswer answer)
+    {
+        using Req = WospBluez::AgentRequest;
 
-            script = QString(
-                "echo -e '"
-                "pair %1\n"
-                "connect %1\n"
-                "quit\n' | bluetoothctl"
-            ).arg(dev.mac);
+        // ShowPasskey repeats per typed digit: update the open box
+        if (req.kind == Req::ShowPasskey && pairingPrompt && promptKind == Req::ShowPasskey
+            && promptPath == req.path) {
+            if (auto *box = qobject_cast<QMessageBox*>(pairingPrompt.data())) {
+                box->setText(passkeyText(req));
+                return;
+            }
         }
 
-        QString out = runCommandBT("bash", {"-c", script});
-
-        // Simple error detection – if bluetoothctl reports "Failed" or "Error", show it
-        if (out.contains("Failed", Qt::CaseInsensitive) ||
-            out.contains("Error", Qt::CaseInsensitive)) {
-            QMessageBox::warning(
-                this,
-                title,
-                QString("Failed to connect to %1.\n\nDetails:\n%2")
-                    .arg(dev.name, out.trimmed())
-            );
+        if (pairingPrompt) pairingPrompt->close();
+        if (req.kind == Req::Cancel) return;
+        promptKind = req.kind;
+        promptPath = req.path;
+
+        if (req.kind == Req::PinCode || req.kind == Req::Passkey) {
+            QInputDialog *dlg = new QInputDialog(this);
+            dlg->setWindowTitle("Bluetooth Pairing");
+            dlg->setLabelText(QString(req.kind == Req::PinCode
+                                          ? "Enter the PIN for %1:"
+                                          : "Enter the 6-digit passkey shown on %1:").arg(req.name));
+            dlg->setInputMode(QInputDialog::TextInput);
+            connect(dlg, &QDialog::finished, this, [dlg, answer](int result) {
+                answer(result == QDialog::Accepted, dlg->textValue());
+            });
+            pairingPrompt = dlg;
         } else {
-            QMessageBox::information(
-                this,
-                title,
-                QString("Pairing / connecting to %1...\n\nbluetoothctl output:\n%2")
-                    .arg(dev.name, out.trimmed())
-            );
+            QMessageBox *box = new QMessageBox(this);
+            box->setWindowTitle("Bluetooth Pairing");
+            if (req.kind == Req::Confirm) {
+                box->setText(QString("Does %1 show the passkey %2?").arg(req.name, req.code));
+                box->setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+            } else if (req.kind == Req::Authorize) {
+                box->setText(QString("Allow %1 to pair?").arg(req.name));
+                box->setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+            } else if (req.kind == Req::ShowPasskey) {
+                box->setText(passkeyText(req));
+                box->setStandardButtons(QMessageBox::Ok);
+            } else {
+                box->setText(QString("Type %1 on %2, then press Enter there.").arg(req.code, req.name));
+                box->setStandardButtons(QMessageBox::Ok);
+            }
+            connect(box, &QDialog::finished, this, [box, answer](int) {
+                answer(box->clickedButton() == box->button(QMessageBox::Yes), QString());
+            });
+            pairingPrompt = box;
         }
-
-        // Give BlueZ a moment to settle state before re-reading "info"
-        QTimer::singleShot(1500, this, [this]() {
-            refreshDevices();
-        });
+        pairingPrompt->setAttribute(Qt::WA_DeleteOnClose);
+        pairingPrompt->open();
     }
 
-    void onDisconnectDevice(const BluetoothDevice &dev)
+    void onDisconnectDevice(const QString &path)
     {
-        runCommandBT("bash", {"-c",
-                              QString("echo -e 'disconnect %1\nquit' | bluetoothctl").arg(dev.mac)});
-        QMessageBox::information(this, "Bluetooth",
-                                 QString("Disconnecting from %1...").arg(dev.name));
-        refreshDevices();
+        QString name = deviceAt(path).name;
+        bluez->disconnectDevice(path, [this, name](const QString &err) {
+            if (!err.isEmpty())
+                QMessageBox::warning(this, "Bluetooth",
+                                     QString("Failed to disconnect %1.\n\n%2").arg(name, err));
+        });
     }
 
-    void onRemoveDevice(const BluetoothDevice &dev)
+    void onRemoveDevice(const QString &path)
     {
-        runCommandBT("bash", {"-c",
-                              QString("echo -e 'remove %1\nquit' | bluetoothctl").arg(dev.mac)});
-        QMessageBox::information(this, "Bluetooth",
-                                 QString("Removing %1 from known devices...").arg(dev.name));
-        refreshDevices();
+        QString name = deviceAt(path).name;
+        bluez->removeDevice(path, [this, name](const QString &err) {
+            if (!err.isEmpty())
+                QMessageBox::warning(this, "Bluetooth",
+                                     QString("Failed to remove %1.\n\n%2").arg(name, err));
+        });
     }
 };
 
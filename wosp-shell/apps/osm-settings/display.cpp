@@ -17,31 +17,17 @@
 #include <QGuiApplication>
 #include <QSizePolicy>
 
+#include "../../lib/wosp-config.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Alternix compact button style (same as Security/Storage)
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
@@ -64,44 +50,13 @@ static QString altBtnBright()
 }
 
 // -----------------------------------------------------
-// Simple CONFIG helpers (same file as Security)
+// Simple CONFIG helpers (same store as Security)
 // -----------------------------------------------------
 static QString cfgFile()
 {
     return QDir::homePath() + "/.config/Alternix/osm-settings.conf";
 }
 
-static QMap<QString,QString> loadCfg()
-{
-    QMap<QString,QString> map;
-    QFile f(cfgFile());
-    if (!f.exists()) return map;
-
-    if (f.open(QFile::ReadOnly))
-    {
-        QTextStream s(&f);
-        while (!s.atEnd())
-        {
-            QString line = s.readLine().trimmed();
-            if (line.startsWith("#") || !line.contains("="))
-                continue;
-            QStringList parts = line.split("=");
-            if (parts.size() == 2)
-                map[parts[0].trimmed()] = parts[1].trimmed();
-        }
-    }
-    return map;
-}
-
-static void saveCfg(const QMap<QString,QString> &map)
-{
-    QFile f(cfgFile());
-    f.open(QFile::WriteOnly | QFile::Truncate);
-    QTextStream s(&f);
-    for (auto it = map.begin(); it != map.end(); ++it)
-        s << it.key() << "=" << it.value() << "\n";
-}
-
 // -----------------------------------------------------
 // Simple ON/OFF pill toggle (same as Security BoolPillToggle)
 // -----------------------------------------------------
@@ -256,7 +211,7 @@ public:
     {
         setStyleSheet("background:#282828; color:white; font-family:Sans;");
 
-        cfg = loadCfg();
+        cfg = WospConfig::Store::open(cfgFile());
 
         QVBoxLayout *root = new QVBoxLayout(this);
         root->setContentsMargins(40, 40, 40, 40);
@@ -322,7 +277,7 @@ public:
 
 private:
     QStackedWidget *m_stack = nullptr;
-    QMap<QString,QString> cfg;
+    WospConfig::Store *cfg = nullptr;
 
     BoolPillToggle *m_nightlightPill = nullptr;
     BoolPillToggle *m_adaptivePill   = nullptr;
@@ -333,7 +288,7 @@ private:
     // ------------- config helpers (local) -------------
     QString readCfg(const QString &k, const QString &def = QString()) const
     {
-        return cfg.contains(k) ? cfg.value(k) : def;
+        return cfg->value(k, def);
     }
 
     bool readCfgBool(const QString &k, bool def = false) const
@@ -344,8 +299,7 @@ private:
 
     void writeCfg(const QString &k, const QString &v)
     {
-        cfg[k] = v;
-        saveCfg(cfg);
+        cfg->setValue(k, v);   // written behind, see wosp-config.h
     }
 
     // ------------- rows -------------------------------
@@ -432,7 +386,7 @@ private:
         lay->addWidget(m_wallpaperBtn);
 
         connect(m_wallpaperBtn, &QPushButton::clicked, this, []() {
-            QProcess::startDetached("osm-paper", QStringList());
+            QProcess::startDetached("osm-launch", {"osm-paper"});
         });
 
         return card;
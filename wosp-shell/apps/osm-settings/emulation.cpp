@@ -12,30 +12,16 @@
 #include <QTextStream>
 #include <QMessageBox>
 
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Alternix compact button style (same as Storage page)
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
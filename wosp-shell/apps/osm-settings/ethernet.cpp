@@ -10,6 +10,8 @@
 #include <QScroller>
 #include <QStringList>
 
+#include "../../lib/wosp-theme.h"
+
 // ---------------------------------------------------------
 // Helpers (Ethernet)
 // ---------------------------------------------------------
@@ -29,19 +31,8 @@ static QPushButton* smallBtnEth(const QString &txt)
 {
     QPushButton *b = new QPushButton(txt);
     b->setFixedSize(180, 60);
-    b->setStyleSheet(
-        "QPushButton {"
-        " background:#444444;"
-        " color:white;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:26px;"
-        " font-weight:bold;"
-        " padding:10px 24px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    );
+    WospTheme::setShape(b, WospTheme::toggleButton(Qt::white));
+    b->setFont(WospTheme::font(26, true));
     return b;
 }
 
@@ -201,20 +192,10 @@ private:
     {
         if (ethernetPowered) {
             powerButton->setText("On");
-            powerButton->setStyleSheet(
-                "QPushButton { background:#444444; color:#7CFC00; border-radius:16px;"
-                " border:1px solid #222; font-size:26px; font-weight:bold; padding:10px 24px; }"
-                "QPushButton:hover{ background:#555; }"
-                "QPushButton:pressed{ background:#333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#7CFC00")));
         } else {
             powerButton->setText("Off");
-            powerButton->setStyleSheet(
-                "QPushButton { background:#444444; color:#CC6666; border-radius:16px;"
-                " border:1px solid #222; font-size:26px; font-weight:bold; padding:10px 24px; }"
-                "QPushButton:hover{ background:#555; }"
-                "QPushButton:pressed{ background:#333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#CC6666")));
         }
     }
 
@@ -12,9 +12,12 @@
 #include <QApplication>
 #include <QTimer>
 #include <QRegularExpression>
-#include <QSettings>
 #include <QDir>
 
+#include "../../lib/wosp-config.h"
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // ---------------------------------------------------------
 // Helpers (button + command runner)
 // ---------------------------------------------------------
@@ -22,19 +25,8 @@
 static QPushButton* smallBtnBT(const QString &txt) {
     QPushButton *b = new QPushButton(txt);
     b->setFixedSize(180, 60);
-    b->setStyleSheet(
-        "QPushButton {"
-        " background:#444444;"
-        " color:white;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:26px;"
-        " font-weight:bold;"
-        " padding:10px 24px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    );
+    WospTheme::setShape(b, WospTheme::toggleButton(Qt::white));
+    b->setFont(WospTheme::font(26, true));
     return b;
 }
 
@@ -412,10 +404,8 @@ public:
         });
 
         // Timer: 2 second refresh while on and page visible
-        refreshTimer = new QTimer(this);
-        refreshTimer->setInterval(2000);
-        connect(refreshTimer, &QTimer::timeout,
-                this, &LocationPage::refreshDataOnce);
+        refreshTimer = new WospTimers::Periodic("settings-location", 2000, this,
+                                                [this]{ refreshDataOnce(); });
 
         if (stackedWidget) {
             connect(stackedWidget, &QStackedWidget::currentChanged,
@@ -425,9 +415,9 @@ public:
         // -------------------------------------------------
         // Load persisted state
         // -------------------------------------------------
-        QSettings settings(QDir::homePath() + "/.config/Alternix/osm-settings.conf",
-                           QSettings::IniFormat);
-        locationEnabled = settings.value("Location/enabled", true).toBool();
+        WospConfig::Store *settings =
+            WospConfig::Store::open(QDir::homePath() + "/.config/Alternix/osm-settings.conf");
+        locationEnabled = settings->boolValue("Location/enabled", true);
         updatePowerButton();
 
         if (locationEnabled) {
@@ -451,7 +441,7 @@ private:
     QPushButton *powerButton = nullptr;
     QPushButton *refreshButton = nullptr;
 
-    QTimer *refreshTimer = nullptr;
+    WospTimers::Periodic *refreshTimer = nullptr;
     bool locationEnabled = true;
 
     // -------------------------------------------------
@@ -461,34 +451,10 @@ private:
     {
         if (locationEnabled) {
             powerButton->setText("On");
-            powerButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#7CFC00;"      // bright green
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#7CFC00")));
         } else {
             powerButton->setText("Off");
-            powerButton->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#CC6666;"      // dim red
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#CC6666")));
         }
     }
 
@@ -497,10 +463,8 @@ private:
         locationEnabled = !locationEnabled;
 
         // Save state
-        QSettings settings(QDir::homePath() + "/.config/Alternix/osm-settings.conf",
-                           QSettings::IniFormat);
-        settings.setValue("Location/enabled", locationEnabled);
-        settings.sync();
+        WospConfig::Store::open(QDir::homePath() + "/.config/Alternix/osm-settings.conf")
+            ->setBool("Location/enabled", locationEnabled);
 
         updatePowerButton();
 
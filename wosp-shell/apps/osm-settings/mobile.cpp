@@ -13,6 +13,9 @@
 #include <QTimer>
 #include <QApplication>
 
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // ---------------------------------------------------------
 // Helpers (same as Bluetooth)
 // ---------------------------------------------------------
@@ -20,19 +23,8 @@
 static QPushButton* smallBtnBT(const QString &txt) {
     QPushButton *b = new QPushButton(txt);
     b->setFixedSize(180, 60);
-    b->setStyleSheet(
-        "QPushButton {"
-        " background:#444444;"
-        " color:white;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:26px;"
-        " font-weight:bold;"
-        " padding:10px 24px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    );
+    WospTheme::setShape(b, WospTheme::toggleButton(Qt::white));
+    b->setFont(WospTheme::font(26, true));
     return b;
 }
 
@@ -262,10 +254,16 @@ public:
         // -------------------------------------------------
         // INITIAL STATE + AUTO REFRESH
         // -------------------------------------------------
-        refreshTimer = new QTimer(this);
-        refreshTimer->setInterval(2000);
-        connect(refreshTimer, &QTimer::timeout, this, &MobilePage::refreshInfo);
-        refreshTimer->start();
+        refreshTimer = new WospTimers::Periodic("settings-mobile", 2000, this,
+                                                [this]{ refreshInfo(); });
+
+        // Poll the modem only while this page is on screen
+        connect(stackedWidget, &QStackedWidget::currentChanged, this, [this](int idx) {
+            if (stackedWidget->widget(idx) == this) refreshTimer->start();
+            else refreshTimer->stop();
+        });
+        if (stackedWidget->currentWidget() == this)
+            refreshTimer->start();
 
         refreshInfo();
     }
@@ -282,7 +280,7 @@ private:
     QPushButton *powerButton = nullptr;
     QPushButton *refreshButton = nullptr;
 
-    QTimer *refreshTimer = nullptr;
+    WospTimers::Periodic *refreshTimer = nullptr;
 
     bool mobilePowered = false;
 
@@ -293,20 +291,10 @@ private:
     {
         if (mobilePowered) {
             powerButton->setText("On");
-            powerButton->setStyleSheet(
-                "QPushButton { background:#444444; color:#7CFC00; border:1px solid #222222; "
-                "border-radius:16px; font-size:26px; font-weight:bold; padding:10px 24px; }"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#7CFC00")));
         } else {
             powerButton->setText("Off");
-            powerButton->setStyleSheet(
-                "QPushButton { background:#444444; color:#CC6666; border:1px solid #222222; "
-                "border-radius:16px; font-size:26px; font-weight:bold; padding:10px 24px; }"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
+            WospTheme::setShape(powerButton, WospTheme::toggleButton(QColor("#CC6666")));
         }
     }
 
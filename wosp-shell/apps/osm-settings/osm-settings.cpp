@@ -19,6 +19,10 @@
 #include <QScroller>
 #include <functional>
 
+#include "../../lib/wosp-settings-pages.h"
+#include "../../lib/wosp-state.h"
+#include "../../lib/wosp-theme.h"
+
 static const int CARD_PADDING = 22;
 static const int ICON_COLUMN_WIDTH = 54;
 static const int ICON_TEXT_SPACING = 18;
@@ -36,12 +40,9 @@ public:
         setWidgetResizable(true);
         setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
         setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-        setStyleSheet(
-            "QScrollArea { background:#282828;  font-family:Sans; border:none; }"
-            "QWidget { background:#282828; font-family:Sans; }"
-            "QLabel { color:white; font-family:Sans;}"
-            "QMessageBox QLabel { color:white; font-family:Sans; }"
-        );
+        // Background comes from the window; cards set their own label colours
+        setFrameShape(QFrame::NoFrame);
+        setFont(QFont("Sans"));
 
         QScroller::grabGesture(this, QScroller::LeftMouseButtonGesture);
     }
@@ -95,7 +96,13 @@ QString getSSID() {
     return ssid.isEmpty() ? "N/C" : ssid;
 }
 
-QString getEthernetStatus() {
+QString getEthernetStatus(const WospState::Client *state) {
+    if (state && state->available()) {
+        WospState::Snapshot st = state->state();
+        if (!st.ethIface[0]) return "Unknown";
+        return st.ethUp ? "Connected" : "N/C";
+    }
+
     QDir netDir("/sys/class/net");
     QStringList ifs = netDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
 
@@ -133,7 +140,9 @@ public:
         setWindowTitle("Settings");
 
         QApplication::setFont(QFont("Noto Color Emoji"));
-        setStyleSheet("background:#282828;");
+        // Pages bring their own stylesheet; the menu needs none, so its
+        // cards and labels skip QStyleSheetStyle altogether
+        WospTheme::setBackground(this, QColor("#282828"));
 
         stack = new QStackedWidget(this);
         setCentralWidget(stack);
@@ -149,33 +158,35 @@ protected:
         QMainWindow::keyPressEvent(e);
     }
 
+public:
+    void openModule(const QString &module) {
+        QWidget *p = loadPage(module, WospSettingsPages::titleFor(module));
+
+        if (stack->count() > 1)
+            stack->removeWidget(stack->widget(1));
+
+        stack->addWidget(p);
+        stack->setCurrentIndex(1);
+    }
+
 private:
     QStackedWidget *stack;
+    WospState::Client *sysState = nullptr;
 
     // ------------------------------------------------------
     QWidget *makeMainMenu() {
         QString ssid = getSSID();
-        QString eth  = getEthernetStatus();
-
-        struct Row { QString icon, title, sub, module; };
-
-        QList<Row> list = {
-            {"🛜", "Wireless", ssid, "wifi"},
-            {"🔃", "Bluetooth", "Bluetooth Settings", "bluetooth"},
-            {"📶", "Mobile Network", "Cellular, APN, Roaming", "mobile"},
-            {"🔗", "Ethernet", eth, "ethernet"},
-            {"📍", "Location", "GPS, Geolocation Services", "location"},
-            {"🖥️", "Display", "Brightness, Rotation", "display"},
-            {"🔊", "Sounds", "Output, Volume Levels", "sound"},
-            {"🔋", "Battery", "Battery Level & Charging", "battery"},
-            {"💾", "Storage", "Space, Usage & Cleanup", "storage"},
-            {"📦", "Installed Applications", "apt, flatpak, snap", "apps"},
-            {"🎮", "Emulation", "Android & Windows", "emulation"},
-            {"🔐", "Security", "Lockscreen, Passwords, Firewall", "security"},
-            {"👤", "Account Info", "User Account Stats", "accounts"},
-            {"💽", "Kernel", "System Drivers & Kernel", "kernel"},
-            {"⚙️", "System", "Device, OS, Hardware", "system"}
-        };
+
+        // Ethernet follows wosp-stated live when it is running
+        sysState = new WospState::Client(this);
+        QString eth  = getEthernetStatus(sysState);
+        QLabel *ethSub = nullptr;
+
+        QList<WospSettingsPages::Page> list = WospSettingsPages::all();
+        for (auto &r : list) {
+            if (r.module == "wifi") r.sub = ssid;
+            else if (r.module == "ethernet") r.sub = eth;
+        }
 
         TouchScrollArea *scroll = new TouchScrollArea;
 
@@ -186,33 +197,32 @@ private:
         col->setAlignment(Qt::AlignTop | Qt::AlignHCenter);
 
         for (auto &r : list) {
-            ClickableCard *card = makeCard(r.icon, r.title, r.sub);
+            QLabel *sub = nullptr;
+            ClickableCard *card = makeCard(r.icon, r.title, r.sub, &sub);
+            if (r.module == "ethernet") ethSub = sub;
 
             card->setMinimumWidth(CARD_WIDTH);
             card->setMaximumWidth(CARD_WIDTH);
 
-            card->onClick = [this, r]() {
-                QWidget *p = loadPage(r.module, r.title);
-
-                if (stack->count() > 1)
-                    stack->removeWidget(stack->widget(1));
-
-                stack->addWidget(p);
-                stack->setCurrentIndex(1);
-            };
+            card->onClick = [this, r]() { openModule(r.module); };
 
             col->addWidget(card, 0, Qt::AlignHCenter);
         }
 
         col->addStretch();
         scroll->setWidget(inner);
+
+        sysState->onChanged = [this, ethSub](const WospState::Snapshot &) {
+            if (ethSub) ethSub->setText(getEthernetStatus(sysState));
+        };
         return scroll;
     }
 
     // ------------------------------------------------------
     ClickableCard *makeCard(const QString &icon,
                             const QString &title,
-                            const QString &sub)
+                            const QString &sub,
+                            QLabel **subOut = nullptr)
     {
         ClickableCard *card = new ClickableCard;
         card->setFixedHeight(130);
@@ -230,7 +240,7 @@ private:
         iconCol->setAlignment(Qt::AlignCenter);
 
         QLabel *ico = new QLabel(icon);
-        ico->setStyleSheet("font-size:48px; color:white;");
+        WospTheme::setText(ico, Qt::white, 48);
         ico->setAlignment(Qt::AlignCenter);
         iconCol->addWidget(ico);
 
@@ -242,27 +252,28 @@ private:
         textCol->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
 
         QLabel *ttl = new QLabel(title);
-        ttl->setStyleSheet("font-size:30px; font-weight:bold; color:white;");
+        WospTheme::setText(ttl, Qt::white, 30, true);
 
         QLabel *subt = new QLabel(sub);
-        subt->setStyleSheet("font-size:22px; color:#bbbbbb;");
+        WospTheme::setText(subt, QColor("#bbbbbb"), 22);
 
         textCol->addWidget(ttl);
         textCol->addWidget(subt);
+        if (subOut) *subOut = subt;
 
         row->addWidget(iconWrapper);
         row->addWidget(textWrapper, 1);
 
         // Card style
-        card->setStyleSheet(
-            "ClickableCard {"
-            " background:#303030;"
-            " border:3px dashed #777;"
-            " border-radius:12px;"
-            "}"
-            "ClickableCard:hover { background:#3b3b3b; }"
-            "ClickableCard:pressed { background:#505050; }"
-        );
+        WospTheme::Shape shape;
+        shape.background = QColor("#303030");
+        shape.hover = QColor("#3b3b3b");
+        shape.pressed = QColor("#505050");
+        shape.border = QColor("#777777");
+        shape.borderWidth = 3;
+        shape.borderStyle = Qt::DashLine;
+        shape.radius = 12;
+        WospTheme::setShape(card, shape);
 
         return card;
     }
@@ -346,9 +357,15 @@ private:
 // ------------------------------------------------------
 int main(int argc, char *argv[]) {
     QApplication a(argc, argv);
+    // Before any widget exists, so nothing is polished twice
+    WospTheme::install();
 
     SettingsHub w;
     w.show();
 
+    // `osm-settings wifi` opens straight into a module (used by intent search)
+    if (a.arguments().size() > 1)
+        w.openModule(a.arguments().at(1));
+
     return a.exec();
 }
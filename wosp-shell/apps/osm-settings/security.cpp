@@ -19,30 +19,18 @@
 #include <QHideEvent>
 #include <QTextCursor>
 
+#include "../../lib/wosp-config.h"
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Alternix compact button style (same as Emulation/Storage)
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
@@ -80,37 +68,6 @@ static QString cfgFile()
     return QDir::homePath() + "/.config/Alternix/osm-settings.conf";
 }
 
-static QMap<QString,QString> loadCfg()
-{
-    QMap<QString,QString> map;
-    QFile f(cfgFile());
-    if (!f.exists()) return map;
-
-    if (f.open(QFile::ReadOnly))
-    {
-        QTextStream s(&f);
-        while (!s.atEnd())
-        {
-            QString line = s.readLine().trimmed();
-            if (line.startsWith("#") || !line.contains("="))
-                continue;
-            QStringList parts = line.split("=");
-            if (parts.size() == 2)
-                map[parts[0].trimmed()] = parts[1].trimmed();
-        }
-    }
-    return map;
-}
-
-static void saveCfg(const QMap<QString,QString> &map)
-{
-    QFile f(cfgFile());
-    f.open(QFile::WriteOnly | QFile::Truncate);
-    QTextStream s(&f);
-    for (auto it = map.begin(); it != map.end(); ++it)
-        s << it.key() << "=" << it.value() << "\n";
-}
-
 // -----------------------------------------------------
 // Simple ON/OFF pill toggle for SSH / USB
 // -----------------------------------------------------
@@ -287,9 +244,9 @@ private:
     QTextEdit *m_liveConnEdit = nullptr;
     QTextEdit *m_ufwLogEdit   = nullptr;
 
-    QTimer *m_logTimer = nullptr;
+    WospTimers::Periodic *m_logTimer = nullptr;
 
-    QMap<QString,QString> cfg;
+    WospConfig::Store *cfg = nullptr;
 
     // config helpers
     void writeCfgKey(const QString &k, const QString &v);
@@ -320,7 +277,7 @@ SecurityPage::SecurityPage(QStackedWidget *stack)
     : QWidget(stack), m_stack(stack)
 {
     setStyleSheet("background:#282828; color:white; font-family:Sans;");
-    cfg = loadCfg();
+    cfg = WospConfig::Store::open(cfgFile());
 
     QVBoxLayout *root = new QVBoxLayout(this);
     root->setContentsMargins(40, 40, 40, 40);
@@ -420,9 +377,9 @@ SecurityPage::SecurityPage(QStackedWidget *stack)
     });
 
     // Auto-refresh logs
-    m_logTimer = new QTimer(this);
-    m_logTimer->setInterval(3000);
-    connect(m_logTimer, &QTimer::timeout, this, [this]() { refreshLogs(); });
+    // 4 s rather than 3 s: lands on the same grid as the other pages
+    m_logTimer = new WospTimers::Periodic("settings-security", 4000, this,
+                                          [this]() { refreshLogs(); });
 }
 
 // -----------------------------------------------------
@@ -449,7 +406,7 @@ void SecurityPage::hideEvent(QHideEvent *e)
 // -----------------------------------------------------
 QString SecurityPage::readCfg(const QString &k, const QString &def) const
 {
-    return cfg.contains(k) ? cfg.value(k) : def;
+    return cfg->value(k, def);
 }
 
 bool SecurityPage::readCfgBool(const QString &k, bool def) const
@@ -460,8 +417,7 @@ bool SecurityPage::readCfgBool(const QString &k, bool def) const
 
 void SecurityPage::writeCfgKey(const QString &k, const QString &v)
 {
-    cfg[k] = v;
-    saveCfg(cfg);
+    cfg->setValue(k, v);
 }
 
 // -----------------------------------------------------
@@ -9,9 +9,10 @@
 #include <QScrollArea>
 #include <QScroller>
 #include <QProcess>
-#include <QSettings>
 #include <QDir>
 
+#include "../../lib/wosp-config.h"
+
 // ---------------------------------------------------------
 // PulseAudio Helpers (only for Main Volume now)
 // ---------------------------------------------------------
@@ -111,9 +112,9 @@ public:
     {
         setStyleSheet("background:#282828;");
 
-        // QSettings using explicit path: ~/.config/Alternix/osm-settings.conf
+        // Shared write-behind store for ~/.config/Alternix/osm-settings.conf
         QString confPath = QDir::homePath() + "/.config/Alternix/osm-settings.conf";
-        settings = new QSettings(confPath, QSettings::IniFormat, this);
+        settings = WospConfig::Store::open(confPath);
 
         QVBoxLayout *outer = new QVBoxLayout(this);
         outer->setContentsMargins(40, 40, 40, 40);
@@ -157,12 +158,12 @@ public:
         // ----------------------------------------------------
         // Restore slider positions from config
         // ----------------------------------------------------
-        int mainVal   = settings->value("Sound/MainVolume",        50).toInt();
-        int notifVal  = settings->value("Sound/Notifications",     50).toInt();
-        int mediaVal  = settings->value("Sound/Media",             50).toInt();
-        int callVal   = settings->value("Sound/InCall",            50).toInt();
-        int alarmVal  = settings->value("Sound/Alarms",            50).toInt();
-        int vibVal    = settings->value("Sound/VibrationStrength", 50).toInt();
+        int mainVal   = settings->intValue("Sound/MainVolume",        50);
+        int notifVal  = settings->intValue("Sound/Notifications",     50);
+        int mediaVal  = settings->intValue("Sound/Media",             50);
+        int callVal   = settings->intValue("Sound/InCall",            50);
+        int alarmVal  = settings->intValue("Sound/Alarms",            50);
+        int vibVal    = settings->intValue("Sound/VibrationStrength", 50);
 
         mainSlider->setValue(mainVal);
         notifSlider->setValue(notifVal);
@@ -177,28 +178,28 @@ public:
         // Main Volume: controls real PulseAudio volume + saves setting
         connect(mainSlider, &QSlider::valueChanged, this, [=](int v) {
             setDefaultSinkVolumePercent(v);
-            settings->setValue("Sound/MainVolume", v);
+            settings->setInt("Sound/MainVolume", v);
         });
 
         // Others: only remember positions (no audio behavior)
         connect(notifSlider, &QSlider::valueChanged, this, [=](int v) {
-            settings->setValue("Sound/Notifications", v);
+            settings->setInt("Sound/Notifications", v);
         });
 
         connect(mediaSlider, &QSlider::valueChanged, this, [=](int v) {
-            settings->setValue("Sound/Media", v);
+            settings->setInt("Sound/Media", v);
         });
 
         connect(callSlider, &QSlider::valueChanged, this, [=](int v) {
-            settings->setValue("Sound/InCall", v);
+            settings->setInt("Sound/InCall", v);
         });
 
         connect(alarmSlider, &QSlider::valueChanged, this, [=](int v) {
-            settings->setValue("Sound/Alarms", v);
+            settings->setInt("Sound/Alarms", v);
         });
 
         connect(vibSlider, &QSlider::valueChanged, this, [=](int v) {
-            settings->setValue("Sound/VibrationStrength", v);
+            settings->setInt("Sound/VibrationStrength", v);
             // Hook up your vibration script here later if you like.
         });
 
@@ -225,7 +226,7 @@ public:
 
 private:
     QStackedWidget *stackedWidget = nullptr;
-    QSettings *settings = nullptr;
+    WospConfig::Store *settings = nullptr;
 };
 
 // ---------------------------------------------------------
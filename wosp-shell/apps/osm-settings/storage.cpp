@@ -23,6 +23,9 @@
 #include <dirent.h>
 #include <unistd.h>
 
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Helpers
 // -----------------------------------------------------
@@ -120,27 +123,16 @@ static QString baseDeviceName(const QString &devPath)
 // -----------------------------------------------------
 // Styles
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
+static WospTheme::Shape btnShape(const QString &txtColor)
 {
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:14px;"
-        " font-size:20px;"
-        " font-weight:bold;"
-        " padding:4px 10px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
+    return WospTheme::darkButton(QColor(txtColor), 14, QMargins(10, 4, 10, 4));
 }
 
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, btnShape(color));
+    b->setFont(WospTheme::font(20, true));
     b->setMinimumSize(110, 48);
     b->setMaximumWidth(150);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
@@ -260,7 +252,7 @@ public:
         QPushButton *openInt = makeBtn("Open");
         intLay->addWidget(openInt, 0, Qt::AlignCenter);
         connect(openInt, &QPushButton::clicked, this, []() {
-            QProcess::startDetached("osm-files", {"/"});
+            QProcess::startDetached("osm-launch", {"osm-files", "/"});
         });
 
         outerLay->addWidget(intCard);
@@ -286,9 +278,8 @@ public:
         });
         root->addWidget(back, 0, Qt::AlignCenter);
 
-        m_timer = new QTimer(this);
-        m_timer->setInterval(4000);
-        connect(m_timer, &QTimer::timeout, this, &StoragePage::refreshAll);
+        m_timer = new WospTimers::Periodic("settings-storage", 4000, this,
+                                           [this]{ refreshAll(); });
 
         if (m_stack) {
             connect(m_stack, &QStackedWidget::currentChanged, this, [this](int idx){
@@ -328,7 +319,7 @@ private:
     QVBoxLayout *m_devicesLayout = nullptr;
     QVector<DeviceCard*> m_deviceCards;
 
-    QTimer *m_timer = nullptr;
+    WospTimers::Periodic *m_timer = nullptr;
 
     QString m_rootDev;
     QString m_rootBase;
@@ -500,7 +491,7 @@ private:
             qulonglong size = partBytes(pc->dev);
             pc->info->setText(QString("Size: %1\nNot mounted").arg(humanSize(size)));
             pc->btnMount->setText("Mount");
-            pc->btnMount->setStyleSheet(altBtnStyle("white"));
+            WospTheme::setShape(pc->btnMount, btnShape("white"));
             pc->btnOpen->hide();
         } else {
             qulonglong t=0, f=0;
@@ -512,7 +503,7 @@ private:
                 .arg(humanSize(t))
             );
             pc->btnMount->setText("Unmount");
-            pc->btnMount->setStyleSheet(altBtnStyle("#CC6666"));
+            WospTheme::setShape(pc->btnMount, btnShape("#CC6666"));
             pc->btnOpen->show();
         }
     }
@@ -615,7 +606,7 @@ private:
                 if (pc->btnOpen) {
                     connect(pc->btnOpen, &QPushButton::clicked, this, [pc]() {
                         if (!pc->mountPoint.isEmpty())
-                            QProcess::startDetached("osm-files", {pc->mountPoint});
+                            QProcess::startDetached("osm-launch", {"osm-files", pc->mountPoint});
                     });
                 }
             }
@@ -750,7 +741,7 @@ private:
                 if (pc->btnOpen) {
                     connect(pc->btnOpen, &QPushButton::clicked, this, [pc]() {
                         if (!pc->mountPoint.isEmpty())
-                            QProcess::startDetached("osm-files", {pc->mountPoint});
+                            QProcess::startDetached("osm-launch", {"osm-files", pc->mountPoint});
                     });
                 }
 
@@ -19,6 +19,9 @@
 #include <QTimer>
 #include <QMap>
 
+#include "../../lib/wosp-timers.h"
+#include "../../lib/wosp-theme.h"
+
 // -----------------------------------------------------
 // Shell helper
 // -----------------------------------------------------
@@ -33,27 +36,11 @@ static QString runCmd(const QString &cmd)
 // -----------------------------------------------------
 // Alternix compact button style (same as Display/Security)
 // -----------------------------------------------------
-static QString altBtnStyle(const QString &txtColor)
-{
-    return QString(
-        "QPushButton {"
-        " background:#444444;"
-        " color:%1;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:22px;"
-        " font-weight:bold;"
-        " padding:6px 16px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    ).arg(txtColor);
-}
-
 static QPushButton* makeBtn(const QString &txt, const QString &color = "white")
 {
     QPushButton *b = new QPushButton(txt);
-    b->setStyleSheet(altBtnStyle(color));
+    WospTheme::setShape(b, WospTheme::darkButton(QColor(color)));
+    b->setFont(WospTheme::font(22, true));
     b->setMinimumSize(140, 54);
     b->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     return b;
@@ -401,10 +388,7 @@ extern "C" QWidget* make_page(QStackedWidget *stack)
     // -------------------------------------------------
     // Refresh timer (2s) – only when page visible
     // -------------------------------------------------
-    QTimer *refresh = new QTimer(root);
-    refresh->setInterval(2000);
-
-    QObject::connect(refresh, &QTimer::timeout, [=]() {
+    auto *refresh = new WospTimers::Periodic("settings-system", 2000, root, [=]() {
         if (liveValues.contains("kernel"))
             liveValues["kernel"]->setText(getKernel());
 
@@ -5,10 +5,6 @@
 #include <QHBoxLayout>
 #include <QStackedWidget>
 #include <QFrame>
-#include <QDir>
-#include <QFile>
-#include <QTextStream>
-#include <QProcess>
 #include <QStringList>
 #include <QFont>
 #include <QListWidget>
@@ -16,6 +12,9 @@
 #include <QMessageBox>
 #include <functional>
 
+#include "../../lib/wosp-nm.h"
+#include "../../lib/wosp-theme.h"
+
 // =========================================================
 // HELPERS
 // =========================================================
@@ -23,69 +22,20 @@
 static QPushButton* smallBtn(const QString &txt) {
     QPushButton *b = new QPushButton(txt);
     b->setFixedSize(180, 60);
-    b->setStyleSheet(
-        "QPushButton {"
-        " background:#444444;"
-        " color:white;"
-        " border:1px solid #222222;"
-        " border-radius:16px;"
-        " font-size:26px;"
-        " font-weight:bold;"
-        " padding:10px 24px;"
-        "}"
-        "QPushButton:hover { background:#555555; }"
-        "QPushButton:pressed { background:#333333; }"
-    );
+    WospTheme::setShape(b, WospTheme::toggleButton(Qt::white));
+    b->setFont(WospTheme::font(26, true));
     return b;
 }
 
-static QString runCmd(const QString &cmd) {
-    QProcess p;
-    p.start("bash", {"-c", cmd});
-    p.waitForFinished(1500);
-    return QString::fromUtf8(p.readAllStandardOutput()).trimmed();
-}
-
-static QString cidrToMask(const QString &cidrStr) {
-    bool ok;
-    int bits = cidrStr.toInt(&ok);
-    if (!ok || bits < 0 || bits > 32) return "-";
-    quint32 mask = bits == 0 ? 0 : 0xFFFFFFFF << (32 - bits);
+static QString cidrToMask(int bits) {
+    if (bits <= 0 || bits > 32) return "-";
+    quint32 mask = 0xFFFFFFFF << (32 - bits);
     QStringList octets;
     for (int i = 3; i >= 0; --i)
         octets << QString::number((mask >> (i * 8)) & 0xFF);
     return octets.join(".");
 }
 
-static QString getWifiIface() {
-    QString res = runCmd("nmcli -t -f DEVICE,TYPE device | grep ':wifi' | cut -d: -f1");
-    return res.split("\n").value(0).trimmed();
-}
-
-static QString getIP(const QString &iface) {
-    if (iface.isEmpty()) return "-";
-    QString ip = runCmd("ip -4 addr show " + iface + " | grep -oP '(?<=inet\\s)\\d+(\\.\\d+){3}' | head -n1");
-    return ip.isEmpty() ? "-" : ip;
-}
-
-static QString getMask(const QString &iface) {
-    if (iface.isEmpty()) return "-";
-    QString cidr = runCmd("ip -4 addr show " + iface +
-                          " | grep -oP '(?<=inet\\s)\\d+(\\.\\d+){3}/\\d+' | head -n1 | cut -d/ -f2");
-    if (cidr.isEmpty()) return "-";
-    return cidrToMask(cidr);
-}
-
-static QString getDNS() {
-    QString dns = runCmd("grep 'nameserver' /etc/resolv.conf | head -n1 | awk '{print $2}'");
-    return dns.isEmpty() ? "-" : dns;
-}
-
-static QString getGateway() {
-    QString gw = runCmd("ip route | grep default | awk '{print $3}'");
-    return gw.isEmpty() ? "-" : gw;
-}
-
 // =========================================================
 // MAIN PAGE
 // =========================================================
@@ -201,123 +151,84 @@ extern "C" QWidget* make_page(QStackedWidget *stack) {
     root->addLayout(switchRow);
 
     // =====================================================
-    // LAMBDAS FOR STATE UPDATES
+    // STATE UPDATES (pushed by NetworkManager over D-Bus)
     // =====================================================
 
-    // Scan for SSIDs
-    auto doScan = [ssidList]() {
-        ssidList->clear();
-        QStringList lines = runCmd("nmcli -t -f SSID device wifi list").split("\n");
+    auto *nm = new WospNm::Client(page);
 
-        for (QString s : lines) {
-            s = s.trimmed();
-            if (!s.isEmpty())
-                ssidList->addItem(s);
-        }
+    nm->listen([=]() {
+        const WospNm::State &st = nm->state();
 
-        if (ssidList->count() == 0)
-            ssidList->addItem("No networks found");
-    };
-
-    // Update IP/DNS/Mask/Gateway info
-    auto updateInfo = [ipLbl, dnsLbl, maskLbl, gwLbl]() {
-        QString iface = getWifiIface();
-        ipLbl->setText("IP address: "   + getIP(iface));
-        dnsLbl->setText("DNS server: "  + getDNS());
-        maskLbl->setText("Subnet mask: " + getMask(iface));
-        gwLbl->setText("Gateway: "     + getGateway());
-    };
-
-    // WiFi state updater (text + colour)
-    std::function<void()> updateWifiState;
-    updateWifiState = [toggleWifi]() {
-        QString state = runCmd("nmcli radio wifi");
-        bool on = (state == "enabled");
-
-        if (on) {
-            toggleWifi->setText("On");
-            toggleWifi->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#7CFC00;"      // bright green
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
-        } else {
-            toggleWifi->setText("Off");
-            toggleWifi->setStyleSheet(
-                "QPushButton {"
-                " background:#444444;"
-                " color:#CC6666;"      // dim red
-                " border:1px solid #222222;"
-                " border-radius:16px;"
-                " font-size:26px;"
-                " font-weight:bold;"
-                " padding:10px 24px;"
-                "}"
-                "QPushButton:hover { background:#555555; }"
-                "QPushButton:pressed { background:#333333; }"
-            );
+        // SSID list, keeping the selection across updates
+        QString selected = ssidList->currentItem() ? ssidList->currentItem()->text() : QString();
+        ssidList->clear();
+        for (const WospNm::AccessPoint &ap : st.accessPoints) {
+            ssidList->addItem(ap.ssid);
+            if (ap.ssid == selected) ssidList->setCurrentRow(ssidList->count() - 1);
         }
-    };
-
-    // Initial population
-    doScan();
-    updateInfo();
-    updateWifiState();
+        if (ssidList->count() == 0)
+            ssidList->addItem(st.available ? "No networks found" : "NetworkManager not running");
+
+        auto orDash = [](const QString &v) { return v.isEmpty() ? QString("-") : v; };
+        ipLbl->setText("IP address: "   + orDash(st.address));
+        dnsLbl->setText("DNS server: "  + orDash(st.dns.value(0)));
+        maskLbl->setText("Subnet mask: " + cidrToMask(st.address.isEmpty() ? 0 : st.prefix));
+        gwLbl->setText("Gateway: "     + orDash(st.gateway));
+
+        // WiFi state (text + colour)
+        toggleWifi->setText(st.wirelessEnabled ? "On" : "Off");
+        WospTheme::setShape(toggleWifi, WospTheme::toggleButton(st.wirelessEnabled ? QColor("#7CFC00")     // bright green
+                                                                                   : QColor("#CC6666"))); // dim red
+    });
 
     // -----------------------------------------------------
     // BUTTON CONNECTIONS
     // -----------------------------------------------------
 
-    // Refresh = rescan SSIDs + refresh info + wifi state
-    QObject::connect(refresh, &QPushButton::clicked, [doScan, updateInfo, updateWifiState]() mutable {
-        doScan();
-        updateInfo();
-        updateWifiState();
+    // Refresh = ask NM for a new scan; results arrive as signals
+    QObject::connect(refresh, &QPushButton::clicked, [nm]() {
+        nm->requestScan();
     });
 
-    // Toggle WiFi radio and update visual state
-    QObject::connect(toggleWifi, &QPushButton::clicked, [updateWifiState]() mutable {
-        QString state = runCmd("nmcli radio wifi");
-        if (state == "enabled")
-            runCmd("nmcli radio wifi off");
-        else
-            runCmd("nmcli radio wifi on");
-
-        updateWifiState();
+    QObject::connect(toggleWifi, &QPushButton::clicked, [nm]() {
+        nm->setWirelessEnabled(!nm->state().wirelessEnabled);
     });
 
     // -----------------------------------------------------
     // CONNECT ON SSID CLICK
     // -----------------------------------------------------
-    QObject::connect(ssidList, &QListWidget::itemClicked, [ssidList]() {
+    QObject::connect(ssidList, &QListWidget::itemClicked, [ssidList, nm]() {
         QListWidgetItem *item = ssidList->currentItem();
         if (!item) return;
 
         QString ssid = item->text();
-        if (ssid.contains("No networks")) return;
-
-        bool ok;
-        QString pass = QInputDialog::getText(
-            nullptr, "Wi-Fi Password",
-            "Enter password for:\n" + ssid,
-            QLineEdit::Password,
-            "", &ok
-        );
-        if (!ok || pass.isEmpty()) return;
-
-        QString cmd = QString("nmcli device wifi connect '%1' password '%2'")
-                        .arg(ssid).arg(pass);
-
-        QString out = runCmd(cmd);
-        QMessageBox::information(nullptr, "Wi-Fi", out.isEmpty() ? "Done." : out);
+        bool known = false, secured = false;
+        for (const WospNm::AccessPoint &ap : nm->state().accessPoints) {
+            if (ap.ssid == ssid) { known = true; secured = ap.secured; }
+        }
+        if (!known) return;
+
+        auto report = [](const QString &err) {
+            QMessageBox::information(nullptr, "Wi-Fi", err.isEmpty() ? "Done." : err);
+        };
+
+        auto askPassword = [ssid, nm, report]() {
+            bool ok;
+            QString pass = QInputDialog::getText(
+                nullptr, "Wi-Fi Password",
+                "Enter password for:\n" + ssid,
+                QLineEdit::Password,
+                "", &ok
+            );
+            if (!ok || pass.isEmpty()) return;
+            nm->connectTo(ssid, pass, report);
+        };
+
+        // Saved profiles connect without asking; otherwise prompt
+        nm->connectTo(ssid, QString(), [secured, askPassword, report](const QString &err) {
+            if (!err.isEmpty() && secured) askPassword();
+            else report(err);
+        });
     });
 
     // -----------------------------------------------------
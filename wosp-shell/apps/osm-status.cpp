@@ -8,7 +8,6 @@
 #include <QPushButton>
 #include <QScreen>
 #include <QTimer>
-#include <QGraphicsDropShadowEffect>
 #include <QMouseEvent>
 #include <QLockFile>
 #include <QDir>
@@ -21,9 +20,21 @@
 #include <QDateTime>
 #include <QTextStream>
 #include <QPainter>
+#include <QSocketNotifier>
+#include <QHash>
+#include <QSet>
 
 #include <functional>
 
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "../lib/wosp-shadow.h"
+#include "../lib/wosp-timers.h"
+#include "../lib/wosp-stacking.h"
+
+static const int NOTIFY_FLUSH_MS = 100;    // coalesce a burst of new files
+
 // ───────────────────────────────────────────── Structures
 
 struct NotificationInfo {
@@ -43,6 +54,7 @@ class NotificationBadge;   // forward
 class StatusPanel : public QWidget {
 public:
     explicit StatusPanel(QWidget *parent=nullptr);
+    ~StatusPanel() override;
 
     void refreshNotifications();
     void removeNotification(const QString &path);
@@ -75,6 +87,21 @@ private:
     int          m_maxH;
     QString      m_dirPath;
     int          m_notificationCount;
+
+    // ~/.osm-notify watch; cards by file path, parsed once
+    int              m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer           m_flush;
+    QSet<QString>    m_dirty;
+    bool             m_fullRescan = false;
+    QHash<QString, NotificationCard*> m_cards;
+
+    void watchDirectory();
+    void readEvents();
+    void applyChanges();
+    void insertCard(const NotificationInfo &info);
+    bool dropCard(const QString &path);
+    void updateLayout();
 };
 
 // ───────────────────────────────────────────── NotificationCard
@@ -83,6 +110,8 @@ class NotificationCard : public QFrame {
 public:
     NotificationCard(StatusPanel *panel, const NotificationInfo &info, QWidget *parent=nullptr);
 
+    const NotificationInfo &info() const { return m_info; }
+
 protected:
     void mousePressEvent(QMouseEvent *e) override;
 
@@ -108,7 +137,6 @@ protected:
 private:
     OverlayRoot *m_overlay;
     int          m_count;
-    QTimer      *m_raiseTimer;
 };
 
 // ───────────────────────────────────────────── StatusPanel impl
@@ -167,24 +195,119 @@ StatusPanel::StatusPanel(QWidget *parent)
     inner->addWidget(m_content);
     outer->addWidget(m_inner);
 
-    // shadow (same as osm-running)
-    QGraphicsDropShadowEffect *sh = new QGraphicsDropShadowEffect(this);
-    sh->setBlurRadius(32);
-    sh->setOffset(0, 0);
-    sh->setColor(QColor(0, 0, 0, 220));
-    m_inner->setGraphicsEffect(sh);
+    // shadow (same as osm-running), blurred once and cached
+    WospShadow::attach(m_inner, 32, 26, QColor(0, 0, 0, 220));
 
     // notifications folder
     m_dirPath = QDir::homePath() + "/.osm-notify";
     QDir d(m_dirPath);
     if (!d.exists()) d.mkpath(".");
 
-    QTimer *t = new QTimer(this);
-    t->setInterval(600);
-    connect(t, &QTimer::timeout, [this](){ refreshNotifications(); });
+    watchDirectory();
+    refreshNotifications();
+}
+
+StatusPanel::~StatusPanel() {
+    if (m_fd >= 0) ::close(m_fd);
+}
+
+// Cards only change when a file in ~/.osm-notify does, so an idle panel
+// costs nothing. Writers either write in place (CLOSE_WRITE) or rename
+// a finished file in (MOVED_TO).
+void StatusPanel::watchDirectory() {
+    m_flush.setSingleShot(true);
+    m_flush.setInterval(NOTIFY_FLUSH_MS);
+    connect(&m_flush, &QTimer::timeout, this, [this]{ applyChanges(); });
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd >= 0 && inotify_add_watch(m_fd, QFile::encodeName(m_dirPath).constData(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ONLYDIR) >= 0) {
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, [this]{ readEvents(); });
+        return;
+    }
+
+    // No inotify: rescan on the same 600 ms grid as osm-running
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+    auto *t = new WospTimers::Periodic("status-poll", 600, this,
+                                       [this](){ refreshNotifications(); });
     t->start();
+}
 
-    refreshNotifications();
+void StatusPanel::readEvents() {
+    alignas(struct inotify_event) char buf[4096];
+    for (;;) {
+        ssize_t n = ::read(m_fd, buf, sizeof(buf));
+        if (n <= 0) break;
+
+        for (char *p = buf; p < buf + n; ) {
+            auto *ev = reinterpret_cast<struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) { m_fullRescan = true; continue; }
+            if (!ev->len || (ev->mask & IN_ISDIR)) continue;
+
+            // What the full scan lists: visible *.txt files
+            QString name = QFile::decodeName(ev->name);
+            if (name.startsWith('.') || !name.endsWith(".txt", Qt::CaseInsensitive)) continue;
+            m_dirty.insert(m_dirPath + "/" + name);
+        }
+    }
+    // One layout pass for a whole burst
+    if (m_fullRescan || !m_dirty.isEmpty())
+        m_flush.start();
+}
+
+// First non-empty line is the title, the rest the body
+static bool readNotification(const QFileInfo &fi, NotificationInfo &info) {
+    if (!fi.isFile()) return false;
+
+    QFile f(fi.absoluteFilePath());
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    QTextStream in(&f);
+    QString contents = in.readAll();
+
+    QStringList lines = contents.split('\n');
+    for (QString &ln : lines)
+        ln = ln.trimmed();
+
+    QString rawTitle;
+    QString body;
+
+    int firstNonEmpty = -1;
+    for (int i = 0; i < lines.size(); ++i) {
+        if (!lines[i].isEmpty()) {
+            firstNonEmpty = i;
+            break;
+        }
+    }
+
+    if (firstNonEmpty >= 0) {
+        rawTitle = lines[firstNonEmpty];
+        QStringList rest;
+        for (int i = firstNonEmpty + 1; i < lines.size(); ++i)
+            rest << lines[i];
+        body = rest.join('\n').trimmed();
+    }
+
+    QString title = rawTitle;
+    if (title.isEmpty()) {
+        QString base = fi.completeBaseName();
+        if (!base.isEmpty())
+            title = base;
+        else
+            title = "(REDACTED)";
+        body = contents.trimmed();
+    }
+
+    info.title = title;
+    info.body  = body;
+    info.path  = fi.absoluteFilePath();
+    info.when  = fi.lastModified();
+    return true;
 }
 
 // HEIGHT BASED ON ACTUAL CARD SIZEHINTS (auto height)
@@ -220,13 +343,10 @@ void StatusPanel::resizeToItems(int count) {
     setGeometry(screenGeo.width() - m_width, top, m_width, h);
 }
 
+// Full rescan: at startup, after an inotify queue overflow, or polled
 void StatusPanel::refreshNotifications() {
-    // clear list
-    QLayoutItem *it;
-    while((it = m_list->takeAt(0))) {
-        if(it->widget()) it->widget()->deleteLater();
-        delete it;
-    }
+    for (const QString &path : m_cards.keys())
+        dropCard(path);
 
     QDir dir(m_dirPath);
     dir.setNameFilters(QStringList() << "*.txt");
@@ -239,67 +359,68 @@ void StatusPanel::refreshNotifications() {
     // newest first
     std::reverse(files.begin(), files.end());
 
-    QStringList titles;
-    int count = 0;
-
     for (const QFileInfo &fi : files) {
-        QFile f(fi.absoluteFilePath());
-        if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
-            continue;
-
-        QTextStream in(&f);
-        QString contents = in.readAll();
+        NotificationInfo info;
+        if (readNotification(fi, info))
+            insertCard(info);
+    }
 
-        QStringList lines = contents.split('\n');
-        for (QString &ln : lines)
-            ln = ln.trimmed();
+    updateLayout();
+}
 
-        QString rawTitle;
-        QString body;
+void StatusPanel::applyChanges() {
+    if (m_fullRescan) {
+        m_fullRescan = false;
+        m_dirty.clear();
+        refreshNotifications();
+        return;
+    }
 
-        int firstNonEmpty = -1;
-        for (int i = 0; i < lines.size(); ++i) {
-            if (!lines[i].isEmpty()) {
-                firstNonEmpty = i;
-                break;
-            }
+    bool changed = false;
+    for (const QString &path : m_dirty) {
+        // Rewritten files are re-read; their card is replaced in place
+        if (dropCard(path)) changed = true;
+        NotificationInfo info;
+        if (readNotification(QFileInfo(path), info)) {
+            insertCard(info);
+            changed = true;
         }
+    }
+    m_dirty.clear();
 
-        if (firstNonEmpty >= 0) {
-            rawTitle = lines[firstNonEmpty];
-            QStringList rest;
-            for (int i = firstNonEmpty + 1; i < lines.size(); ++i)
-                rest << lines[i];
-            body = rest.join('\n').trimmed();
-        } else {
-            rawTitle.clear();
-            body.clear();
-        }
+    if (changed) updateLayout();
+}
 
-        QString title = rawTitle;
-        if (title.isEmpty()) {
-            QString base = fi.completeBaseName();
-            if (!base.isEmpty())
-                title = base;
-            else
-                title = "(REDACTED)";
-            body = contents.trimmed();
-        }
+void StatusPanel::insertCard(const NotificationInfo &info) {
+    // newest first, the order a full scan lists them in
+    int at = 0;
+    for (; at < m_list->count(); ++at) {
+        auto *c = static_cast<NotificationCard*>(m_list->itemAt(at)->widget());
+        if (c && c->info().when <= info.when) break;
+    }
 
-        NotificationInfo info;
-        info.title = title;
-        info.body  = body;
-        info.path  = fi.absoluteFilePath();
-        info.when  = fi.lastModified();
+    NotificationCard *card = new NotificationCard(this, info, m_content);
+    m_list->insertWidget(at, card);
+    m_cards.insert(info.path, card);
+}
 
-        titles << title;
+bool StatusPanel::dropCard(const QString &path) {
+    NotificationCard *card = m_cards.take(path);
+    if (!card) return false;
 
-        NotificationCard *card = new NotificationCard(this, info, m_content);
-        m_list->addWidget(card);
-        count++;
-    }
+    m_list->removeWidget(card);
+    card->hide();
+    // May be the card whose close button is still on the stack
+    card->deleteLater();
+    return true;
+}
 
-    m_notificationCount = count;
+void StatusPanel::updateLayout() {
+    QStringList titles;
+    for (NotificationCard *card : m_cards)
+        titles << card->info().title;
+
+    m_notificationCount = m_cards.size();
 
     // compute and apply width (same logic as osm-running)
     int needed = computeRequiredWidth(titles);
@@ -310,19 +431,21 @@ void StatusPanel::refreshNotifications() {
     if (g.width() != m_width || g.x() != x)
         setGeometry(x, g.y(), m_width, g.height());
 
-    resizeToItems(count);
+    resizeToItems(m_notificationCount);
 
     if (onCountChanged)
         onCountChanged(m_notificationCount);
 
     // auto-close when empty, same behaviour as SidePanel’s onClose
-    if (count == 0 && onClose)
+    if (m_notificationCount == 0 && onClose)
         onClose();
 }
 
 void StatusPanel::removeNotification(const QString &path) {
     QFile::remove(path);
-    refreshNotifications();
+    // The IN_DELETE that follows finds nothing left to do
+    if (dropCard(path))
+        updateLayout();
 }
 
 // ───────────────────────────────────────────── NotificationCard impl
@@ -406,8 +529,7 @@ void NotificationCard::mousePressEvent(QMouseEvent *e) {
 NotificationBadge::NotificationBadge(OverlayRoot *overlay, QWidget *parent)
     : QWidget(nullptr),        // force top-level window
       m_overlay(overlay),
-      m_count(0),
-      m_raiseTimer(nullptr)
+      m_count(0)
 {
     Q_UNUSED(parent);
 
@@ -428,13 +550,8 @@ NotificationBadge::NotificationBadge(OverlayRoot *overlay, QWidget *parent)
 
     hide();
 
-    m_raiseTimer = new QTimer(this);
-    m_raiseTimer->setInterval(1500);
-    connect(m_raiseTimer, &QTimer::timeout, this, [this]() {
-        if (isVisible())
-            this->raise();
-    });
-    m_raiseTimer->start();
+    // Re-raised only when another window is stacked above it
+    WospStacking::keepOnTop(this);
 }
 
 void NotificationBadge::setCount(int c) {
@@ -537,6 +654,8 @@ public:
                 m_badge->setCount(0);  // overlay open ⇒ hide badge
             }
         };
+        // The first scan ran before this was wired, and nothing polls now
+        m_badge->setCount(m_panel->notificationCount());
 
         hide(); // start hidden
     }
@@ -648,12 +767,7 @@ public:
         raise();
 
         // keep stubbornly on top, like osm-running
-        m_raiseTimer = new QTimer(this);
-        m_raiseTimer->setInterval(1500);
-        connect(m_raiseTimer, &QTimer::timeout, this, [this]() {
-            this->raise();
-        });
-        m_raiseTimer->start();
+        WospStacking::keepOnTop(this);
     }
 
 protected:
@@ -697,21 +811,38 @@ private:
     OverlayRoot *m_overlay;
     bool         m_dragging;
     QPoint       m_pressPos;
-    QTimer      *m_raiseTimer;
 };
 
 // ───────────────────────────────────────────── main
 
+// Single-instance lock and windows; shared by main() and wosp-host
+static bool startStatus() {
+    QLockFile *lock = new QLockFile(QDir::temp().absoluteFilePath("osm-status.lock"));
+    lock->setStaleLockTime(0);
+    if(!lock->tryLock(20)) {
+        delete lock;
+        return false;
+    }
+    QObject::connect(qApp, &QCoreApplication::aboutToQuit, [lock](){ delete lock; });
+
+    OverlayRoot *root = new OverlayRoot;    // overlay window
+    new ActivationEdgeBar(root);            // always-on-top gesture edge
+    return true;
+}
+
+#ifdef WOSP_HOST_ENTRY
+// Built as /usr/local/lib/wosp/host/osm-status.so and loaded by wosp-host
+extern "C" int wosp_host_main(int, char **)
+{
+    return startStatus() ? 0 : 1;
+}
+#else
 int main(int argc,char**argv) {
     QApplication app(argc,argv);
 
-    QLockFile lock(QDir::temp().absoluteFilePath("osm-status.lock"));
-    lock.setStaleLockTime(0);
-    if(!lock.tryLock(20))
+    if(!startStatus())
         return 0;
 
-    OverlayRoot root;          // overlay window
-    ActivationEdgeBar bar(&root);   // always-on-top gesture edge
-
     return app.exec();
 }
+#endif
@@ -695,7 +695,13 @@ private:
  * main
  *───────────────────────────────────────────────────────────*/
 
-int main(int argc, char *argv[]) {
+#ifdef OSM_ZYGOTE_ENTRY
+// Built as /usr/local/lib/wosp/osm-viewer.so and forked by osm-zygote
+extern "C" int osm_main(int argc, char *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
     QApplication app(argc, argv);
 
     MainWindow w;
@@ -0,0 +1,293 @@
+// osm-zygote — pre-initialised launcher for the osm-* Qt apps
+//
+// Every osm app is also built as /usr/local/lib/wosp/<app>.so exporting
+// `extern "C" int osm_main(int, char**)` (compiled with -DOSM_ZYGOTE_ENTRY).
+// At start-up the zygote dlopens all of them, which pays dynamic linking and
+// relocation of Qt5 and its dependencies once, preloads the xcb platform and
+// image format plugins and builds the fontconfig cache. It then listens on
+// $XDG_RUNTIME_DIR/osm-zygote.sock and forks a child per request; the child
+// adopts the caller's cwd and environment and runs osm_main() directly.
+//
+// The X connection and QApplication itself are NOT created here: an xcb
+// socket cannot be shared between a parent and forked children, so each
+// child still opens its own. Everything before that is already warm.
+//
+// Requests come from osm-launch and the shell (lib/wosp-zygote.h has the
+// wire format).
+// Each forked child is recorded as $XDG_RUNTIME_DIR/osm-zygote/<pid>,
+// holding the pid of the osm-launch that asked for it: the child never
+// execs, so nothing it sets in its own environment is visible to others,
+// and launch tracing needs that link to find the app's windows.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <glob.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+static const char *APP_DIR = "/usr/local/lib/wosp";
+static const char *APPS[] = {
+    "osm-files", "osm-viewer", "osm-draw", "osm-power", "osm-paper", "osm-rocker",
+};
+static const uint32_t MAX_REQUEST = 64 * 1024;
+
+// Qt loads these by path later; dlopen then just bumps the refcount
+static const char *QT_PLUGINS[] = {
+    "/usr/lib/*/qt5/plugins/platforms/libqxcb.so",
+    "/usr/lib/*/qt5/plugins/xcbglintegrations/*.so",
+    "/usr/lib/*/qt5/plugins/imageformats/*.so",
+    "/usr/lib/*/qt5/plugins/platforminputcontexts/*.so",
+};
+
+typedef int (*OsmMain)(int, char **);
+
+struct App {
+    std::string name;
+    OsmMain entry;
+};
+
+// Wire header; followed by `len` bytes of NUL-terminated strings:
+// app, cwd, argv[0..argc), env[0..envc)
+struct RequestHeader {
+    uint32_t len;
+    uint32_t argc;
+    uint32_t envc;
+};
+
+std::string runtimeDir() {
+    const char *rt = getenv("XDG_RUNTIME_DIR");
+    return (rt && *rt) ? rt : "/run/user/" + std::to_string(getuid());
+}
+
+std::string socketPath() {
+    return runtimeDir() + "/osm-zygote.sock";
+}
+
+// child pid -> osm-launch client, read by WospLaunchTrace::launchParent()
+void recordLaunch(pid_t child, pid_t client) {
+    std::string dir = runtimeDir() + "/osm-zygote";
+    mkdir(dir.c_str(), 0700);
+
+    // Children are reaped by the kernel; forget the ones that are gone
+    if (DIR *d = opendir(dir.c_str())) {
+        while (dirent *e = readdir(d)) {
+            if (e->d_name[0] == '.') continue;
+            pid_t pid = pid_t(atoi(e->d_name));
+            if (pid <= 0 || (kill(pid, 0) != 0 && errno == ESRCH))
+                unlinkat(dirfd(d), e->d_name, 0);
+        }
+        closedir(d);
+    }
+
+    std::string path = dir + "/" + std::to_string(child);
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return;
+    std::string value = std::to_string(client);
+    write(fd, value.data(), value.size());
+    close(fd);
+}
+
+// Preload every app entry point; returns the ones that resolved
+std::vector<App> loadApps() {
+    std::vector<App> apps;
+    for (const char *name : APPS) {
+        std::string path = std::string(APP_DIR) + "/" + name + ".so";
+        // RTLD_LOCAL: the apps share helper names, keep them apart
+        void *h = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!h) {
+            std::cerr << "osm-zygote: " << dlerror() << "\n";
+            continue;
+        }
+        OsmMain entry = reinterpret_cast<OsmMain>(dlsym(h, "osm_main"));
+        if (!entry) {
+            std::cerr << "osm-zygote: " << path << " has no osm_main\n";
+            continue;
+        }
+        apps.push_back({name, entry});
+    }
+    return apps;
+}
+
+void preloadPlugins() {
+    for (const char *pattern : QT_PLUGINS) {
+        glob_t g;
+        if (glob(pattern, 0, nullptr, &g) != 0) continue;
+        for (size_t i = 0; i < g.gl_pathc; i++) {
+            if (!dlopen(g.gl_pathv[i], RTLD_NOW | RTLD_LOCAL))
+                std::cerr << "osm-zygote: " << dlerror() << "\n";
+        }
+        globfree(&g);
+    }
+}
+
+// Parse the font configuration and cache once; children inherit it
+void warmFontconfig() {
+    void *fc = dlopen("libfontconfig.so.1", RTLD_NOW | RTLD_NOLOAD);
+    if (!fc) return;
+    typedef int (*FcInitFn)();
+    if (FcInitFn init = reinterpret_cast<FcInitFn>(dlsym(fc, "FcInit"))) init();
+}
+
+bool readFull(int fd, void *buf, size_t n) {
+    char *p = static_cast<char*>(buf);
+    while (n > 0) {
+        ssize_t r = read(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= size_t(r);
+    }
+    return true;
+}
+
+// Runs in the forked child; never returns
+[[noreturn]] void runChild(const App &app, const std::vector<std::string> &strings,
+                           uint32_t argc) {
+    setsid();
+    signal(SIGCHLD, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+
+    if (chdir(strings[1].c_str()) != 0) {
+        if (const char *home = getenv("HOME")) chdir(home);
+    }
+
+    // The caller's environment wins; anything it lacks (e.g. DISPLAY for
+    // osm-powerd) comes from the session the zygote was started in
+    for (size_t i = 2 + argc; i < strings.size(); i++) {
+        size_t eq = strings[i].find('=');
+        if (eq == std::string::npos || eq == 0) continue;
+        setenv(strings[i].substr(0, eq).c_str(), strings[i].c_str() + eq + 1, 1);
+    }
+
+    std::vector<char*> argv;
+    for (uint32_t i = 0; i < argc; i++)
+        argv.push_back(const_cast<char*>(strings[2 + i].c_str()));
+    if (argv.empty()) argv.push_back(const_cast<char*>(app.name.c_str()));
+    argv.push_back(nullptr);
+
+    int n = int(argv.size()) - 1;
+    int rc = app.entry(n, argv.data());
+    exit(rc);
+}
+
+void handleClient(int listenFd, int fd, const std::vector<App> &apps) {
+    ucred cred{};
+    socklen_t credLen = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credLen) != 0
+        || cred.uid != getuid()) {
+        std::cerr << "osm-zygote: rejecting foreign client\n";
+        return;
+    }
+
+    // A stuck client must not stall every other launch
+    timeval tv{2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    RequestHeader hdr{};
+    if (!readFull(fd, &hdr, sizeof(hdr)) || hdr.len == 0 || hdr.len > MAX_REQUEST)
+        return;
+
+    std::vector<char> payload(hdr.len);
+    if (!readFull(fd, payload.data(), hdr.len) || payload.back() != '\0')
+        return;
+
+    std::vector<std::string> strings;
+    for (size_t off = 0; off < payload.size(); off += strings.back().size() + 1)
+        strings.emplace_back(payload.data() + off);
+
+    int32_t pid = -1;
+    const App *app = nullptr;
+    if (strings.size() == 2 + size_t(hdr.argc) + hdr.envc) {
+        for (const App &a : apps)
+            if (a.name == strings[0]) app = &a;
+    }
+
+    if (app) {
+        pid_t child = fork();
+        if (child == 0) {
+            close(listenFd);
+            close(fd);
+            runChild(*app, strings, hdr.argc);
+        }
+        if (child < 0) perror("osm-zygote: fork");
+        // Written before the reply, long before the child maps a window
+        else recordLaunch(child, cred.pid);
+        pid = child;
+    }
+
+    // -1 tells osm-launch to fall back to exec
+    write(fd, &pid, sizeof(pid));
+}
+
+int main() {
+    std::string path = socketPath();
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "osm-zygote: socket path too long\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, path.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        perror("osm-zygote: socket");
+        return 1;
+    }
+
+    // qtile re-runs autostart on every config reload
+    if (connect(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+        std::cerr << "osm-zygote: already running\n";
+        return 0;
+    }
+    close(listenFd);
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    std::vector<App> apps = loadApps();
+    if (apps.empty()) {
+        std::cerr << "osm-zygote: no apps found in " << APP_DIR << "\n";
+        return 1;
+    }
+    preloadPlugins();
+    warmFontconfig();
+
+    // Children are detached; let the kernel reap them
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+
+    unlink(path.c_str());
+    mode_t old = umask(077);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        perror("osm-zygote: bind");
+        return 1;
+    }
+    umask(old);
+    if (listen(listenFd, 16) != 0) {
+        perror("osm-zygote: listen");
+        return 1;
+    }
+
+    std::cerr << "osm-zygote: " << apps.size() << " apps ready on " << path << "\n";
+
+    for (;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EINTR) perror("osm-zygote: accept");
+            continue;
+        }
+        handleClient(listenFd, fd, apps);
+        close(fd);
+    }
+}
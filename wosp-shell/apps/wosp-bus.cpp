@@ -0,0 +1,290 @@
+// wosp-bus — command bus for shell actions
+//
+// Opening the power menu or showing the keyboard used to mean spawning a
+// helper (xdotool, pkill -USR1 ...) for every press.
+// Long-running components now subscribe to verbs on
+// $XDG_RUNTIME_DIR/wosp-bus.sock and anything can trigger them with one
+// framed write (see lib/wosp-bus.h for the wire format):
+//
+//   overlay.open / overlay.close        wosp-shell
+//   power.menu                          wosp-shell (opens osm-power)
+//   keyboard.show / .hide / .toggle     wosp-keyboard
+//
+// A subscription to "*" receives every verb, which is what `listen` uses
+// for debugging. The daemon never interprets verbs or payloads; it only
+// fans frames out and tells senders that asked how many handlers it
+// reached, so they can fall back to the old spawn when the answer is 0.
+//
+// Usage:
+//   wosp-bus [serve]                    run the daemon
+//   wosp-bus send <verb> [payload]      exit 1 if no handler took it
+//   wosp-bus listen [verb...]           print deliveries (default "*")
+//
+// Runs as the session user; the socket is created 0600.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "../lib/wosp-bus.h"
+
+static const int MAX_EVENTS = 16;
+static const size_t HEADER = sizeof(wosp_bus_header);
+static const size_t MAX_QUEUED = 64 * 1024;    // unsent bytes per client
+
+struct Client {
+    int fd;
+    std::string in;                     // partial frames
+    std::string out;                    // unsent tail, whole frames only
+    bool wantOut;                       // EPOLLOUT armed
+    std::vector<std::string> verbs;     // subscriptions, "*" for all
+};
+
+// ───────────────────────── daemon ─────────────────────────
+
+static int openListener() {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (wosp_bus_path(addr.sun_path, sizeof(addr.sun_path)) != 0) {
+        std::cerr << "wosp-bus: socket path too long\n";
+        return -1;
+    }
+
+    // qtile re-runs autostart on every config reload
+    int probe = wosp_bus_connect();
+    if (probe >= 0) {
+        close(probe);
+        std::cerr << "wosp-bus: already running\n";
+        exit(0);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+
+    unlink(addr.sun_path);
+    mode_t old = umask(077);
+    int r = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    umask(old);
+    if (r != 0 || listen(fd, 16) != 0) {
+        perror("wosp-bus: bind");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool subscribed(const Client &c, const std::string &verb) {
+    for (const std::string &v : c.verbs)
+        if (v == verb || v == "*") return true;
+    return false;
+}
+
+static std::string frame(uint8_t type, const std::string &verb,
+                         const char *payload, size_t len, uint32_t value) {
+    wosp_bus_header h{};
+    h.type = type;
+    h.verb_len = uint8_t(verb.size());
+    h.payload_len = uint16_t(len);
+    h.value = value;
+    std::string f(reinterpret_cast<const char*>(&h), HEADER);
+    f += verb;
+    if (len) f.append(payload, len);
+    return f;
+}
+
+// Write what the socket takes of c.out and keep EPOLLOUT armed while
+// anything is left; false if the peer is gone
+static bool flush(int ep, Client &c) {
+    while (!c.out.empty()) {
+        ssize_t w = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (w > 0) { c.out.erase(0, size_t(w)); continue; }
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        c.out.clear();      // reaped on its EPOLLHUP/EPOLLERR
+        return false;
+    }
+
+    bool want = !c.out.empty();
+    if (want != c.wantOut) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | (want ? uint32_t(EPOLLOUT) : 0u);
+        ev.data.fd = c.fd;
+        epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &ev);
+        c.wantOut = want;
+    }
+    return true;
+}
+
+// A frame is queued whole or not at all: a short write leaves its tail in
+// c.out for EPOLLOUT, so the stream a subscriber reads never loses sync
+static bool enqueue(int ep, Client &c, const std::string &f) {
+    if (c.out.size() + f.size() > MAX_QUEUED) return false;
+    c.out += f;
+    return flush(ep, c);
+}
+
+// Frames are small and handlers read them straight away; a subscriber
+// that stopped reading misses whole frames rather than stalling everyone
+static uint32_t deliver(int ep, std::vector<Client> &clients, const Client &from,
+                        const std::string &verb, const char *payload, size_t len) {
+    std::string f = frame(WOSP_BUS_DELIVER, verb, payload, len, 0);
+    uint32_t reached = 0;
+    for (Client &c : clients) {
+        if (&c == &from || !subscribed(c, verb)) continue;
+
+        if (enqueue(ep, c, f))
+            ++reached;
+        else
+            std::cerr << "wosp-bus: dropped " << verb << " for a busy handler\n";
+    }
+    return reached;
+}
+
+// Handle every complete frame in c.in; false if the client misbehaved
+static bool process(int ep, std::vector<Client> &clients, Client &c) {
+    size_t off = 0;
+    while (c.in.size() - off >= HEADER) {
+        wosp_bus_header h;
+        memcpy(&h, c.in.data() + off, HEADER);
+        if (h.verb_len == 0 || h.payload_len > WOSP_BUS_MAX_PAYLOAD) return false;
+
+        size_t total = HEADER + h.verb_len + h.payload_len;
+        if (c.in.size() - off < total) break;
+
+        std::string verb = c.in.substr(off + HEADER, h.verb_len);
+        const char *payload = c.in.data() + off + HEADER + h.verb_len;
+
+        if (h.type == WOSP_BUS_SUBSCRIBE) {
+            if (!subscribed(c, verb)) c.verbs.push_back(verb);
+        } else if (h.type == WOSP_BUS_SEND) {
+            uint32_t reached = deliver(ep, clients, c, verb, payload, h.payload_len);
+            if (h.value && !enqueue(ep, c, frame(WOSP_BUS_ACK, verb, nullptr, 0, reached)))
+                return false;
+        } else {
+            return false;
+        }
+        off += total;
+    }
+    c.in.erase(0, off);
+    return true;
+}
+
+static int serve() {
+    signal(SIGPIPE, SIG_IGN);
+
+    int listenFd = openListener();
+    if (listenFd < 0) return 1;
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, listenFd, &ev);
+
+    std::vector<Client> clients;
+    epoll_event events[MAX_EVENTS];
+
+    for (;;) {
+        int n = epoll_wait(ep, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno != EINTR) perror("wosp-bus: epoll_wait");
+            continue;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == listenFd) {
+                int c;
+                while ((c = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+                    epoll_event cev{};
+                    cev.events = EPOLLIN;
+                    cev.data.fd = c;
+                    epoll_ctl(ep, EPOLL_CTL_ADD, c, &cev);
+                    clients.push_back(Client{c, std::string(), std::string(), false, {}});
+                }
+                continue;
+            }
+
+            size_t idx = 0;
+            while (idx < clients.size() && clients[idx].fd != fd) ++idx;
+            if (idx == clients.size()) continue;
+
+            bool alive = true;
+            if (events[i].events & EPOLLOUT)
+                alive = flush(ep, clients[idx]);
+
+            char buf[4096];
+            for (;;) {
+                ssize_t r = read(fd, buf, sizeof(buf));
+                if (r > 0) { clients[idx].in.append(buf, size_t(r)); continue; }
+                if (r < 0 && errno == EINTR) continue;
+                if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) alive = false;
+                break;
+            }
+            if (alive) alive = process(ep, clients, clients[idx]);
+
+            if (!alive) {
+                epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+                close(fd);
+                clients.erase(clients.begin() + long(idx));
+            }
+        }
+    }
+}
+
+// ───────────────────────── CLI ─────────────────────────
+
+static int sendVerb(const char *verb, const char *payload) {
+    size_t len = payload ? strlen(payload) : 0;
+    int handlers = wosp_bus_send(verb, payload, len);
+    if (handlers < 0) {
+        std::cerr << "wosp-bus: daemon not running\n";
+        return 2;
+    }
+    return handlers > 0 ? 0 : 1;
+}
+
+static int listenVerbs(int argc, char **argv) {
+    int fd = wosp_bus_connect();
+    if (fd < 0) {
+        std::cerr << "wosp-bus: daemon not running\n";
+        return 2;
+    }
+    if (argc == 0) wosp_bus_subscribe(fd, "*");
+    for (int i = 0; i < argc; ++i) wosp_bus_subscribe(fd, argv[i]);
+
+    char verb[WOSP_BUS_MAX_VERB + 1];
+    char payload[WOSP_BUS_MAX_PAYLOAD];
+    size_t len = 0;
+    int type;
+    while ((type = wosp_bus_read(fd, verb, sizeof(verb), payload, sizeof(payload), &len, nullptr)) >= 0) {
+        if (type != WOSP_BUS_DELIVER) continue;
+        std::cout << verb;
+        if (len) std::cout << ' ' << std::string(payload, len);
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    std::string cmd = argc > 1 ? argv[1] : "serve";
+
+    if (cmd == "serve") return serve();
+    if (cmd == "send" && argc >= 3) return sendVerb(argv[2], argc > 3 ? argv[3] : nullptr);
+    if (cmd == "listen") return listenVerbs(argc - 2, argv + 2);
+
+    std::cerr << "usage: wosp-bus [serve]\n"
+                 "       wosp-bus send <verb> [payload]\n"
+                 "       wosp-bus listen [verb...]\n";
+    return 2;
+}
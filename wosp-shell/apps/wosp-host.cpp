@@ -0,0 +1,164 @@
+// wosp-host — runs the resident shell components in one process
+//
+// wosp-shell, osm-status, osm-running and wosp-keyboard are resident Qt
+// processes, and each pays for its own QApplication, xcb connection, font
+// database, style and image caches. Each of them is also built as
+// /usr/local/lib/wosp/host/<name>.so exporting
+// `extern "C" int wosp_host_main(int, char**)` (compiled with
+// -DWOSP_HOST_ENTRY), which builds its windows on the QApplication that
+// already exists and returns 0. wosp-host creates that one QApplication,
+// loads the components named on its command line (COMPONENTS by default)
+// and runs a single event loop for all of them. The lib/ helpers keep
+// their process-wide state on qApp (config stores, the image atlas, the
+// timer scheduler, the stacking guard), so hosted components share those
+// too instead of holding one copy each.
+//
+// The standalone binaries stay for debugging. osm-status and osm-running
+// keep their single-instance lock files, so a hosted and a standalone
+// copy never run side by side. wosp-lock is never hosted: the lock screen
+// must survive a crash in any other component.
+//
+//   wosp-host [component...]   run the components in this process
+//   wosp-host --pss            Pss of every shell process and the total,
+//                              to compare standalone against hosted
+
+#include <QApplication>
+#include <QLockFile>
+#include <QDir>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include <dirent.h>
+
+static const char *HOST_DIR = "/usr/local/lib/wosp/host";
+static const char *COMPONENTS[] = {
+    "wosp-shell", "osm-status", "osm-running",
+};
+
+// Resident shell processes, by /proc/<pid>/comm
+static const char *SHELL_PROCESSES[] = {
+    "wosp-host", "wosp-shell", "osm-status", "osm-running", "wosp-keyboard", "wosp-lock",
+};
+
+typedef int (*HostMain)(int, char **);
+
+// ───────────────────────── Pss report ─────────────────────────
+
+static std::string readComm(const std::string &pid) {
+    std::ifstream f("/proc/" + pid + "/comm");
+    std::string name;
+    std::getline(f, name);
+    return name;
+}
+
+// Pss in kB from smaps_rollup; -1 if the process is gone or not ours
+static long readPss(const std::string &pid) {
+    std::ifstream f("/proc/" + pid + "/smaps_rollup");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.compare(0, 4, "Pss:") != 0) continue;
+        std::istringstream in(line.substr(4));
+        long kb = -1;
+        in >> kb;
+        return kb;
+    }
+    return -1;
+}
+
+static int reportPss() {
+    DIR *d = opendir("/proc");
+    if (!d) {
+        perror("wosp-host: /proc");
+        return 1;
+    }
+
+    long total = 0;
+    int count = 0;
+    while (dirent *e = readdir(d)) {
+        std::string pid = e->d_name;
+        if (pid.find_first_not_of("0123456789") != std::string::npos) continue;
+
+        std::string name = readComm(pid);
+        bool shell = false;
+        for (const char *p : SHELL_PROCESSES) shell = shell || name == p;
+        if (!shell) continue;
+
+        long kb = readPss(pid);
+        if (kb < 0) continue;
+        std::cout << std::setw(8) << pid << "  " << std::left << std::setw(16) << name
+                  << std::right << std::setw(10) << kb << " kB\n";
+        total += kb;
+        ++count;
+    }
+    closedir(d);
+
+    std::cout << std::setw(8) << count << "  " << std::left << std::setw(16) << "processes"
+              << std::right << std::setw(10) << total << " kB Pss total\n";
+    return 0;
+}
+
+// ───────────────────────── host ─────────────────────────
+
+static bool startComponent(const std::string &name, int argc, char **argv) {
+    std::string path = std::string(HOST_DIR) + "/" + name + ".so";
+
+    // RTLD_LOCAL: components share class names (OverlayRoot, ...), keep them apart
+    void *h = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!h) {
+        std::cerr << "wosp-host: " << dlerror() << "\n";
+        return false;
+    }
+    HostMain entry = reinterpret_cast<HostMain>(dlsym(h, "wosp_host_main"));
+    if (!entry) {
+        std::cerr << "wosp-host: " << name << ": no wosp_host_main\n";
+        return false;
+    }
+    if (entry(argc, argv) != 0) {
+        std::cerr << "wosp-host: " << name << ": not started (already running?)\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--pss")
+        return reportPss();
+
+    QApplication app(argc, argv);
+    // One component closing its last window must not end the others
+    app.setQuitOnLastWindowClosed(false);
+
+    // qtile re-runs autostart on every config reload
+    QLockFile lock(QDir::temp().absoluteFilePath("wosp-host.lock"));
+    lock.setStaleLockTime(0);
+    if (!lock.tryLock(20)) {
+        std::cerr << "wosp-host: already running\n";
+        return 0;
+    }
+
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; ++i) names.push_back(argv[i]);
+    if (names.empty())
+        for (const char *c : COMPONENTS) names.push_back(c);
+
+    int started = 0;
+    for (const std::string &name : names) {
+        if (name == "wosp-lock") {
+            std::cerr << "wosp-host: wosp-lock stays a separate process\n";
+            continue;
+        }
+        if (startComponent(name, argc, argv)) ++started;
+    }
+    if (started == 0) {
+        std::cerr << "wosp-host: nothing to run\n";
+        return 1;
+    }
+
+    std::cerr << "wosp-host: " << started << " components in pid " << QCoreApplication::applicationPid() << "\n";
+    return app.exec();
+}
@@ -6,6 +6,8 @@
 #include <QMouseEvent>
 #include <QScreen>
 
+#include "../lib/wosp-bus.h"
+
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <X11/keysym.h>
@@ -223,15 +225,51 @@ protected:
     }
 };
 
+// ------------------------------------------------------------
+// Show / hide, shared by the swipe and wosp-bus
+// ------------------------------------------------------------
+static void showKeyboard() {
+    if (!keyboard) keyboard = new KeyboardWindow;
+}
+
+static void hideKeyboard() {
+    if (!keyboard) return;
+    keyboard->deleteLater();
+    keyboard = nullptr;
+}
+
 // ------------------------------------------------------------
 // main
 // ------------------------------------------------------------
+// X connection, swipe zone and bus verbs; shared by main() and wosp-host
+static bool startKeyboard() {
+    dpy = XOpenDisplay(nullptr);
+    if (!dpy) return false;
+
+    ActivationZone *zone = new ActivationZone;
+
+    WospCommands *commands = new WospCommands(zone);
+    commands->handle("keyboard.show", [](const QByteArray&) { showKeyboard(); });
+    commands->handle("keyboard.hide", [](const QByteArray&) { hideKeyboard(); });
+    commands->handle("keyboard.toggle", [](const QByteArray&) {
+        if (keyboard) hideKeyboard();
+        else showKeyboard();
+    });
+    return true;
+}
+
+#ifdef WOSP_HOST_ENTRY
+// Built as /usr/local/lib/wosp/host/wosp-keyboard.so and loaded by wosp-host
+extern "C" int wosp_host_main(int, char**)
+{
+    return startKeyboard() ? 0 : 1;
+}
+#else
 int main(int argc, char** argv) {
     QApplication app(argc, argv);
 
-    dpy = XOpenDisplay(nullptr);
-    if (!dpy) return 1;
+    if (!startKeyboard()) return 1;
 
-    ActivationZone zone;
     return app.exec();
 }
+#endif
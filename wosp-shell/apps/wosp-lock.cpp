@@ -36,6 +36,11 @@ Run:
 #include <pwd.h>
 #include <functional>
 
+#include "../lib/wosp-state.h"
+#include "../lib/wosp-config.h"
+#include "../lib/wosp-atlas.h"
+#include "../lib/wosp-timers.h"
+
 // ─────────────────────────────────────────────
 // Lock mode
 // ─────────────────────────────────────────────
@@ -181,14 +186,20 @@ public:
         mainLayout->addWidget(slideTextLabel);
 
         // Timers
-        QTimer *clockTimer = new QTimer(this);
-        connect(clockTimer, &QTimer::timeout, this, &LockscreenPage::updateClock);
-        clockTimer->start(1000);
+        WospTimers::Periodic::minute("lock-clock", this, [this]{ updateClock(); });
         updateClock();
 
-        QTimer *statusTimer = new QTimer(this);
-        connect(statusTimer, &QTimer::timeout, this, &LockscreenPage::updateStatus);
-        statusTimer->start(5000);
+        // wosp-stated pushes battery/net/radio changes; poll sysfs only
+        // while it is not running
+        statusTimer = new WospTimers::Periodic("lock-status", 5000, this,
+                                               [this]{ updateStatus(); });
+        sysState = new WospState::Client(this);
+        sysState->onChanged = [this](const WospState::Snapshot &) {
+            if (sysState->available()) statusTimer->stop();
+            else statusTimer->start();
+            updateStatus();
+        };
+        if (!sysState->available()) statusTimer->start();
         // PERF: do not call updateStatus() synchronously in ctor; deferred above.
 
         slideBackTimer = new QTimer(this);
@@ -253,13 +264,16 @@ protected:
             int cx = width()/2;
 
             if (sliderIconAvailable && !sliderIcon.isNull()) {
+                // Rescale only when the size changes, not on every slide frame
                 int desiredHeight = int((height() / 18.0) * scaleFactor);
-                QPixmap sliderScaled2 = sliderIcon.scaledToHeight(desiredHeight, Qt::SmoothTransformation);
+                if (sliderScaled.height() != desiredHeight)
+                    sliderScaled = QPixmap::fromImage(
+                        sliderIcon.scaledToHeight(desiredHeight, Qt::SmoothTransformation));
 
-                int x = cx - sliderScaled2.width() / 2;
-                int y = arrowY - sliderScaled2.height() / 2;
+                int x = cx - sliderScaled.width() / 2;
+                int y = arrowY - sliderScaled.height() / 2;
 
-                p.drawPixmap(x, y, sliderScaled2);
+                p.drawPixmap(x, y, sliderScaled);
             } else {
                 QFont f = font();
                 f.setPointSize(int(42 * scaleFactor));
@@ -341,9 +355,10 @@ private:
 
     QPixmap wallpaper;
     QPixmap wallpaperScaled; // PERF: cached scaled version
-    QPixmap wifiIcon;
-    QPixmap btIcon;
-    QPixmap sliderIcon;
+    QImage wifiIcon;            // views into the shared atlas
+    QImage btIcon;
+    QImage sliderIcon;
+    QPixmap sliderScaled;
     bool sliderIconAvailable = false;
 
     bool wifiActive;
@@ -355,6 +370,8 @@ private:
     bool slidingBack;
     QPoint lastPos;
     QTimer *slideBackTimer = nullptr;
+    WospTimers::Periodic *statusTimer = nullptr;
+    WospState::Client *sysState = nullptr;
 
     qreal scaleFactor = 1.0;
     std::function<void()> onUnlockRequested;
@@ -396,17 +413,12 @@ private:
 
     void loadIcons() {
         QString home = realHomePath();
-        QString dir = home + "/.config/wosp/images/";
-
-        QString wp = dir + "wifi.png";
-        if (QFile::exists(wp)) wifiIcon.load(wp);
+        WospAtlas::Atlas *atlas = WospAtlas::Atlas::open(home + "/.config/wosp/images");
 
-        QString bp = dir + "bt.png";
-        if (QFile::exists(bp)) btIcon.load(bp);
-
-        QString sp = dir + "slider.png";
-        sliderIconAvailable = QFile::exists(sp);
-        if (sliderIconAvailable) sliderIcon.load(sp);
+        wifiIcon = atlas->load("wifi.png");
+        btIcon = atlas->load("bt.png");
+        sliderIcon = atlas->load("slider.png");
+        sliderIconAvailable = !sliderIcon.isNull();
     }
 
     void adjustScaling() {
@@ -426,12 +438,12 @@ private:
         int iconH = QFontMetrics(f2).height();
 
         if (!wifiIcon.isNull())
-            wifiLabel->setPixmap(wifiIcon.scaledToHeight(iconH, Qt::SmoothTransformation));
+            wifiLabel->setPixmap(QPixmap::fromImage(wifiIcon.scaledToHeight(iconH, Qt::SmoothTransformation)));
         else
             wifiLabel->setText("WiFi");
 
         if (!btIcon.isNull())
-            btLabel->setPixmap(btIcon.scaledToHeight(iconH, Qt::SmoothTransformation));
+            btLabel->setPixmap(QPixmap::fromImage(btIcon.scaledToHeight(iconH, Qt::SmoothTransformation)));
         else
             btLabel->setText("BT");
 
@@ -450,9 +462,16 @@ private:
         // PERF: do not probe /sys for AUTH prompts (and this page shouldn't exist in AUTH anyway)
         if (g_lockMode == LockMode::AUTH) return;
 
-        wifiActive = detectWifiActive();
-        btActive   = detectBtActive();
-        batteryPercent = readBattery();
+        if (sysState && sysState->available()) {
+            WospState::Snapshot st = sysState->state();
+            wifiActive = st.wifiUp;
+            btActive   = st.btPresent && !st.btBlocked;
+            batteryPercent = st.batteryPct;
+        } else {
+            wifiActive = detectWifiActive();
+            btActive   = detectBtActive();
+            batteryPercent = readBattery();
+        }
 
         if (batteryPercent >= 0)
             batteryLabel->setText(QString("🔋%1%").arg(batteryPercent));
@@ -825,57 +844,37 @@ private:
 
     std::function<void()> onAuthenticated;
 
+    WospConfig::Store* lockStore() const {
+        return WospConfig::Store::open(realHomePath() + "/.config/wosp/.osm_lockdata");
+    }
+
     void loadConfig() {
-        QString home = realHomePath();
-        QString cfg = home + "/.config/wosp/.osm_lockdata";
-        QFile file(cfg);
-        if (!file.exists()) {
+        WospConfig::Store *cfg = lockStore();
+        if (cfg->isEmpty()) {
             firstRun = true;
             enhancedSecurity = false;
             return;
         }
 
-        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream in(&file);
-            while (!in.atEnd()) {
-                QString line = in.readLine();
-                if (line.startsWith("pattern=")) {
-                    QStringList list = line.mid(8).split(",");
-                    patternHash = QVector<QString>::fromList(list);
-                } else if (line.startsWith("password=")) {
-                    passwordHash = line.mid(9);
-                } else if (line.startsWith("enhanced=")) {
-                    enhancedSecurity = (line.mid(9).trimmed() == "1");
-                }
-            }
-            file.close();
-            firstRun = false;
-        }
+        QString pattern = cfg->value("pattern");
+        if (!pattern.isEmpty())
+            patternHash = QVector<QString>::fromList(pattern.split(","));
+        passwordHash = cfg->value("password");
+        enhancedSecurity = cfg->boolValue("enhanced");
+        firstRun = false;
     }
 
+    // Credentials: start the write now rather than after the debounce
     void saveConfig() {
-        QString home = realHomePath();
-        QString path = home + "/.config/wosp/.osm_lockdata";
-        QFile f(path);
-        if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&f);
-            QStringList plist = QStringList::fromVector(patternHash);
-            out << "pattern=" << plist.join(",") << "\n";
-            out << "password=" << passwordHash << "\n";
-            out << "enhanced=" << (enhancedSecurity ? "1" : "0") << "\n";
-            f.close();
-        }
+        WospConfig::Store *cfg = lockStore();
+        cfg->setValue("pattern", QStringList::fromVector(patternHash).join(","));
+        cfg->setValue("password", passwordHash);
+        cfg->setValue("enhanced", enhancedSecurity ? "1" : "0");
+        cfg->flush();
     }
 
     void saveConfigEnhancedOnly() {
-        QString home = realHomePath();
-        QString path = home + "/.config/wosp/.osm_lockdata";
-        QFile f(path);
-        if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&f);
-            out << "enhanced=" << (enhancedSecurity ? "1" : "0") << "\n";
-            f.close();
-        }
+        lockStore()->setValue("enhanced", enhancedSecurity ? "1" : "0");
     }
 
     void updateSecurityToggleStyle() {
@@ -1231,6 +1230,10 @@ int main(int argc, char *argv[]) {
         else if (arg == "--auth") g_lockMode = LockMode::AUTH;
     }
 
+    // Tells the rest of the shell to stop polling until we exit
+    if (g_lockMode != LockMode::AUTH)
+        WospTimers::Scheduler::instance()->holdLock();
+
     WospLock w;
     w.show();
     w.raise();
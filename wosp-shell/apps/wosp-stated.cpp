@@ -0,0 +1,577 @@
+// wosp-stated — one reader of system state for every wosp UI
+//
+// wosp-lock, osm-settings and quick settings used to poll the same sysfs
+// files (power_supply, net, rfkill, backlight) on their own timers. This
+// daemon reads them once and publishes a WospState::Snapshot in shared
+// memory (see lib/wosp-state.h), then only re-reads a subsystem when the
+// kernel says it changed:
+//
+//   kernel uevents (NETLINK_KOBJECT_UEVENT)  power_supply, backlight,
+//                                            rfkill, bluetooth, net
+//   rtnetlink (RTMGRP_LINK)                  link up/down, carrier
+//   X11 DPMS (DPMSInfoNotify, 1.2 servers)   display standby/off
+//   client sockets                           wosp-lock holding the lock
+//
+// Events are coalesced for SETTLE_MS before re-reading. A snapshot is only
+// published, and clients on $XDG_RUNTIME_DIR/wosp-stated.sock are only
+// poked, when the values differ from the last one. Some battery gauges
+// never send change uevents, so the battery alone is re-read every
+// BATTERY_POLL_MS as a fallback; that still wakes no client unless the
+// numbers moved. Older X servers cannot send DPMS events, so there the
+// DPMS level is polled every DPMS_POLL_MS instead; without $DISPLAY the
+// display is taken to be always on.
+//
+// Runs as the session user; nothing here needs privileges.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "../lib/wosp-state.h"
+
+#include <X11/Xlib.h>
+#include <X11/Xlibint.h>
+#include <X11/extensions/dpms.h>
+#include <X11/extensions/dpmsproto.h>
+#undef min
+#undef max
+
+static const int SETTLE_MS = 50;
+static const int BATTERY_POLL_MS = 60000;
+static const int DPMS_POLL_MS = 5000;
+static const int MAX_EVENTS = 16;
+
+enum Dirty : unsigned {
+    DirtyPower     = 1u << 0,
+    DirtyNet       = 1u << 1,
+    DirtyRfkill    = 1u << 2,
+    DirtyBacklight = 1u << 3,
+    DirtyBluetooth = 1u << 4,
+    DirtyDisplay   = 1u << 5,
+    DirtyLock      = 1u << 6,
+};
+
+// ───────────────────────── sysfs ─────────────────────────
+
+static std::string readLine(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::string();
+    char buf[128];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) return std::string();
+    buf[n] = '\0';
+    std::string s(buf);
+    while (!s.empty() && (s.back() == '\n' || s.back() == ' ')) s.pop_back();
+    return s;
+}
+
+static long long readNum(const std::string &path, long long fallback = -1) {
+    std::string s = readLine(path);
+    if (s.empty()) return fallback;
+    char *end = nullptr;
+    long long v = strtoll(s.c_str(), &end, 10);
+    return (end && *end == '\0') ? v : fallback;
+}
+
+static std::vector<std::string> listDir(const std::string &dir) {
+    std::vector<std::string> out;
+    DIR *d = opendir(dir.c_str());
+    if (!d) return out;
+    while (dirent *e = readdir(d)) {
+        if (e->d_name[0] != '.') out.push_back(e->d_name);
+    }
+    closedir(d);
+    return out;
+}
+
+static bool exists(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+static void copyName(char (&dst)[16], const std::string &src) {
+    std::memset(dst, 0, sizeof(dst));
+    std::strncpy(dst, src.c_str(), sizeof(dst) - 1);
+}
+
+static void readPower(WospState::Snapshot &s) {
+    s.batteryPct = -1;
+    s.batteryStatus = WospState::Unknown;
+    s.powerMw = -1;
+    s.minutesLeft = -1;
+    s.onAc = 0;
+
+    const std::string base = "/sys/class/power_supply/";
+    bool haveBattery = false;
+    for (const std::string &n : listDir(base)) {
+        std::string dir = base + n;
+        std::string type = readLine(dir + "/type");
+
+        if (type == "Mains" || type == "USB") {
+            if (readNum(dir + "/online", 0) > 0) s.onAc = 1;
+            continue;
+        }
+        if (type != "Battery" || haveBattery) continue;
+        if (readLine(dir + "/scope") == "Device") continue;   // mice, pens
+        haveBattery = true;
+
+        s.batteryPct = int32_t(readNum(dir + "/capacity"));
+
+        std::string st = readLine(dir + "/status");
+        if (st == "Charging") s.batteryStatus = WospState::Charging;
+        else if (st == "Discharging") s.batteryStatus = WospState::Discharging;
+        else if (st == "Full") s.batteryStatus = WospState::Full;
+        else if (st == "Not charging") s.batteryStatus = WospState::NotCharging;
+
+        // µW / µWh, or µA / µAh with µV; NONE where the gauge lacks a file
+        const long long NONE = LLONG_MIN;
+        long long power = readNum(dir + "/power_now", NONE);
+        long long energy = readNum(dir + "/energy_now", NONE);
+        long long full = readNum(dir + "/energy_full", NONE);
+        if (power == NONE) {
+            long long cur = readNum(dir + "/current_now", NONE);
+            long long volt = readNum(dir + "/voltage_now", NONE);
+            if (cur != NONE && volt > 0) power = cur * volt / 1000000;
+            long long charge = readNum(dir + "/charge_now", NONE);
+            long long chargeFull = readNum(dir + "/charge_full", NONE);
+            if (charge != NONE && volt > 0) energy = charge * volt / 1000000;
+            if (chargeFull != NONE && volt > 0) full = chargeFull * volt / 1000000;
+        }
+        if (power != NONE) {
+            if (power < 0) power = -power;   // some gauges report discharge as negative
+            s.powerMw = int32_t(power / 1000);
+        }
+
+        if (power > 0) {
+            if (s.batteryStatus == WospState::Discharging && energy > 0)
+                s.minutesLeft = int32_t(energy * 60 / power);
+            else if (s.batteryStatus == WospState::Charging && energy > 0 && full > energy)
+                s.minutesLeft = int32_t((full - energy) * 60 / power);
+        }
+    }
+}
+
+static void readNet(WospState::Snapshot &s) {
+    s.wifiUp = s.ethUp = 0;
+    copyName(s.wifiIface, "");
+    copyName(s.ethIface, "");
+
+    const std::string base = "/sys/class/net/";
+    for (const std::string &n : listDir(base)) {
+        std::string dir = base + n;
+        if (!exists(dir + "/device")) continue;   // lo, bridges, tunnels
+        bool up = readLine(dir + "/operstate") == "up";
+
+        if (exists(dir + "/wireless") || exists(dir + "/phy80211")) {
+            if (!s.wifiIface[0] || (up && !s.wifiUp)) {
+                copyName(s.wifiIface, n);
+                s.wifiUp = up;
+            }
+        } else if (readNum(dir + "/type") == 1) {   // ARPHRD_ETHER
+            if (!s.ethIface[0] || (up && !s.ethUp)) {
+                copyName(s.ethIface, n);
+                s.ethUp = up;
+            }
+        }
+    }
+}
+
+static void readRfkill(WospState::Snapshot &s) {
+    s.wifiBlocked = s.btBlocked = s.wwanBlocked = 0;
+
+    const std::string base = "/sys/class/rfkill/";
+    for (const std::string &n : listDir(base)) {
+        std::string dir = base + n;
+        std::string type = readLine(dir + "/type");
+        bool blocked = readNum(dir + "/soft", 0) > 0 || readNum(dir + "/hard", 0) > 0;
+        if (!blocked) continue;
+        if (type == "wlan") s.wifiBlocked = 1;
+        else if (type == "bluetooth") s.btBlocked = 1;
+        else if (type == "wwan") s.wwanBlocked = 1;
+    }
+}
+
+static void readBacklight(WospState::Snapshot &s) {
+    s.backlightPct = -1;
+
+    const std::string base = "/sys/class/backlight/";
+    for (const std::string &n : listDir(base)) {
+        long long max = readNum(base + n + "/max_brightness");
+        long long cur = readNum(base + n + "/brightness");
+        if (max <= 0 || cur < 0) continue;
+        s.backlightPct = int32_t((cur * 100 + max / 2) / max);
+        break;
+    }
+}
+
+static void readBluetooth(WospState::Snapshot &s) {
+    s.btPresent = listDir("/sys/class/bluetooth").empty() ? 0 : 1;
+}
+
+// ───────────────────────── netlink ─────────────────────────
+
+static int openUevents() {
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) return -1;
+    sockaddr_nl nl{};
+    nl.nl_family = AF_NETLINK;
+    nl.nl_groups = 1;   // kernel broadcast group
+    if (bind(fd, reinterpret_cast<sockaddr*>(&nl), sizeof(nl)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int openRtnetlink() {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (fd < 0) return -1;
+    sockaddr_nl nl{};
+    nl.nl_family = AF_NETLINK;
+    nl.nl_groups = RTMGRP_LINK;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&nl), sizeof(nl)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// uevent datagram: "action@devpath\0KEY=VALUE\0..."
+static unsigned drainUevents(int fd) {
+    unsigned dirty = 0;
+    char buf[8192];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf) - 1, 0)) > 0) {
+        buf[n] = '\0';
+        for (char *p = buf; p < buf + n; p += strlen(p) + 1) {
+            if (strncmp(p, "SUBSYSTEM=", 10) != 0) continue;
+            const char *sub = p + 10;
+            if (!strcmp(sub, "power_supply")) dirty |= DirtyPower;
+            else if (!strcmp(sub, "net")) dirty |= DirtyNet;
+            else if (!strcmp(sub, "rfkill")) dirty |= DirtyRfkill | DirtyBluetooth;
+            else if (!strcmp(sub, "backlight")) dirty |= DirtyBacklight;
+            else if (!strcmp(sub, "bluetooth")) dirty |= DirtyBluetooth;
+            break;
+        }
+    }
+    return dirty;
+}
+
+static unsigned drainRtnetlink(int fd) {
+    char buf[8192];
+    bool any = false;
+    while (recv(fd, buf, sizeof(buf), 0) > 0) any = true;
+    return any ? unsigned(DirtyNet) : 0u;
+}
+
+// ───────────────────────── display ─────────────────────────
+
+struct Dpms {
+    Display *dpy = nullptr;
+    int opcode = 0;
+    bool events = false;        // server sends DPMSInfoNotify
+};
+
+// DPMSSelectInput is only in libXext >= 1.3.5; the request is one word
+static void selectDpmsInput(Display *dpy, int opcode) {
+    xDPMSSelectInputReq *req;
+    LockDisplay(dpy);
+    GetReq(DPMSSelectInput, req);
+    req->reqType = opcode;
+    req->dpmsReqType = X_DPMSSelectInput;
+    req->eventMask = DPMSInfoNotifyMask;
+    UnlockDisplay(dpy);
+    SyncHandle();
+    XFlush(dpy);
+}
+
+static void openDpms(Dpms &d) {
+    const char *display = getenv("DISPLAY");
+    if (!display || !*display) return;
+    d.dpy = XOpenDisplay(nullptr);
+    if (!d.dpy) {
+        std::cerr << "wosp-stated: cannot open display " << display << "\n";
+        return;
+    }
+    int event, error;
+    if (!XQueryExtension(d.dpy, "DPMS", &d.opcode, &event, &error)) {
+        XCloseDisplay(d.dpy);
+        d.dpy = nullptr;
+        return;
+    }
+    int major = 0, minor = 0;
+    DPMSGetVersion(d.dpy, &major, &minor);
+    if (major > 1 || (major == 1 && minor >= 2)) {
+        selectDpmsInput(d.dpy, d.opcode);
+        d.events = true;
+    }
+}
+
+static void readDisplay(Dpms &d, WospState::Snapshot &s) {
+    s.displayOff = 0;
+    if (!d.dpy) return;
+    CARD16 level = DPMSModeOn;
+    BOOL enabled = False;
+    if (DPMSInfo(d.dpy, &level, &enabled) && enabled && level != DPMSModeOn)
+        s.displayOff = 1;
+}
+
+// Events may already sit in Xlib's queue after a reply, so drain that too
+static unsigned drainDisplay(Display *dpy) {
+    bool any = false;
+    while (XPending(dpy)) {
+        XEvent ev;
+        XNextEvent(dpy, &ev);
+        any = true;
+    }
+    return any ? unsigned(DirtyDisplay) : 0u;
+}
+
+// ───────────────────────── clients ─────────────────────────
+
+struct Peer {
+    int fd;
+    bool locking;               // sent LOCK_HELD last
+};
+
+static bool anyLocking(const std::vector<Peer> &peers) {
+    for (const Peer &p : peers)
+        if (p.locking) return true;
+    return false;
+}
+
+// Lock messages from a client; false once it hung up
+static bool readPeer(Peer &p) {
+    char buf[64];
+    ssize_t n;
+    while ((n = recv(p.fd, buf, sizeof(buf), 0)) > 0) {
+        for (ssize_t i = 0; i < n; ++i) {
+            if (buf[i] == WospState::LOCK_HELD) p.locking = true;
+            else if (buf[i] == WospState::LOCK_RELEASED) p.locking = false;
+        }
+    }
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+}
+
+static int openListener(const std::string &path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "wosp-stated: socket path too long\n";
+        return -1;
+    }
+    strcpy(addr.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+
+    // qtile re-runs autostart on every config reload
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+        std::cerr << "wosp-stated: already running\n";
+        exit(0);
+    }
+    close(fd);
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+
+    unlink(path.c_str());
+    mode_t old = umask(077);
+    int r = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    umask(old);
+    if (r != 0 || listen(fd, 16) != 0) {
+        perror("wosp-stated: bind");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// A full socket buffer just means the client has wakeups pending already
+static void pokeClients(std::vector<Peer> &peers) {
+    char b = 1;
+    for (size_t i = 0; i < peers.size();) {
+        if (send(peers[i].fd, &b, 1, MSG_NOSIGNAL | MSG_DONTWAIT) < 0 &&
+            errno != EAGAIN && errno != EWOULDBLOCK) {
+            close(peers[i].fd);
+            peers.erase(peers.begin() + i);
+            continue;
+        }
+        ++i;
+    }
+}
+
+static void watch(int ep, int fd) {
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static void armTimer(int tfd, int ms, bool periodic) {
+    itimerspec its{};
+    its.it_value.tv_sec = ms / 1000;
+    its.it_value.tv_nsec = (ms % 1000) * 1000000L;
+    if (periodic) its.it_interval = its.it_value;
+    timerfd_settime(tfd, 0, &its, nullptr);
+}
+
+int main() {
+    signal(SIGPIPE, SIG_IGN);
+
+    std::string sockPath = WospState::socketPath();
+    int listenFd = openListener(sockPath);
+    if (listenFd < 0) return 1;
+
+    std::string name = WospState::shmName();
+    int shm = shm_open(name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (shm < 0 || ftruncate(shm, sizeof(WospState::Segment)) != 0) {
+        perror("wosp-stated: shm");
+        return 1;
+    }
+    void *mem = mmap(nullptr, sizeof(WospState::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0);
+    close(shm);
+    if (mem == MAP_FAILED) {
+        perror("wosp-stated: mmap");
+        return 1;
+    }
+    auto *seg = static_cast<WospState::Segment*>(mem);
+    std::memset(mem, 0, sizeof(WospState::Segment));
+
+    int uevents = openUevents();
+    int rtnl = openRtnetlink();
+    if (uevents < 0) perror("wosp-stated: uevent socket");
+    if (rtnl < 0) perror("wosp-stated: rtnetlink socket");
+
+    Dpms dpms;
+    openDpms(dpms);
+    int xfd = dpms.dpy ? ConnectionNumber(dpms.dpy) : -1;
+
+    int settle = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    int batteryTick = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    armTimer(batteryTick, BATTERY_POLL_MS, true);
+    int dpmsTick = -1;
+    if (dpms.dpy && !dpms.events) {
+        dpmsTick = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        armTimer(dpmsTick, DPMS_POLL_MS, true);
+    }
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    for (int fd : {listenFd, uevents, rtnl, settle, batteryTick, xfd, dpmsTick}) {
+        if (fd >= 0) watch(ep, fd);
+    }
+
+    WospState::Snapshot cur;
+    readPower(cur);
+    readNet(cur);
+    readRfkill(cur);
+    readBacklight(cur);
+    readBluetooth(cur);
+    readDisplay(dpms, cur);
+    if (dpms.dpy) drainDisplay(dpms.dpy);
+
+    // Header last: readers reject the segment until it is complete
+    WospState::publish(seg, cur);
+    seg->version = WospState::VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    seg->magic = WospState::MAGIC;
+
+    std::cerr << "wosp-stated: publishing " << name << " on " << sockPath << "\n";
+
+    std::vector<Peer> peers;
+    unsigned dirty = 0;
+    epoll_event events[MAX_EVENTS];
+
+    for (;;) {
+        int n = epoll_wait(ep, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno != EINTR) perror("wosp-stated: epoll_wait");
+            continue;
+        }
+
+        unsigned fresh = 0;
+        bool refresh = false;
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            uint64_t ticks;
+
+            if (fd == listenFd) {
+                int c;
+                while ((c = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+                    peers.push_back(Peer{c, false});
+                    watch(ep, c);
+                }
+            } else if (fd == uevents) {
+                fresh |= drainUevents(uevents);
+            } else if (fd == rtnl) {
+                fresh |= drainRtnetlink(rtnl);
+            } else if (fd == batteryTick) {
+                while (read(batteryTick, &ticks, sizeof(ticks)) > 0) {}
+                dirty |= DirtyPower;
+                refresh = true;
+            } else if (fd == settle) {
+                while (read(settle, &ticks, sizeof(ticks)) > 0) {}
+                refresh = true;
+            } else if (fd == xfd) {
+                fresh |= drainDisplay(dpms.dpy);
+            } else if (fd == dpmsTick) {
+                while (read(dpmsTick, &ticks, sizeof(ticks)) > 0) {}
+                fresh |= DirtyDisplay;
+            } else {
+                for (size_t k = 0; k < peers.size(); ++k) {
+                    if (peers[k].fd != fd) continue;
+                    if (!readPeer(peers[k])) {
+                        close(fd);
+                        peers.erase(peers.begin() + k);
+                    }
+                    break;
+                }
+            }
+        }
+        if (anyLocking(peers) != bool(cur.locked)) fresh |= DirtyLock;
+
+        // Start the settle window on the first event of a burst
+        if (fresh) {
+            if (!dirty) armTimer(settle, SETTLE_MS, false);
+            dirty |= fresh;
+        }
+        if (!refresh || !dirty) continue;
+
+        WospState::Snapshot next = cur;
+        if (dirty & DirtyPower) readPower(next);
+        if (dirty & DirtyNet) readNet(next);
+        if (dirty & DirtyRfkill) readRfkill(next);
+        if (dirty & DirtyBacklight) readBacklight(next);
+        if (dirty & DirtyBluetooth) readBluetooth(next);
+        if (dirty & DirtyDisplay) readDisplay(dpms, next);
+        if (dirty & DirtyLock) next.locked = anyLocking(peers);
+        dirty = 0;
+        if (dpms.dpy) drainDisplay(dpms.dpy);
+
+        if (next == cur) continue;
+        cur = next;
+        WospState::publish(seg, cur);
+        pokeClients(peers);
+
+        // A lock holder that died mid-poke still has to release the lock
+        if (anyLocking(peers) != bool(cur.locked)) {
+            dirty |= DirtyLock;
+            armTimer(settle, SETTLE_MS, false);
+        }
+    }
+}
@@ -35,6 +35,8 @@ from qtile_extras.popup import PopupGridLayout, PopupWidget, PopupImage, PopupTe
 from datetime import datetime
 import threading
 import time
+import socket
+import struct
 from libqtile.config import Match
 
 
@@ -43,6 +45,39 @@ terminal = guess_terminal()
 bg = '28282899'
 # @lazy.function
 
+##############
+## wosp-bus ##
+##############
+
+# Same framing as lib/wosp-bus.h: u8 type, u8 verb_len, u16 payload_len,
+# u32 value, then verb and payload. Returns the number of handlers reached.
+def bus_send(verb, payload=b''):
+    rt = os.environ.get('XDG_RUNTIME_DIR') or '/run/user/%d' % os.getuid()
+    v = verb.encode()
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+            s.settimeout(0.5)
+            s.connect(os.path.join(rt, 'wosp-bus.sock'))
+            s.sendall(struct.pack('=BBHI', 2, len(v), len(payload), 1) + v + payload)
+            head = b''
+            while len(head) < 8:
+                chunk = s.recv(8 - len(head))
+                if not chunk:
+                    return 0
+                head += chunk
+            kind, _, _, count = struct.unpack('=BBHI', head)
+            return count if kind == 4 else 0
+    except OSError:
+        return 0
+
+# Send verb over wosp-bus; spawn the old command if nobody handled it
+def bus_or_spawn(verb, fallback):
+    @lazy.function
+    def run(qtile):
+        if bus_send(verb) == 0:
+            qtile.spawn(fallback)
+    return run
+
 ###############
 ## AutoStart ##
 ###############
@@ -54,11 +89,18 @@ bg = '28282899'
 @hook.subscribe.startup
 def autostart():
     # Autostart Programs
+    subprocess.Popen(['osm-zygote'])
+    subprocess.Popen(['wosp-bus'])
+    subprocess.Popen(['wosp-stated'])
     subprocess.Popen(['wosp-lock'])
-    subprocess.Popen(['wosp-shell'])
+    # WOSP_SINGLE_PROCESS=1: shell, status and running share one wosp-host
+    if os.environ.get('WOSP_SINGLE_PROCESS') == '1':
+        subprocess.Popen(['wosp-host'])
+    else:
+        subprocess.Popen(['wosp-shell'])
+        subprocess.Popen(['osm-status'])
+        subprocess.Popen(['osm-running'])
     subprocess.Popen(['osm-paper-restore'])
-    subprocess.Popen(['osm-status'])
-    subprocess.Popen(['osm-running'])
 #    subprocess.Popen(['onboard'])
     subprocess.Popen(['picom', '-b'])
 #     subprocess.Popen(['osm-powerd'])
@@ -131,10 +173,10 @@ keys = [
     # at https://docs.qtile.org/en/latest/manual/config/lazy.html
     # Switch between windows
     Key([mod], "g", lazy.function(show_graphs)),
-    Key([mod], "p", lazy.spawn("osm-power")),
+    Key([mod], "p", bus_or_spawn("power.menu", "osm-launch osm-power")),
     Key([mod], "a", lazy.spawn("osm-launcher")),
     Key([mod], "l", lazy.spawn("osm-lockd")),
-    Key([mod], "n", lazy.spawn("osm-rocker")),
+    Key([mod], "n", lazy.spawn("osm-launch osm-rocker")),
     Key([mod], "Return", lazy.spawn(terminal), desc="Launch terminal"),
     Key([mod], "Tab", lazy.next_layout(), desc="Toggle between layouts"),
     Key([mod], "w", lazy.window.kill(), desc="Kill focused window"),
@@ -271,7 +313,7 @@ screens = [
         top=bar.Bar([
             widget.Spacer(length=55),
             # widget.Image(filename='~/.config/qtile/images/terminal.png', margin=2.5, mouse_callbacks={'Button1': lazy.spawn(terminal)}),
-           # widget.Image(filename='~/.config/qtile/images/keyboard.png', margin=6, mouse_callbacks={'Button1': lazy.spawn("pkill -USR1 -x wosp-keyboard")}),
+           # widget.Image(filename='~/.config/qtile/images/keyboard.png', margin=6, mouse_callbacks={'Button1': bus_or_spawn("keyboard.toggle", "onboard")}),
             widget.Image(filename='~/.config/qtile/images/keyboard.png', margin=6, mouse_callbacks={'Button1': lazy.spawn("onboard")}),
             widget.Systray(),
             widget.Spacer(length=55),
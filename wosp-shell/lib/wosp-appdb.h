@@ -0,0 +1,407 @@
+// wosp-appdb.h
+// Shared desktop-entry index for wosp-shell and the osm-* apps.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Parsed .desktop entries live in ~/.cache/wosp-shell/apps.db, a flat
+// binary file validated against the mtimes of every scanned directory.
+// A valid index is read with one mmap and no per-file parsing; a stale
+// or missing one is rebuilt from the directories and rewritten.
+// WospAppDb::Watcher keeps the index current through inotify while a
+// long-running process (the shell) is up.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QSet>
+#include <QHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace WospAppDb {
+
+/* ───────────────────────── Types ───────────────────────── */
+
+struct Entry {
+    QString path;           // absolute .desktop path
+    QString name;
+    QString exec;           // raw Exec= line, field codes kept
+    QString icon;
+    QStringList mimeTypes;
+    bool noDisplay = false; // NoDisplay=true or Hidden=true
+};
+
+struct DirStamp {
+    QByteArray path;
+    qint64 mtimeNs;         // -1 when the directory does not exist
+};
+
+static const char     MAGIC[8] = {'W','A','P','P','D','B','0','1'};
+static const quint32  VERSION  = 1;
+
+/* ───────────────────────── Paths ───────────────────────── */
+
+inline QStringList appDirs() {
+    return {
+        QDir::homePath() + "/.local/share/applications",
+        "/usr/share/applications"
+    };
+}
+
+inline QString indexPath() {
+    return QStandardPaths::writableLocation(
+        QStandardPaths::GenericCacheLocation
+    ) + "/wosp-shell/apps.db";
+}
+
+inline qint64 mtimeNs(const QByteArray &path) {
+    struct stat st;
+    if (::stat(path.constData(), &st) != 0) return -1;
+    return qint64(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+}
+
+// Every application directory plus all of its subdirectories.
+inline QVector<DirStamp> collectDirs() {
+    QVector<DirStamp> out;
+    for (const QString &d : appDirs()) {
+        QByteArray top = QFile::encodeName(d);
+        out.append({top, mtimeNs(top)});
+        if (!QDir(d).exists()) continue;
+
+        QDirIterator it(d, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QByteArray p = QFile::encodeName(it.next());
+            out.append({p, mtimeNs(p)});
+        }
+    }
+    return out;
+}
+
+/* ───────────────────────── .desktop parsing ───────────────────────── */
+
+inline QString unescapeValue(const QString &v) {
+    if (!v.contains('\\')) return v;
+    QString out;
+    out.reserve(v.size());
+    for (int i = 0; i < v.size(); ++i) {
+        QChar c = v[i];
+        if (c == '\\' && i + 1 < v.size()) {
+            QChar n = v[++i];
+            if (n == 's') out += ' ';
+            else if (n == 'n') out += '\n';
+            else if (n == 't') out += '\t';
+            else if (n == 'r') out += '\r';
+            else out += n;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Reads only the [Desktop Entry] group; unlocalized keys only.
+inline bool parseDesktopFile(const QString &path, Entry &e) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    bool inGroup = false;
+    bool seenGroup = false;
+    e = Entry();
+    e.path = path;
+
+    while (!f.atEnd()) {
+        QString line = QString::fromUtf8(f.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        if (line.startsWith('[')) {
+            if (inGroup) break;
+            inGroup = (line == "[Desktop Entry]");
+            seenGroup |= inGroup;
+            continue;
+        }
+        if (!inGroup) continue;
+
+        int eq = line.indexOf('=');
+        if (eq <= 0) continue;
+        QString key = line.left(eq).trimmed();
+        QString val = unescapeValue(line.mid(eq + 1).trimmed());
+
+        if (key == "Name") e.name = val;
+        else if (key == "Exec") e.exec = val;
+        else if (key == "Icon") e.icon = val;
+        else if (key == "NoDisplay" || key == "Hidden") e.noDisplay |= (val == "true");
+        else if (key == "MimeType") e.mimeTypes = val.split(';', Qt::SkipEmptyParts);
+    }
+    return seenGroup;
+}
+
+inline void scanDir(const QString &dir, QVector<Entry> &out) {
+    QDirIterator it(dir, {"*.desktop"}, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        Entry e;
+        if (parseDesktopFile(it.next(), e)) out.append(e);
+    }
+}
+
+inline QVector<Entry> scanAll() {
+    QVector<Entry> out;
+    for (const QString &d : appDirs()) scanDir(d, out);
+    return out;
+}
+
+/* ───────────────────────── Index file ─────────────────────────
+   header : magic[8] u32 version u32 dirCount u32 entryCount
+   dir    : i64 mtimeNs str path
+   entry  : u32 flags str path str name str exec str icon str mime(;)
+   str    : u32 byteLen + UTF-8 bytes
+   All integers native-endian; the index never leaves the device.   */
+
+inline void putU32(QByteArray &b, quint32 v) { b.append(reinterpret_cast<const char*>(&v), 4); }
+inline void putI64(QByteArray &b, qint64 v)  { b.append(reinterpret_cast<const char*>(&v), 8); }
+inline void putStr(QByteArray &b, const QByteArray &s) { putU32(b, quint32(s.size())); b.append(s); }
+inline void putStr(QByteArray &b, const QString &s) { putStr(b, s.toUtf8()); }
+
+inline bool writeIndex(const QVector<Entry> &entries, const QVector<DirStamp> &dirs) {
+    QByteArray b;
+    b.reserve(64 + entries.size() * 160);
+    b.append(MAGIC, 8);
+    putU32(b, VERSION);
+    putU32(b, quint32(dirs.size()));
+    putU32(b, quint32(entries.size()));
+
+    for (const DirStamp &d : dirs) {
+        putI64(b, d.mtimeNs);
+        putStr(b, d.path);
+    }
+    for (const Entry &e : entries) {
+        putU32(b, e.noDisplay ? 1u : 0u);
+        putStr(b, e.path);
+        putStr(b, e.name);
+        putStr(b, e.exec);
+        putStr(b, e.icon);
+        putStr(b, e.mimeTypes.join(';'));
+    }
+
+    QString path = indexPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(b);
+    return f.commit();
+}
+
+struct Cursor {
+    const char *p;
+    const char *end;
+    bool ok = true;
+
+    quint32 u32() {
+        quint32 v = 0;
+        if (end - p < 4) { ok = false; return 0; }
+        std::memcpy(&v, p, 4); p += 4;
+        return v;
+    }
+    qint64 i64() {
+        qint64 v = 0;
+        if (end - p < 8) { ok = false; return 0; }
+        std::memcpy(&v, p, 8); p += 8;
+        return v;
+    }
+    const char* raw(quint32 &len) {
+        len = u32();
+        if (!ok || quint64(end - p) < len) { ok = false; len = 0; return p; }
+        const char *s = p; p += len;
+        return s;
+    }
+    QString str() {
+        quint32 len;
+        const char *s = raw(len);
+        return QString::fromUtf8(s, int(len));
+    }
+};
+
+// Returns false if the index is missing, corrupt or stale.
+inline bool readIndex(QVector<Entry> &out) {
+    QByteArray path = QFile::encodeName(indexPath());
+    int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < 20) { ::close(fd); return false; }
+
+    size_t size = size_t(st.st_size);
+    void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const char *base = static_cast<const char*>(map);
+    Cursor c{base + 8, base + size};
+    bool valid = std::memcmp(base, MAGIC, 8) == 0 && c.u32() == VERSION;
+
+    quint32 dirCount = valid ? c.u32() : 0;
+    quint32 entryCount = valid ? c.u32() : 0;
+
+    for (quint32 i = 0; valid && i < dirCount; ++i) {
+        qint64 stamp = c.i64();
+        quint32 len;
+        const char *s = c.raw(len);
+        valid = c.ok && mtimeNs(QByteArray(s, int(len))) == stamp;
+    }
+
+    if (valid) {
+        out.clear();
+        out.reserve(int(entryCount));
+        for (quint32 i = 0; c.ok && i < entryCount; ++i) {
+            Entry e;
+            e.noDisplay = c.u32() & 1u;
+            e.path = c.str();
+            e.name = c.str();
+            e.exec = c.str();
+            e.icon = c.str();
+            e.mimeTypes = c.str().split(';', Qt::SkipEmptyParts);
+            out.append(e);
+        }
+        valid = c.ok;
+    }
+
+    ::munmap(map, size);
+    return valid;
+}
+
+/* ───────────────────────── Public API ───────────────────────── */
+
+// Index if valid, otherwise a fresh scan that is written back.
+inline QVector<Entry> load() {
+    QVector<Entry> out;
+    if (readIndex(out)) return out;
+
+    // Stamp before scanning so a change mid-scan invalidates next time.
+    QVector<DirStamp> dirs = collectDirs();
+    out = scanAll();
+    writeIndex(out, dirs);
+    return out;
+}
+
+/* ───────────────────────── Watcher ───────────────────────── */
+
+class Watcher : public QObject {
+public:
+    std::function<void(const QVector<Entry>&)> onChanged;
+
+    explicit Watcher(const QVector<Entry> &initial, QObject *parent = nullptr)
+        : QObject(parent), m_entries(initial)
+    {
+        m_flush.setSingleShot(true);
+        m_flush.setInterval(300);
+        QObject::connect(&m_flush, &QTimer::timeout, this, [this]{ flush(); });
+
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd < 0) return;
+
+        for (const QString &d : appDirs()) addWatchTree(d);
+
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        QObject::connect(m_notifier, &QSocketNotifier::activated, this, [this]{ readEvents(); });
+    }
+
+    ~Watcher() override {
+        if (m_fd >= 0) ::close(m_fd);
+    }
+
+    const QVector<Entry>& entries() const { return m_entries; }
+
+private:
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QHash<int, QString> m_wdDirs;
+    QSet<QString> m_dirtyFiles;
+    QSet<QString> m_dirtyDirs;
+    bool m_fullRescan = false;
+    QTimer m_flush;
+    QVector<Entry> m_entries;
+
+    void addWatch(const QString &dir) {
+        int wd = inotify_add_watch(m_fd, QFile::encodeName(dir).constData(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ONLYDIR);
+        if (wd >= 0) m_wdDirs.insert(wd, dir);
+    }
+
+    void addWatchTree(const QString &dir) {
+        if (!QDir(dir).exists()) return;
+        addWatch(dir);
+        QDirIterator it(dir, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) addWatch(it.next());
+    }
+
+    void readEvents() {
+        alignas(struct inotify_event) char buf[4096];
+        for (;;) {
+            ssize_t n = ::read(m_fd, buf, sizeof(buf));
+            if (n <= 0) break;
+
+            for (char *p = buf; p < buf + n; ) {
+                auto *ev = reinterpret_cast<struct inotify_event*>(p);
+                p += sizeof(struct inotify_event) + ev->len;
+
+                if (ev->mask & IN_Q_OVERFLOW) { m_fullRescan = true; continue; }
+                if (ev->mask & IN_IGNORED) { m_wdDirs.remove(ev->wd); continue; }
+                if (!ev->len || !m_wdDirs.contains(ev->wd)) continue;
+
+                QString full = m_wdDirs.value(ev->wd) + "/" + QFile::decodeName(ev->name);
+
+                if (ev->mask & IN_ISDIR) {
+                    if (ev->mask & (IN_CREATE | IN_MOVED_TO)) addWatchTree(full);
+                    m_dirtyDirs.insert(full);
+                } else if (full.endsWith(".desktop")) {
+                    m_dirtyFiles.insert(full);
+                }
+            }
+        }
+        if (m_fullRescan || !m_dirtyFiles.isEmpty() || !m_dirtyDirs.isEmpty())
+            m_flush.start();
+    }
+
+    void flush() {
+        if (m_fullRescan) {
+            m_entries = scanAll();
+        } else {
+            for (const QString &dir : m_dirtyDirs) {
+                QString prefix = dir + "/";
+                m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                    [&](const Entry &e){ return e.path.startsWith(prefix); }), m_entries.end());
+                scanDir(dir, m_entries);
+            }
+            for (const QString &file : m_dirtyFiles) {
+                m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                    [&](const Entry &e){ return e.path == file; }), m_entries.end());
+                Entry e;
+                if (parseDesktopFile(file, e)) m_entries.append(e);
+            }
+        }
+        m_fullRescan = false;
+        m_dirtyFiles.clear();
+        m_dirtyDirs.clear();
+
+        writeIndex(m_entries, collectDirs());
+        if (onChanged) onChanged(m_entries);
+    }
+};
+
+} // namespace WospAppDb
@@ -0,0 +1,226 @@
+// wosp-atlas.h
+// Pre-decoded UI images shared by every shell process.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// pack() decodes every PNG in an image directory once, converts it to
+// premultiplied ARGB32 and writes the lot into one file under
+// ~/.cache/wosp-shell/. Atlas::open() maps that file read-only and image()
+// wraps a region of the mapping in a QImage without copying, so
+// wosp-shell, quicksettings and wosp-lock share the same page-cache pages
+// and never run the PNG decoder. `wosp-shell --pack-atlas` packs at
+// install time; the first process to find the atlas missing or older than
+// the PNGs repacks it on a worker thread and decodes directly until the
+// new file is mapped. The file is replaced by rename, so mappings other
+// processes hold stay valid.
+//
+// Images keep the PNG's own pixel size and a device pixel ratio of 1, the
+// same as a plain QImage(path), so callers size and scale them exactly as
+// before and one atlas is valid on every screen. They are never copied
+// unless the caller modifies them.
+
+#pragma once
+
+#include <QGuiApplication>
+#include <QImage>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QStringList>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QVariant>
+#include <QThread>
+#include <QDebug>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace WospAtlas {
+
+static const uint32_t MAGIC = 0x57415431;   // "WAT1"
+static const uint32_t VERSION = 2;
+static const int ALIGN = 64;                // pixel data starts on cache lines
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved0;
+    int64_t  sourceStamp;       // newest PNG mtime when packed
+    uint32_t sourceCount;       // PNGs in the directory when packed
+    uint32_t reserved;
+};
+
+struct Entry {
+    char     name[48];
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t reserved;
+    uint64_t offset;            // from the start of the file
+};
+
+// ~/.cache/wosp-shell/<dir with / as _>.atlas
+inline QString atlasPath(const QString &dir) {
+    QString key = QDir::cleanPath(QFileInfo(dir).absoluteFilePath());
+    key.replace('/', '_');
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+           + "/wosp-shell/" + key + ".atlas";
+}
+
+inline QFileInfoList sources(const QString &dir) {
+    return QDir(dir).entryInfoList(QStringList() << "*.png", QDir::Files, QDir::Name);
+}
+
+inline int64_t stampOf(const QFileInfoList &files) {
+    int64_t newest = 0;
+    for (const QFileInfo &fi : files)
+        newest = qMax<int64_t>(newest, fi.lastModified().toSecsSinceEpoch());
+    return newest;
+}
+
+// Decode every PNG in dir into an atlas file at out
+inline bool pack(const QString &dir, const QString &out) {
+    QFileInfoList files = sources(dir);
+
+    QList<QImage> images;
+    QList<QByteArray> names;
+    for (const QFileInfo &fi : files) {
+        QByteArray name = QFile::encodeName(fi.fileName());
+        if (name.size() >= int(sizeof(Entry::name))) continue;
+        QImage img(fi.absoluteFilePath());
+        if (img.isNull()) continue;
+        images << img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        names << name;
+    }
+
+    Header h{};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.count = uint32_t(images.size());
+    h.sourceStamp = stampOf(files);
+    h.sourceCount = uint32_t(files.size());
+
+    QVector<Entry> entries(images.size());
+    uint64_t offset = sizeof(Header) + sizeof(Entry) * uint64_t(images.size());
+    for (int i = 0; i < images.size(); ++i) {
+        offset = (offset + ALIGN - 1) / ALIGN * ALIGN;
+        Entry &e = entries[i];
+        std::memset(&e, 0, sizeof(e));
+        std::memcpy(e.name, names[i].constData(), size_t(names[i].size()));
+        e.width = uint32_t(images[i].width());
+        e.height = uint32_t(images[i].height());
+        e.stride = uint32_t(images[i].bytesPerLine());
+        e.offset = offset;
+        offset += uint64_t(e.stride) * e.height;
+    }
+
+    QDir().mkpath(QFileInfo(out).absolutePath());
+    QSaveFile f(out);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    f.write(reinterpret_cast<const char*>(entries.constData()), sizeof(Entry) * entries.size());
+    for (int i = 0; i < images.size(); ++i) {
+        f.write(QByteArray(int(entries[i].offset - uint64_t(f.pos())), '\0'));
+        f.write(reinterpret_cast<const char*>(images[i].constBits()),
+                qint64(entries[i].stride) * entries[i].height);
+    }
+    return f.commit();
+}
+
+class Atlas {
+public:
+    // The process-wide atlas for an image directory; packs it if needed.
+    // Never freed: images handed out point into the mapping.
+    static Atlas* open(const QString &dir) {
+        QByteArray prop = "wosp-atlas:" + QFile::encodeName(dir);
+        QVariant v = qApp->property(prop.constData());
+        if (v.isValid()) return reinterpret_cast<Atlas*>(v.value<quintptr>());
+
+        Atlas *a = new Atlas(dir);
+        qApp->setProperty(prop.constData(), QVariant::fromValue(quintptr(a)));
+        return a;
+    }
+
+    // Wraps the mapped pixels; null if name is not in the atlas
+    QImage image(const QString &name) const {
+        auto it = m_index.constFind(name);
+        if (it == m_index.cend()) return QImage();
+        const Entry *e = it.value();
+        return QImage(m_base + e->offset, int(e->width), int(e->height), int(e->stride),
+                      QImage::Format_ARGB32_Premultiplied);
+    }
+
+    // image() if packed, else a plain decode so a broken cache never hides icons
+    QImage load(const QString &name) const {
+        QImage img = image(name);
+        return img.isNull() ? QImage(m_dir + "/" + name) : img;
+    }
+
+private:
+    QString m_dir;
+    const uchar *m_base = nullptr;
+    QHash<QString, const Entry*> m_index;
+
+    explicit Atlas(const QString &dir) : m_dir(dir) {
+        QString path = atlasPath(dir);
+        if (map(path)) return;
+
+        // Startup never waits on the decoder; load() falls back meanwhile
+        QThread *worker = QThread::create([dir, path]{
+            if (!pack(dir, path))
+                qWarning() << "wosp-atlas: cannot write" << path;
+        });
+        QObject::connect(worker, &QThread::finished, qApp, [this, worker, path]{
+            map(path);
+            worker->deleteLater();
+        });
+        worker->start(QThread::LowPriority);
+    }
+
+    bool map(const QString &path) {
+        int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        void *p = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Header))
+            p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+
+        const uchar *base = static_cast<const uchar*>(p);
+        size_t size = size_t(st.st_size);
+        const Header *h = reinterpret_cast<const Header*>(base);
+        QFileInfoList files = sources(m_dir);
+        bool ok = h->magic == MAGIC && h->version == VERSION
+                  && h->sourceCount == uint32_t(files.size())
+                  && h->sourceStamp == stampOf(files)
+                  && sizeof(Header) + sizeof(Entry) * uint64_t(h->count) <= size;
+
+        const Entry *entries = reinterpret_cast<const Entry*>(base + sizeof(Header));
+        for (uint32_t i = 0; ok && i < h->count; ++i) {
+            const Entry &e = entries[i];
+            ok = e.name[sizeof(e.name) - 1] == '\0'
+                 && e.offset + uint64_t(e.stride) * e.height <= size;
+        }
+        if (!ok) {
+            munmap(p, size);
+            return false;
+        }
+
+        m_base = base;
+        for (uint32_t i = 0; i < h->count; ++i)
+            m_index.insert(QString::fromUtf8(entries[i].name), &entries[i]);
+        return true;
+    }
+};
+
+} // namespace WospAtlas
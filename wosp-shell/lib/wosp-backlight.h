@@ -0,0 +1,123 @@
+// wosp-backlight.h
+// In-process brightness control for wosp-shell.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary, after Qt.
+//
+// Writes /sys/class/backlight/<dev>/brightness directly; write access is
+// granted to the video group by brightnessctl's udev rule. Panels without
+// a backlight device (HDMI, some SBCs) fall back to scaling the primary
+// CRTC's gamma ramp through XRandR, which is what `xrandr --brightness`
+// does. Requests are coalesced so at most one write lands per frame.
+// Link with -lX11 -lXrandr.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+#include <QGuiApplication>
+#include <QScreen>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "wosp-x11.h"
+
+class WospBacklight : public QObject {
+public:
+    explicit WospBacklight(QObject *parent = nullptr) : QObject(parent) {
+        QDir d("/sys/class/backlight");
+        for (const QString &dev : d.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+            QString base = d.absoluteFilePath(dev);
+            QFile maxF(base + "/max_brightness");
+            if (!maxF.open(QIODevice::ReadOnly)) continue;
+            int max = maxF.readAll().trimmed().toInt();
+            if (max <= 0) continue;
+
+            int fd = ::open(QFile::encodeName(base + "/brightness").constData(), O_WRONLY | O_CLOEXEC);
+            if (fd < 0) continue;   // no udev-granted access to this one
+            m_fd = fd;
+            m_max = max;
+            break;
+        }
+
+        double hz = QGuiApplication::primaryScreen()
+                  ? QGuiApplication::primaryScreen()->refreshRate() : 60.0;
+        m_frame.setSingleShot(true);
+        m_frame.setInterval(std::max(8, int(1000.0 / (hz > 0 ? hz : 60.0))));
+        QObject::connect(&m_frame, &QTimer::timeout, this, [this]{ apply(); });
+    }
+
+    ~WospBacklight() override {
+        if (m_fd >= 0) ::close(m_fd);
+        if (m_dpy) XCloseDisplay(m_dpy);
+    }
+
+    bool hasBacklight() const { return m_fd >= 0; }
+
+    // 0..100; only the latest value per frame is written
+    void setPercent(int pct) {
+        m_pending = std::clamp(pct, 0, 100);
+        if (!m_frame.isActive()) m_frame.start();
+    }
+
+private:
+    int m_fd = -1;
+    int m_max = 0;
+    int m_pending = -1;
+    int m_applied = -1;
+    QTimer m_frame;
+    Display *m_dpy = nullptr;
+
+    void apply() {
+        if (m_pending < 0 || m_pending == m_applied) return;
+        m_applied = m_pending;
+
+        if (m_fd >= 0) applySysfs(m_applied);
+        else applyGamma(m_applied);
+    }
+
+    void applySysfs(int pct) {
+        QByteArray v = QByteArray::number(std::max(1, m_max * pct / 100));
+        if (::pwrite(m_fd, v.constData(), size_t(v.size()), 0) < 0) {
+            // Access revoked or device gone: use gamma from now on
+            ::close(m_fd);
+            m_fd = -1;
+            applyGamma(pct);
+        }
+    }
+
+    void applyGamma(int pct) {
+        if (!m_dpy) m_dpy = XOpenDisplay(nullptr);
+        if (!m_dpy) return;
+
+        Window root = DefaultRootWindow(m_dpy);
+        XRRScreenResources *res = XRRGetScreenResourcesCurrent(m_dpy, root);
+        if (!res) return;
+
+        RROutput primary = XRRGetOutputPrimary(m_dpy, root);
+        if (!primary && res->noutput > 0) primary = res->outputs[0];
+
+        XRROutputInfo *out = primary ? XRRGetOutputInfo(m_dpy, res, primary) : nullptr;
+        if (out && out->crtc) {
+            int size = XRRGetCrtcGammaSize(m_dpy, out->crtc);
+            if (size > 1) {
+                XRRCrtcGamma *g = XRRAllocGamma(size);
+                double f = pct / 100.0;
+                for (int i = 0; i < size; ++i) {
+                    unsigned short v = static_cast<unsigned short>(
+                        std::min(65535.0, 65535.0 * i / (size - 1) * f));
+                    g->red[i] = g->green[i] = g->blue[i] = v;
+                }
+                XRRSetCrtcGamma(m_dpy, out->crtc, g);
+                XRRFreeGamma(g);
+                XFlush(m_dpy);
+            }
+        }
+
+        if (out) XRRFreeOutputInfo(out);
+        XRRFreeScreenResources(res);
+    }
+};
@@ -0,0 +1,437 @@
+// wosp-bluez.h
+// Async BlueZ client over sd-bus.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Client mirrors org.bluez into memory: one GetManagedObjects call at
+// start-up, then ObjectManager InterfacesAdded/InterfacesRemoved and
+// PropertiesChanged keep the adapter state and the device table (RSSI,
+// paired, connected) current. Listeners run once per event-loop turn
+// after any change; devices() is cheap to call from them. Discovery and
+// visibility go through Adapter1, so BlueZ itself ends a scan window or
+// a discoverable timeout and the UI just follows the properties. BlueZ
+// keeps one discovery session per D-Bus connection, and each Client only
+// stops the session it started, so the settings page never ends the
+// quick-settings card's scan or the other way round.
+//
+// BlueZ asks a registered org.bluez.Agent1 for PINs, passkeys and
+// confirmations while pairing; without one, devices that need any of
+// them fail to pair. setAgent() exports the agent on the client's own
+// connection (so Pair() calls made through it use it), makes it the
+// default agent, and hands each prompt to the UI, which answers whenever
+// the user does.
+//
+// WOSP_BLUEZ_BUS=session (or a bus address) talks to a bluetoothd on
+// another bus instead of the system one, see wosp-sdbus.h.
+// Link with $(pkg-config --libs libsystemd).
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+#include "wosp-sdbus.h"
+
+namespace WospBluez {
+
+static const char *SERVICE = "org.bluez";
+static const char *ADAPTER = "org.bluez.Adapter1";
+static const char *DEVICE  = "org.bluez.Device1";
+static const char *AGENT   = "org.bluez.Agent1";
+static const char *AGENT_MANAGER = "org.bluez.AgentManager1";
+static const char *AGENT_PATH = "/org/wosp/bluez_agent";
+static const char *AGENT_CAPABILITY = "KeyboardDisplay";
+
+struct Device {
+    QString path;
+    QString address;
+    QString name;           // Alias, which BlueZ falls back to the address
+    int rssi = 0;
+    bool inRange = false;   // RSSI seen during the current discovery
+    bool paired = false;
+    bool connected = false;
+    bool trusted = false;
+};
+
+// A pairing prompt from BlueZ. PinCode and Passkey want an answer typed
+// in; Confirm (code = passkey shown on both sides) and Authorize want a
+// yes/no; ShowPinCode/ShowPasskey only display code, and Cancel withdraws
+// the open prompt. Answers to the display-only kinds are ignored. BlueZ
+// sends ShowPasskey again for every digit typed on the remote keyboard,
+// with `entered` counting them; update the open prompt, don't reopen it.
+struct AgentRequest {
+    enum Kind { PinCode, Passkey, Confirm, Authorize, ShowPinCode, ShowPasskey, Cancel };
+    Kind kind = Cancel;
+    QString path;           // device object path
+    QString name;           // device alias
+    QString code;
+    int entered = 0;        // ShowPasskey: digits typed so far
+};
+
+using AgentAnswer = std::function<void(bool accepted, const QString &text)>;
+using AgentPrompt = std::function<void(const AgentRequest&, AgentAnswer)>;
+
+struct State {
+    bool available = false;     // org.bluez answered with an adapter
+    QString adapter;            // object path, e.g. /org/bluez/hci0
+    bool powered = false;
+    bool discoverable = false;
+    bool discovering = false;
+};
+
+class Client : public QObject {
+public:
+    explicit Client(QObject *parent = nullptr)
+        : QObject(parent), m_bus("WOSP_BLUEZ_BUS")
+    {
+        m_notify.setSingleShot(true);
+        m_notify.setInterval(0);
+        QObject::connect(&m_notify, &QTimer::timeout, this, [this]{
+            for (const auto &fn : m_listeners) fn();
+        });
+
+        m_scanWindow.setSingleShot(true);
+        QObject::connect(&m_scanWindow, &QTimer::timeout, this, [this]{ stopDiscovery(); });
+
+        m_bus.match(SERVICE, nullptr, WospBus::OBJECT_MANAGER, "InterfacesAdded",
+                    [this](sd_bus_message *m){
+                        QVariantList a = WospBus::readAll(m);
+                        added(a.value(0).toString(), a.value(1).toMap());
+                    });
+        m_bus.match(SERVICE, nullptr, WospBus::OBJECT_MANAGER, "InterfacesRemoved",
+                    [this](sd_bus_message *m){
+                        QVariantList a = WospBus::readAll(m);
+                        removed(a.value(0).toString(), a.value(1).toList());
+                    });
+        m_bus.match(SERVICE, nullptr, WospBus::PROPERTIES, "PropertiesChanged",
+                    [this](sd_bus_message *m){ propertiesChanged(m); });
+        // bluetoothd restarted (or started after us)
+        m_bus.match("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+                    "NameOwnerChanged", [this](sd_bus_message *m){
+                        QVariantList a = WospBus::readAll(m);
+                        if (a.value(0).toString() != SERVICE) return;
+                        m_scanning = false;     // sessions die with bluetoothd
+                        refresh();
+                        if (m_prompt && !a.value(2).toString().isEmpty()) registerAgent();
+                    });
+        refresh();
+    }
+
+    ~Client() override {
+        if (m_agentCall) sd_bus_message_unref(m_agentCall);
+    }
+
+    const State& state() const { return m_state; }
+
+    // Connected first, then paired, then strongest signal
+    QList<Device> devices() const {
+        QList<Device> list = m_devices.values();
+        std::sort(list.begin(), list.end(), [](const Device &a, const Device &b) {
+            if (a.connected != b.connected) return a.connected;
+            if (a.paired != b.paired) return a.paired;
+            if (a.inRange != b.inRange) return a.inRange;
+            if (a.rssi != b.rssi) return a.rssi > b.rssi;
+            return a.name.localeAwareCompare(b.name) < 0;
+        });
+        return list;
+    }
+
+    void listen(std::function<void()> fn) { m_listeners.append(std::move(fn)); }
+
+    // Register the pairing agent; prompt shows each request to the user
+    void setAgent(AgentPrompt prompt) {
+        bool first = !m_prompt;
+        m_prompt = std::move(prompt);
+        if (!first) return;
+        m_bus.serve(AGENT_PATH, [this](sd_bus_message *m){ return agentCall(m); });
+        registerAgent();
+    }
+
+    // Re-read the whole object tree; normally only needed once
+    void refresh() {
+        m_bus.call(SERVICE, "/", WospBus::OBJECT_MANAGER, "GetManagedObjects",
+                   [this](sd_bus_message *m) {
+                       m_devices.clear();
+                       m_state = State();
+                       if (WospBus::errorOf(m).isEmpty()) {
+                           QVariantMap objects = WospBus::readAll(m).value(0).toMap();
+                           for (auto it = objects.cbegin(); it != objects.cend(); ++it)
+                               added(it.key(), it.value().toMap());
+                       }
+                       changed();
+                   });
+    }
+
+    void setPowered(bool on) {
+        if (m_state.adapter.isEmpty()) return;
+        m_bus.setProperty(SERVICE, m_state.adapter, ADAPTER, "Powered", "b", int(on));
+    }
+
+    // BlueZ drops Discoverable by itself after timeoutSec (0 = never)
+    void setDiscoverable(bool on, uint timeoutSec = 0) {
+        if (m_state.adapter.isEmpty()) return;
+        if (on)
+            m_bus.setProperty(SERVICE, m_state.adapter, ADAPTER, "DiscoverableTimeout",
+                              "u", timeoutSec);
+        m_bus.setProperty(SERVICE, m_state.adapter, ADAPTER, "Discoverable", "b", int(on));
+    }
+
+    // Scan for `seconds`; the Discovering property reports the adapter's
+    // state, which another client's scan can keep on
+    void startDiscovery(int seconds) {
+        if (m_state.adapter.isEmpty()) return;
+        m_scanWindow.start(seconds * 1000);
+        if (m_scanning) return;
+        m_scanning = true;
+        m_bus.call(SERVICE, m_state.adapter.toUtf8().constData(), ADAPTER, "StartDiscovery",
+                   [this](sd_bus_message *m) {
+                       if (!WospBus::errorOf(m).isEmpty()) m_scanning = false;
+                   });
+    }
+
+    // Ends this client's scan only
+    void stopDiscovery() {
+        m_scanWindow.stop();
+        if (m_state.adapter.isEmpty() || !m_scanning) return;
+        m_scanning = false;
+        m_bus.call(SERVICE, m_state.adapter.toUtf8().constData(), ADAPTER, "StopDiscovery",
+                   [](sd_bus_message*) {});
+    }
+
+    // This client asked for a scan that has not been stopped yet
+    bool scanning() const { return m_scanning; }
+
+    // Actions below report done(errorText), "" on success
+
+    void connectDevice(const QString &path, std::function<void(const QString&)> done) {
+        deviceCall(path, "Connect", std::move(done));
+    }
+
+    void disconnectDevice(const QString &path, std::function<void(const QString&)> done) {
+        deviceCall(path, "Disconnect", std::move(done));
+    }
+
+    // Pairs (prompting through setAgent()'s agent), trusts, then connects
+    void pairAndConnect(const QString &path, std::function<void(const QString&)> done) {
+        deviceCall(path, "Pair", [this, path, done](const QString &err) {
+            if (!err.isEmpty() && !err.contains("Already Exists", Qt::CaseInsensitive)) {
+                done(err);
+                return;
+            }
+            m_bus.setProperty(SERVICE, path, DEVICE, "Trusted", "b", 1);
+            connectDevice(path, done);
+        });
+    }
+
+    void removeDevice(const QString &path, std::function<void(const QString&)> done) {
+        if (m_state.adapter.isEmpty()) { done("No Bluetooth adapter"); return; }
+        QByteArray dev = path.toUtf8();
+        m_bus.call(SERVICE, m_state.adapter.toUtf8().constData(), ADAPTER, "RemoveDevice",
+                   [done](sd_bus_message *m){ done(WospBus::errorOf(m)); },
+                   "o", dev.constData());
+    }
+
+private:
+    WospBus::Bus m_bus;
+    QTimer m_notify;
+    QTimer m_scanWindow;
+    bool m_scanning = false;            // our own discovery session
+    QList<std::function<void()>> m_listeners;
+    State m_state;
+    QHash<QString, Device> m_devices;   // by object path
+    AgentPrompt m_prompt;
+    sd_bus_message *m_agentCall = nullptr;  // prompt waiting for the user
+    int m_agentSeq = 0;
+
+    void changed() { m_notify.start(); }
+
+    void registerAgent() {
+        m_bus.call(SERVICE, "/org/bluez", AGENT_MANAGER, "RegisterAgent",
+                   [this](sd_bus_message *m) {
+                       QString err = WospBus::errorOf(m);
+                       if (!err.isEmpty() && !err.contains("Already Exists", Qt::CaseInsensitive))
+                           return;
+                       m_bus.call(SERVICE, "/org/bluez", AGENT_MANAGER, "RequestDefaultAgent",
+                                  [](sd_bus_message*) {}, "o", AGENT_PATH);
+                   }, "os", AGENT_PATH, AGENT_CAPABILITY);
+    }
+
+    // Withdraw the prompt in flight, if any, with a BlueZ error
+    void dropAgentCall(const char *error, const QString &text) {
+        if (!m_agentCall) return;
+        sd_bus_message *call = m_agentCall;
+        m_agentCall = nullptr;
+        ++m_agentSeq;
+        m_bus.replyError(call, error, text);
+    }
+
+    bool agentCall(sd_bus_message *m) {
+        const char *member = sd_bus_message_get_member(m);
+        if (!sd_bus_message_is_method_call(m, AGENT, nullptr) || !member) return false;
+        QString method = QString::fromUtf8(member);
+        QVariantList args = WospBus::readAll(m);
+
+        AgentRequest req;
+        req.path = args.value(0).toString();
+        req.name = m_devices.value(req.path).name;
+        if (req.name.isEmpty()) req.name = req.path.section('/', -1);
+
+        sd_bus_message_ref(m);
+        if (method == "Release") {
+            m_bus.reply(m);
+            return true;
+        }
+        if (method == "Cancel") {
+            dropAgentCall("org.bluez.Error.Canceled", "Canceled");
+            m_bus.reply(m);
+            if (m_prompt) m_prompt(AgentRequest(), [](bool, const QString&) {});
+            return true;
+        }
+        if (method == "AuthorizeService") {
+            // Services of a device the user already paired are fine
+            if (m_devices.value(req.path).paired) m_bus.reply(m);
+            else m_bus.replyError(m, "org.bluez.Error.Rejected", "Not paired");
+            return true;
+        }
+        if (method == "DisplayPinCode" || method == "DisplayPasskey") {
+            req.kind = method == "DisplayPinCode" ? AgentRequest::ShowPinCode
+                                                  : AgentRequest::ShowPasskey;
+            req.code = method == "DisplayPinCode"
+                           ? args.value(1).toString()
+                           : QString("%1").arg(args.value(1).toUInt(), 6, 10, QChar('0'));
+            if (method == "DisplayPasskey") req.entered = int(args.value(2).toUInt());
+            m_bus.reply(m);
+            if (m_prompt) m_prompt(req, [](bool, const QString&) {});
+            return true;
+        }
+
+        if (method == "RequestPinCode") req.kind = AgentRequest::PinCode;
+        else if (method == "RequestPasskey") req.kind = AgentRequest::Passkey;
+        else if (method == "RequestConfirmation") req.kind = AgentRequest::Confirm;
+        else if (method == "RequestAuthorization") req.kind = AgentRequest::Authorize;
+        else {
+            sd_bus_message_unref(m);
+            return false;
+        }
+        if (req.kind == AgentRequest::Confirm)
+            req.code = QString("%1").arg(args.value(1).toUInt(), 6, 10, QChar('0'));
+
+        if (!m_prompt) {
+            m_bus.replyError(m, "org.bluez.Error.Rejected", "No one to ask");
+            return true;
+        }
+
+        // One prompt at a time; a newer request supersedes the old one
+        dropAgentCall("org.bluez.Error.Canceled", "Superseded");
+        m_agentCall = m;
+        int seq = ++m_agentSeq;
+        AgentRequest::Kind kind = req.kind;
+        m_prompt(req, [this, seq, kind](bool accepted, const QString &text) {
+            if (seq != m_agentSeq || !m_agentCall) return;    // cancelled meanwhile
+            sd_bus_message *call = m_agentCall;
+            m_agentCall = nullptr;
+            ++m_agentSeq;
+
+            bool ok = false;
+            uint passkey = text.trimmed().toUInt(&ok);
+            if (!accepted) {
+                m_bus.replyError(call, "org.bluez.Error.Rejected", "Rejected by user");
+            } else if (kind == AgentRequest::PinCode) {
+                QByteArray pin = text.trimmed().toUtf8();
+                m_bus.reply(call, "s", pin.constData());
+            } else if (kind == AgentRequest::Passkey) {
+                if (ok && passkey <= 999999) m_bus.reply(call, "u", uint32_t(passkey));
+                else m_bus.replyError(call, "org.bluez.Error.Rejected", "Not a passkey");
+            } else {
+                m_bus.reply(call);
+            }
+        });
+        return true;
+    }
+
+    void deviceCall(const QString &path, const char *member,
+                    std::function<void(const QString&)> done) {
+        m_bus.call(SERVICE, path.toUtf8().constData(), DEVICE, member,
+                   [done](sd_bus_message *m){ done(WospBus::errorOf(m)); });
+    }
+
+    void added(const QString &path, const QVariantMap &ifaces) {
+        if (ifaces.contains(ADAPTER) && (m_state.adapter.isEmpty() || m_state.adapter == path)) {
+            m_state.available = true;
+            m_state.adapter = path;
+            updateAdapter(ifaces.value(ADAPTER).toMap());
+        }
+        if (ifaces.contains(DEVICE)) {
+            Device &d = m_devices[path];
+            d.path = path;
+            updateDevice(d, ifaces.value(DEVICE).toMap());
+        }
+        changed();
+    }
+
+    void removed(const QString &path, const QVariantList &ifaces) {
+        for (const QVariant &i : ifaces) {
+            QString iface = i.toString();
+            if (iface == DEVICE) m_devices.remove(path);
+            if (iface == ADAPTER && path == m_state.adapter) {
+                // Adapter unplugged: its devices go with it; look for another
+                m_state = State();
+                m_devices.clear();
+                refresh();
+            }
+        }
+        changed();
+    }
+
+    void updateAdapter(const QVariantMap &p) {
+        if (p.contains("Powered")) m_state.powered = p.value("Powered").toBool();
+        if (p.contains("Discoverable")) m_state.discoverable = p.value("Discoverable").toBool();
+        if (p.contains("Discovering")) {
+            m_state.discovering = p.value("Discovering").toBool();
+            if (!m_state.discovering) {
+                m_scanWindow.stop();
+                for (Device &d : m_devices) d.inRange = false;
+            }
+        }
+    }
+
+    static void updateDevice(Device &d, const QVariantMap &p) {
+        if (p.contains("Address")) d.address = p.value("Address").toString();
+        if (p.contains("Alias")) d.name = p.value("Alias").toString();
+        else if (p.contains("Name") && d.name.isEmpty()) d.name = p.value("Name").toString();
+        if (d.name.isEmpty()) d.name = d.address;
+        if (p.contains("RSSI")) {
+            d.rssi = p.value("RSSI").toInt();
+            d.inRange = true;
+        }
+        if (p.contains("Paired")) d.paired = p.value("Paired").toBool();
+        if (p.contains("Connected")) d.connected = p.value("Connected").toBool();
+        if (p.contains("Trusted")) d.trusted = p.value("Trusted").toBool();
+    }
+
+    void propertiesChanged(sd_bus_message *m) {
+        QString path = QString::fromUtf8(sd_bus_message_get_path(m));
+        QVariantList args = WospBus::readAll(m);
+        QString iface = args.value(0).toString();
+        QVariantMap p = args.value(1).toMap();
+        QStringList gone;
+        for (const QVariant &v : args.value(2).toList()) gone << v.toString();
+
+        if (iface == ADAPTER && path == m_state.adapter) {
+            updateAdapter(p);
+            changed();
+        } else if (iface == DEVICE && m_devices.contains(path)) {
+            Device &d = m_devices[path];
+            updateDevice(d, p);
+            if (gone.contains("RSSI")) d.inRange = false;   // dropped out of range
+            changed();
+        }
+    }
+};
+
+} // namespace WospBluez
@@ -0,0 +1,263 @@
+/* wosp-bus.h
+ * Client side of the wosp-bus command bus (see apps/wosp-bus.cpp).
+ * Header-only, NO moc, NO Q_OBJECT — include once per binary.
+ *
+ * Shell components publish verbs ("overlay.open", "keyboard.show",
+ * "power.menu", ...) to $XDG_RUNTIME_DIR/wosp-bus.sock and the
+ * daemon forwards each one to every connection that subscribed to it, so
+ * an action costs a socket round-trip instead of a fork/exec. Every frame
+ * is an 8-byte header followed by the verb and an optional payload:
+ *
+ *   u8 type | u8 verb_len | u16 payload_len | u32 value | verb | payload
+ *
+ * SUBSCRIBE and SEND go to the daemon, DELIVER comes back to subscribers.
+ * A SEND with value=1 asks for an ACK whose value is the number of
+ * handlers reached, so callers can fall back to spawning a process when
+ * nobody is listening. Host byte order; the socket never leaves the box.
+ *
+ * The wosp_bus_* functions are plain C (usable from C, C++ and the CLI).
+ * Qt programs (QT_CORE_LIB, set by pkg-config) also get WospCommands,
+ * which subscribes through a QSocketNotifier and reconnects if the daemon
+ * restarts.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+enum {
+    WOSP_BUS_SUBSCRIBE = 1,
+    WOSP_BUS_SEND      = 2,
+    WOSP_BUS_DELIVER   = 3,
+    WOSP_BUS_ACK       = 4,
+};
+
+#define WOSP_BUS_MAX_VERB     255
+#define WOSP_BUS_MAX_PAYLOAD  4096
+#define WOSP_BUS_ACK_TIMEOUT_MS 500
+
+struct wosp_bus_header {
+    uint8_t  type;
+    uint8_t  verb_len;
+    uint16_t payload_len;
+    uint32_t value;
+};
+
+static inline int wosp_bus_path(char *buf, size_t cap) {
+    const char *rt = getenv("XDG_RUNTIME_DIR");
+    int n = (rt && *rt) ? snprintf(buf, cap, "%s/wosp-bus.sock", rt)
+                        : snprintf(buf, cap, "/run/user/%u/wosp-bus.sock", (unsigned)getuid());
+    return (n > 0 && (size_t)n < cap) ? 0 : -1;
+}
+
+static inline int wosp_bus_write_all(int fd, const void *buf, size_t len) {
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static inline int wosp_bus_read_all(int fd, void *buf, size_t len) {
+    char *p = (char *)buf;
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* Blocking connection to the daemon, -1 if it is not running */
+static inline int wosp_bus_connect(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (wosp_bus_path(addr.sun_path, sizeof(addr.sun_path)) != 0) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static inline int wosp_bus_frame(int fd, uint8_t type, const char *verb,
+                                 const void *payload, size_t len, uint32_t value) {
+    size_t vlen = strlen(verb);
+    if (vlen == 0 || vlen > WOSP_BUS_MAX_VERB || len > WOSP_BUS_MAX_PAYLOAD) return -1;
+
+    char buf[sizeof(struct wosp_bus_header) + WOSP_BUS_MAX_VERB + WOSP_BUS_MAX_PAYLOAD];
+    struct wosp_bus_header h;
+    h.type = type;
+    h.verb_len = (uint8_t)vlen;
+    h.payload_len = (uint16_t)len;
+    h.value = value;
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), verb, vlen);
+    if (len) memcpy(buf + sizeof(h) + vlen, payload, len);
+    return wosp_bus_write_all(fd, buf, sizeof(h) + vlen + len);
+}
+
+static inline int wosp_bus_subscribe(int fd, const char *verb) {
+    return wosp_bus_frame(fd, WOSP_BUS_SUBSCRIBE, verb, NULL, 0, 0);
+}
+
+/* Fire and forget; fine on a subscribed connection */
+static inline int wosp_bus_post(int fd, const char *verb, const void *payload, size_t len) {
+    return wosp_bus_frame(fd, WOSP_BUS_SEND, verb, payload, len, 0);
+}
+
+/* Next frame on fd. verb gets NUL-terminated; *len is the payload size.
+ * Returns the frame type, or -1 when the connection is gone. */
+static inline int wosp_bus_read(int fd, char *verb, size_t verb_cap,
+                                void *payload, size_t payload_cap,
+                                size_t *len, uint32_t *value) {
+    struct wosp_bus_header h;
+    char skip[256];
+    if (wosp_bus_read_all(fd, &h, sizeof(h)) != 0) return -1;
+    if (h.verb_len >= verb_cap || h.payload_len > payload_cap) {
+        /* Too big for the caller: consume it and report an empty verb */
+        size_t left = (size_t)h.verb_len + h.payload_len;
+        while (left > 0) {
+            size_t n = left < sizeof(skip) ? left : sizeof(skip);
+            if (wosp_bus_read_all(fd, skip, n) != 0) return -1;
+            left -= n;
+        }
+        verb[0] = '\0';
+        *len = 0;
+    } else {
+        if (wosp_bus_read_all(fd, verb, h.verb_len) != 0) return -1;
+        verb[h.verb_len] = '\0';
+        if (h.payload_len && wosp_bus_read_all(fd, payload, h.payload_len) != 0) return -1;
+        *len = h.payload_len;
+    }
+    if (value) *value = h.value;
+    return h.type;
+}
+
+/* One-shot send on a fresh connection; returns the number of handlers
+ * reached, 0 if nobody is subscribed, -1 if the daemon is not running */
+static inline int wosp_bus_send(const char *verb, const void *payload, size_t len) {
+    int fd = wosp_bus_connect();
+    if (fd < 0) return -1;
+
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = WOSP_BUS_ACK_TIMEOUT_MS * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    int handlers = -1;
+    if (wosp_bus_frame(fd, WOSP_BUS_SEND, verb, payload, len, 1) == 0) {
+        char v[WOSP_BUS_MAX_VERB + 1];
+        size_t n = 0;
+        uint32_t count = 0;
+        if (wosp_bus_read(fd, v, sizeof(v), NULL, 0, &n, &count) == WOSP_BUS_ACK)
+            handlers = (int)count;
+    }
+    close(fd);
+    return handlers;
+}
+
+#if defined(__cplusplus) && defined(QT_CORE_LIB)
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <functional>
+
+class WospCommands : public QObject {
+public:
+    using Handler = std::function<void(const QByteArray &payload)>;
+
+    explicit WospCommands(QObject *parent = nullptr) : QObject(parent) {
+        m_retry.setInterval(5000);
+        QObject::connect(&m_retry, &QTimer::timeout, this, [this]{ attach(); });
+        attach();
+    }
+
+    ~WospCommands() override { detach(); }
+
+    // Register before or after the daemon is up; re-sent on reconnect
+    void handle(const QString &verb, Handler fn) {
+        m_handlers.insert(verb, std::move(fn));
+        if (m_fd >= 0) wosp_bus_subscribe(m_fd, verb.toUtf8().constData());
+    }
+
+    // true if at least one handler got it; false means "do it yourself"
+    static bool send(const QString &verb, const QByteArray &payload = QByteArray()) {
+        return wosp_bus_send(verb.toUtf8().constData(), payload.constData(),
+                             size_t(payload.size())) > 0;
+    }
+
+private:
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer m_retry;
+    QHash<QString, Handler> m_handlers;
+
+    void attach() {
+        m_fd = wosp_bus_connect();
+        if (m_fd < 0) {
+            m_retry.start();
+            return;
+        }
+        m_retry.stop();
+        for (auto it = m_handlers.cbegin(); it != m_handlers.cend(); ++it)
+            wosp_bus_subscribe(m_fd, it.key().toUtf8().constData());
+
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        QObject::connect(m_notifier, &QSocketNotifier::activated, this, [this]{ receive(); });
+    }
+
+    void detach() {
+        // May run from inside the notifier's own activated()
+        if (m_notifier) {
+            m_notifier->setEnabled(false);
+            m_notifier->deleteLater();
+        }
+        m_notifier = nullptr;
+        if (m_fd >= 0) ::close(m_fd);
+        m_fd = -1;
+    }
+
+    // One frame per wakeup; the notifier fires again while more are queued
+    void receive() {
+        char verb[WOSP_BUS_MAX_VERB + 1];
+        QByteArray payload(WOSP_BUS_MAX_PAYLOAD, Qt::Uninitialized);
+        size_t len = 0;
+        int type = wosp_bus_read(m_fd, verb, sizeof(verb), payload.data(),
+                                 size_t(payload.size()), &len, nullptr);
+        if (type < 0) {
+            detach();
+            m_retry.start();
+            return;
+        }
+        if (type != WOSP_BUS_DELIVER) return;
+
+        payload.truncate(int(len));
+        auto it = m_handlers.constFind(QString::fromUtf8(verb));
+        if (it != m_handlers.cend()) it.value()(payload);
+    }
+};
+
+#endif
@@ -0,0 +1,322 @@
+// wosp-config.h
+// Write-behind key/value store for the shell's config files.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Store::open(path) hands out the one in-memory copy of a config file for
+// the whole process; osm-settings plugins share it through a property on
+// qApp. Reads are map lookups. setValue() updates memory and tells
+// listeners straight away, and the file is rewritten DEBOUNCE_MS after the
+// last change on a writer thread: temp file, one fsync, rename. A slider
+// drag therefore costs one flash write, the GUI thread never blocks on
+// the disk and readers never see a half-written file. The writer re-reads
+// the file and applies only the keys changed here, so an edit another
+// process made during the debounce window is kept, not reverted. When
+// another process replaces the file, inotify (QFileSystemWatcher on the
+// directory) brings the new values in and listeners hear about each
+// changed key.
+//
+// Format: "key=value" lines; "[Group]" sections map to "Group/key" keys
+// the way QSettings does, so files QSettings(IniFormat) wrote read back
+// unchanged and keep their sections (and [General] header) when rewritten.
+
+#pragma once
+
+#include <QCoreApplication>
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QMap>
+#include <QSet>
+#include <QList>
+#include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+#include <QDebug>
+#include <functional>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace WospConfig {
+
+static const int DEBOUNCE_MS = 1000;    // quiet time before a write
+static const int RELOAD_MS = 100;       // coalesce inotify bursts
+
+using Map = QMap<QString, QString>;
+
+inline Map parse(const QByteArray &data, bool *general = nullptr) {
+    Map map;
+    QString group;
+    for (const QByteArray &raw : data.split('\n')) {
+        QString line = QString::fromUtf8(raw).trimmed();
+        if (line.isEmpty() || line.startsWith('#') || line.startsWith(';'))
+            continue;
+        if (line.startsWith('[') && line.endsWith(']')) {
+            group = line.mid(1, line.size() - 2).trimmed();
+            if (group == "General") {
+                group.clear();
+                if (general) *general = true;
+            }
+            continue;
+        }
+        int eq = line.indexOf('=');
+        if (eq <= 0) continue;
+        QString key = line.left(eq).trimmed();
+        map.insert(group.isEmpty() ? key : group + '/' + key, line.mid(eq + 1).trimmed());
+    }
+    return map;
+}
+
+// Ungrouped keys first, then one section per group (QMap keeps them together)
+inline QByteArray serialize(const Map &map, bool general = false) {
+    QByteArray top, sections;
+    QString current;
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        int slash = it.key().indexOf('/');
+        if (slash < 0) {
+            top += it.key().toUtf8() + '=' + it.value().toUtf8() + '\n';
+            continue;
+        }
+        QString group = it.key().left(slash);
+        if (group != current) {
+            sections += '\n' + ('[' + group + ']').toUtf8() + '\n';
+            current = group;
+        }
+        sections += it.key().mid(slash + 1).toUtf8() + '=' + it.value().toUtf8() + '\n';
+    }
+    if (general && !top.isEmpty()) top.prepend("[General]\n");
+    return top + sections;
+}
+
+// Temp file next to the target, one fsync, rename over it
+inline bool writeAtomic(const QString &path, const QByteArray &data) {
+    QByteArray target = QFile::encodeName(path);
+    QByteArray tmp = target + ".tmp-" + QByteArray::number(getpid());
+
+    struct stat st;
+    mode_t mode = ::stat(target.constData(), &st) == 0 ? (st.st_mode & 07777) : 0666;
+    int fd = ::open(tmp.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    if (fd < 0) return false;
+
+    const char *p = data.constData();
+    qint64 left = data.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, p, size_t(left));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        p += n;
+        left -= n;
+    }
+    bool ok = left == 0 && ::fsync(fd) == 0;
+    ::close(fd);
+    if (ok && ::rename(tmp.constData(), target.constData()) == 0) return true;
+    ::unlink(tmp.constData());
+    return false;
+}
+
+// The file as it is now, with changes applied and removed keys dropped
+inline QByteArray merged(const QString &path, const Map &changes,
+                         const QSet<QString> &removed, bool general) {
+    QFile f(path);
+    Map map = parse(f.open(QFile::ReadOnly) ? f.readAll() : QByteArray(), &general);
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it) map.insert(it.key(), it.value());
+    for (const QString &key : removed) map.remove(key);
+    return serialize(map, general);
+}
+
+class Store : public QObject {
+public:
+    // The process-wide store for path, created on first use
+    static Store* open(const QString &path) {
+        QCoreApplication *app = QCoreApplication::instance();
+        QByteArray prop = "wosp-config:" + QFile::encodeName(QFileInfo(path).absoluteFilePath());
+        if (QObject *o = app->property(prop.constData()).value<QObject*>())
+            return static_cast<Store*>(o);
+
+        Store *s = new Store(QFileInfo(path).absoluteFilePath(), app);
+        app->setProperty(prop.constData(), QVariant::fromValue<QObject*>(s));
+        return s;
+    }
+
+    ~Store() override { sync(); }
+
+    QString value(const QString &key, const QString &def = QString()) const {
+        return m_map.value(key, def);
+    }
+
+    bool boolValue(const QString &key, bool def = false) const {
+        auto it = m_map.constFind(key);
+        if (it == m_map.cend()) return def;
+        return *it == "true" || *it == "1";
+    }
+
+    int intValue(const QString &key, int def = 0) const {
+        bool ok = false;
+        int v = m_map.value(key).toInt(&ok);
+        return ok ? v : def;
+    }
+
+    bool contains(const QString &key) const { return m_map.contains(key); }
+    QStringList keys() const { return m_map.keys(); }
+    bool isEmpty() const { return m_map.isEmpty(); }
+
+    void setValue(const QString &key, const QString &value) {
+        auto it = m_map.constFind(key);
+        if (it != m_map.cend() && *it == value) return;
+        m_map.insert(key, value);
+        changedHere(key);
+    }
+
+    void setBool(const QString &key, bool on) { setValue(key, on ? "true" : "false"); }
+    void setInt(const QString &key, int v) { setValue(key, QString::number(v)); }
+
+    void remove(const QString &key) {
+        if (m_map.remove(key)) changedHere(key);
+    }
+
+    // Start the write now instead of after the debounce (still off-thread)
+    void flush() {
+        m_debounce.stop();
+        if (!m_dirty.isEmpty()) queueWrite();
+    }
+
+    // Runs for every key changed in this process or by another one
+    void listen(std::function<void(const QString &key)> fn) {
+        m_listeners.append(std::move(fn));
+    }
+
+private:
+    class Job : public QRunnable {
+    public:
+        explicit Job(std::function<void()> fn) : m_fn(std::move(fn)) {}
+        void run() override { m_fn(); }
+    private:
+        std::function<void()> m_fn;
+    };
+
+    QString m_path;
+    Map m_map;
+    QSet<QString> m_dirty;          // changed here, not yet handed to the writer
+    QByteArray m_disk;              // what we last read or wrote
+    bool m_general = false;         // keep QSettings' [General] header
+    int m_inflight = 0;
+    QTimer m_debounce;
+    QTimer m_reload;
+    QFileSystemWatcher m_watcher;
+    QThreadPool m_writer;           // one thread: writes land in order
+    QList<std::function<void(const QString&)>> m_listeners;
+
+    Store(const QString &path, QObject *parent) : QObject(parent), m_path(path) {
+        m_writer.setMaxThreadCount(1);
+
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile f(path);
+        if (f.open(QFile::ReadOnly)) m_disk = f.readAll();
+        m_general = m_disk.isEmpty();   // new files get QSettings' layout
+        m_map = parse(m_disk, &m_general);
+
+        m_debounce.setSingleShot(true);
+        m_debounce.setInterval(DEBOUNCE_MS);
+        QObject::connect(&m_debounce, &QTimer::timeout, this, [this]{ flush(); });
+
+        // Watch the directory: rename() replaces the inode a file watch holds
+        m_reload.setSingleShot(true);
+        m_reload.setInterval(RELOAD_MS);
+        QObject::connect(&m_reload, &QTimer::timeout, this, [this]{ reload(); });
+        m_watcher.addPath(QFileInfo(path).absolutePath());
+        QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged,
+                         this, [this]{ m_reload.start(); });
+
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         this, [this]{ sync(); });
+    }
+
+    void changedHere(const QString &key) {
+        m_dirty.insert(key);
+        m_debounce.start();
+        for (const auto &fn : m_listeners) fn(key);
+    }
+
+    // Hands the dirty keys over: new values, and the keys removed here
+    void takeDirty(Map &changes, QSet<QString> &removed) {
+        for (const QString &key : m_dirty) {
+            auto it = m_map.constFind(key);
+            if (it != m_map.cend()) changes.insert(key, *it);
+            else removed.insert(key);
+        }
+        m_dirty.clear();
+    }
+
+    void queueWrite() {
+        Map changes;
+        QSet<QString> removed;
+        takeDirty(changes, removed);
+        QString path = m_path;
+        bool general = m_general;
+        ++m_inflight;
+        m_writer.start(new Job([this, path, changes, removed, general]{
+            QByteArray data = merged(path, changes, removed, general);
+            bool ok = writeAtomic(path, data);
+            // The destructor waits for the writer, so this is still alive
+            QMetaObject::invokeMethod(this, [this, path, data, ok]{
+                --m_inflight;
+                // The file may hold other processes' keys we had not seen yet
+                if (ok) adopt(data);
+                else qWarning() << "wosp-config: cannot write" << path;
+                if (m_inflight == 0) m_reload.start();
+            }, Qt::QueuedConnection);
+        }));
+    }
+
+    // Last chance at exit: finish queued writes, then write what is left
+    void sync() {
+        m_debounce.stop();
+        m_writer.waitForDone();
+        if (m_dirty.isEmpty()) return;
+        Map changes;
+        QSet<QString> removed;
+        takeDirty(changes, removed);
+        QByteArray data = merged(m_path, changes, removed, m_general);
+        if (writeAtomic(m_path, data)) m_disk = data;
+    }
+
+    void reload() {
+        if (m_inflight > 0) return;     // our own rename; checked again when done
+
+        QFile f(m_path);
+        adopt(f.open(QFile::ReadOnly) ? f.readAll() : QByteArray());
+    }
+
+    void adopt(const QByteArray &data) {
+        if (data == m_disk) return;
+        m_disk = data;
+
+        // Keys changed here since the last write win over the file
+        Map ext = parse(data, &m_general);
+        QSet<QString> keys;
+        for (auto it = ext.cbegin(); it != ext.cend(); ++it) keys.insert(it.key());
+        for (auto it = m_map.cbegin(); it != m_map.cend(); ++it) keys.insert(it.key());
+
+        QStringList changed;
+        for (const QString &key : keys) {
+            if (m_dirty.contains(key)) continue;
+            if (ext.contains(key) == m_map.contains(key) && ext.value(key) == m_map.value(key))
+                continue;
+            if (ext.contains(key)) m_map.insert(key, ext.value(key));
+            else m_map.remove(key);
+            changed << key;
+        }
+        for (const QString &key : changed)
+            for (const auto &fn : m_listeners) fn(key);
+    }
+};
+
+} // namespace WospConfig
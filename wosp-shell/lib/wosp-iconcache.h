@@ -0,0 +1,464 @@
+// wosp-iconcache.h
+// Icon theme lookup cache + pre-rasterized icon atlas for the launcher.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// ~/.cache/wosp-shell/icons-<size>.atlas holds a name-sorted lookup table
+// (icon name -> resolved file, atlas slot) followed by premultiplied ARGB32
+// pixels for every resolved icon at <size>x<size>. Lookups binary-search
+// the mmap'd table; a hit is copied into a QPixmap once, without decoding,
+// and that pixmap is kept until the atlas changes. Names not in the table
+// (or a stale table) trigger a rebuild on a worker thread; callers draw a
+// placeholder until onUpdated fires.
+//
+// Themes are searched the way QIcon::fromTheme does: the current theme,
+// then its index.theme Inherits= chain depth-first, then hicolor.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QImage>
+#include <QImageReader>
+#include <QPainter>
+#include <QPixmap>
+#include <QIcon>
+#include <QThread>
+#include <QTimer>
+#include <functional>
+
+#include "wosp-appdb.h"
+
+namespace WospIcons {
+
+static const char    MAGIC[8] = {'W','I','C','N','A','T','0','1'};
+static const quint32 VERSION  = 1;
+static const qint32  NO_ICON  = -1;   // name known, no file found
+static const qint32  UNKNOWN  = -2;   // name not in the table yet
+
+inline QString atlasPath(int size) {
+    return QStandardPaths::writableLocation(
+        QStandardPaths::GenericCacheLocation
+    ) + QString("/wosp-shell/icons-%1.atlas").arg(size);
+}
+
+inline QStringList iconBases() {
+    return {
+        QDir::homePath() + "/.local/share/icons",
+        QDir::homePath() + "/.icons",
+        "/usr/share/icons"
+    };
+}
+
+// Inherits= of the first index.theme found for theme
+inline QStringList themeParents(const QString &theme) {
+    for (const QString &b : iconBases()) {
+        QFile f(b + "/" + theme + "/index.theme");
+        if (!f.open(QIODevice::ReadOnly)) continue;
+
+        bool inTheme = false;
+        for (const QByteArray &raw : f.readAll().split('\n')) {
+            QString line = QString::fromUtf8(raw).trimmed();
+            if (line.startsWith('[')) { inTheme = line == "[Icon Theme]"; continue; }
+            if (!inTheme || !line.startsWith("Inherits")) continue;
+            int eq = line.indexOf('=');
+            if (eq < 0 || line.left(eq).trimmed() != "Inherits") continue;
+
+            QStringList parents;
+            for (const QString &p : line.mid(eq + 1).split(',', Qt::SkipEmptyParts))
+                if (!p.trimmed().isEmpty()) parents << p.trimmed();
+            return parents;
+        }
+        return {};
+    }
+    return {};
+}
+
+inline void addThemeChain(const QString &theme, QStringList &out) {
+    if (theme.isEmpty() || theme == "hicolor" || out.contains(theme)) return;
+    out << theme;
+    for (const QString &p : themeParents(theme)) addThemeChain(p, out);
+}
+
+// Search order: current theme, its ancestors, hicolor last
+inline QStringList iconThemes(const QString &current) {
+    QStringList t;
+    addThemeChain(current, t);
+    t << "hicolor";
+    return t;
+}
+
+// Theme roots, their icon-theme.cache (touched by the dpkg trigger on
+// every icon install) and the pixmaps fallback directory.
+inline QStringList watchedPaths(const QString &theme) {
+    QStringList out;
+    for (const QString &b : iconBases())
+        for (const QString &t : iconThemes(theme))
+            out << b + "/" + t << b + "/" + t + "/icon-theme.cache";
+    out << "/usr/share/pixmaps";
+    return out;
+}
+
+inline QVector<WospAppDb::DirStamp> stamps(const QString &theme) {
+    QVector<WospAppDb::DirStamp> out;
+    for (const QString &p : watchedPaths(theme)) {
+        QByteArray b = QFile::encodeName(p);
+        out.append({b, WospAppDb::mtimeNs(b)});
+    }
+    return out;
+}
+
+/* ───────────────────────── Resolving ───────────────────────── */
+
+// Lower is better: exact raster size, then scalable, then downscaled
+// larger rasters, then upscaled smaller ones.
+inline int sizeScore(const QString &path, int size) {
+    for (const QString &part : path.split('/')) {
+        if (part == "scalable") return 1;
+        int x = part.indexOf('x');
+        if (x <= 0) continue;
+        bool ok = false;
+        int dim = part.left(x).toInt(&ok);
+        if (!ok) continue;
+        if (dim == size) return 0;
+        return dim > size ? 2 + (dim - size) : 1000 + (size - dim);
+    }
+    return 5000;
+}
+
+inline QHash<QString, QString> resolveFiles(const QStringList &names, const QString &theme, int size) {
+    QHash<QString, QString> best;
+    QHash<QString, int> bestScore;
+    QSet<QString> wanted(names.begin(), names.end());
+
+    for (const QString &n : names) {
+        if (n.startsWith('/') && QFileInfo::exists(n)) {
+            best.insert(n, n);
+            bestScore.insert(n, -1);
+        }
+    }
+
+    QStringList themes = iconThemes(theme);
+    for (int ti = 0; ti < themes.size(); ++ti) {
+        for (const QString &b : iconBases()) {
+            QDirIterator it(b + "/" + themes[ti], {"*.png","*.svg","*.xpm"},
+                            QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                QString f = it.next();
+                QString n = it.fileInfo().completeBaseName();
+                if (!wanted.contains(n)) continue;
+
+                int score = ti * 10000 + sizeScore(f, size);
+                if (!bestScore.contains(n) || score < bestScore.value(n)) {
+                    best.insert(n, f);
+                    bestScore.insert(n, score);
+                }
+            }
+        }
+    }
+
+    for (const QString &n : names) {
+        if (best.contains(n)) continue;
+        for (const char *ext : {".png", ".svg", ".xpm"}) {
+            QString f = "/usr/share/pixmaps/" + n + ext;
+            if (QFileInfo::exists(f)) { best.insert(n, f); break; }
+        }
+    }
+    return best;
+}
+
+// QImage-only so it is safe off the GUI thread.
+inline QImage rasterize(const QString &file, int size) {
+    QImageReader r(file);
+    QSize src = r.size();
+    if (src.isValid() && (src.width() > size || src.height() > size || file.endsWith(".svg")))
+        r.setScaledSize(src.scaled(size, size, Qt::KeepAspectRatio));
+
+    QImage img = r.read();
+    if (img.isNull()) return img;
+    if (img.width() > size || img.height() > size)
+        img = img.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    QImage out(size, size, QImage::Format_ARGB32_Premultiplied);
+    out.fill(Qt::transparent);
+    QPainter p(&out);
+    p.drawImage((size - img.width()) / 2, (size - img.height()) / 2, img);
+    p.end();
+    return out;
+}
+
+inline int compareKey(const char *s, quint32 len, const QByteArray &key) {
+    int c = std::memcmp(s, key.constData(), std::min<size_t>(len, size_t(key.size())));
+    if (c) return c;
+    return int(len) - key.size();
+}
+
+/* ───────────────────────── Atlas file ─────────────────────────
+   header  : magic[8] u32 version u32 size u32 stampCount
+             u32 entryCount u32 slotCount u32 pixelOffset
+   stamps  : i64 mtimeNs str path
+   offsets : u32 entryOffset[entryCount]   (file-relative)
+   entries : str name str file i32 slot    (sorted by name bytes)
+   pixels  : slotCount * size*size*4, 16-byte aligned              */
+
+inline bool buildAtlas(const QStringList &names, const QString &theme, int size) {
+    QVector<WospAppDb::DirStamp> st = stamps(theme);
+    QHash<QString, QString> files = resolveFiles(names, theme, size);
+
+    QList<QByteArray> keys;
+    for (const QString &n : QSet<QString>(names.begin(), names.end()))
+        if (!n.isEmpty()) keys << n.toUtf8();
+    std::sort(keys.begin(), keys.end(), [](const QByteArray &a, const QByteArray &b) {
+        return compareKey(a.constData(), quint32(a.size()), b) < 0;
+    });
+
+    QByteArray stampBytes, entryBytes, pixels;
+    for (const WospAppDb::DirStamp &d : st) {
+        WospAppDb::putI64(stampBytes, d.mtimeNs);
+        WospAppDb::putStr(stampBytes, d.path);
+    }
+
+    const int slotBytes = size * size * 4;
+    quint32 headerSize = 8 + 6 * 4;
+    quint32 entriesAt = headerSize + quint32(stampBytes.size()) + quint32(keys.size()) * 4;
+
+    QByteArray offsets;
+    qint32 slots = 0;
+    for (const QByteArray &k : keys) {
+        WospAppDb::putU32(offsets, entriesAt + quint32(entryBytes.size()));
+
+        QString file = files.value(QString::fromUtf8(k));
+        qint32 slot = NO_ICON;
+        if (!file.isEmpty()) {
+            QImage img = rasterize(file, size);
+            if (!img.isNull()) {
+                slot = slots++;
+                for (int y = 0; y < size; ++y)
+                    pixels.append(reinterpret_cast<const char*>(img.constScanLine(y)), size * 4);
+            }
+        }
+
+        WospAppDb::putStr(entryBytes, k);
+        WospAppDb::putStr(entryBytes, file);
+        WospAppDb::putU32(entryBytes, quint32(slot));
+    }
+
+    quint32 pixelOffset = entriesAt + quint32(entryBytes.size());
+    pixelOffset = (pixelOffset + 15) & ~15u;
+
+    QByteArray b;
+    b.reserve(int(pixelOffset) + slots * slotBytes);
+    b.append(MAGIC, 8);
+    WospAppDb::putU32(b, VERSION);
+    WospAppDb::putU32(b, quint32(size));
+    WospAppDb::putU32(b, quint32(st.size()));
+    WospAppDb::putU32(b, quint32(keys.size()));
+    WospAppDb::putU32(b, quint32(slots));
+    WospAppDb::putU32(b, pixelOffset);
+    b.append(stampBytes);
+    b.append(offsets);
+    b.append(entryBytes);
+    b.append(QByteArray(int(pixelOffset) - b.size(), '\0'));
+    b.append(pixels);
+
+    QString path = atlasPath(size);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(b);
+    return f.commit();
+}
+
+/* ───────────────────────── Cache ───────────────────────── */
+
+class Cache : public QObject {
+public:
+    std::function<void()> onUpdated;   // GUI thread, after each rebuild
+
+    explicit Cache(int size, QObject *parent = nullptr)
+        : QObject(parent), m_size(size), m_theme(QIcon::themeName())
+    {
+        m_rebuild.setSingleShot(true);
+        QObject::connect(&m_rebuild, &QTimer::timeout, this, [this]{ rebuild(); });
+
+        // Theme changes are batched; package installs touch many files
+        auto themeChanged = [this]{ m_stale = true; m_rebuild.start(2000); };
+        QObject::connect(&m_watch, &QFileSystemWatcher::directoryChanged, this, themeChanged);
+        QObject::connect(&m_watch, &QFileSystemWatcher::fileChanged, this, themeChanged);
+        rewatch();
+
+        remap();
+    }
+
+    ~Cache() override {
+        if (m_worker) m_worker->wait();
+        unmap();
+    }
+
+    // Atlas pixmap, or a null pixmap while the name is unknown/unresolved.
+    QPixmap pixmap(const QString &name) {
+        if (name.isEmpty()) return {};
+        auto it = m_pix.constFind(name);
+        if (it != m_pix.constEnd()) return *it;
+
+        qint32 slot = lookup(name.toUtf8());
+        if (slot == UNKNOWN) {
+            if (!m_wanted.contains(name)) { m_wanted.insert(name); m_rebuild.start(200); }
+            return {};
+        }
+
+        QPixmap pix;
+        if (slot >= 0) {
+            const uchar *px = reinterpret_cast<const uchar*>(m_map) + m_pixelOffset
+                            + size_t(slot) * m_size * m_size * 4;
+            pix = QPixmap::fromImage(QImage(px, m_size, m_size, m_size * 4,
+                                            QImage::Format_ARGB32_Premultiplied));
+        }
+        m_pix.insert(name, pix);
+        return pix;
+    }
+
+    // Declare the full set of names in use; rebuilds if any are missing.
+    void request(const QStringList &names) {
+        bool missing = m_stale;
+        for (const QString &n : names) {
+            if (n.isEmpty()) continue;
+            m_wanted.insert(n);
+            if (lookup(n.toUtf8()) == UNKNOWN) missing = true;
+        }
+        if (missing) m_rebuild.start(200);
+    }
+
+private:
+    int m_size;
+    QString m_theme;
+    const char *m_map = nullptr;
+    size_t m_mapSize = 0;
+    quint32 m_entryCount = 0;
+    quint32 m_slotCount = 0;
+    quint32 m_pixelOffset = 0;
+    const char *m_offsets = nullptr;
+    bool m_stale = false;
+    bool m_again = false;
+
+    QHash<QString, QPixmap> m_pix;
+    QSet<QString> m_wanted;
+    QThread *m_worker = nullptr;
+    QTimer m_rebuild;
+    QFileSystemWatcher m_watch;
+
+    void unmap() {
+        if (m_map) ::munmap(const_cast<char*>(m_map), m_mapSize);
+        m_map = nullptr;
+        m_mapSize = 0;
+        m_entryCount = m_slotCount = m_pixelOffset = 0;
+        m_offsets = nullptr;
+    }
+
+    void remap() {
+        unmap();
+        m_pix.clear();
+        m_stale = true;
+
+        QByteArray path = QFile::encodeName(atlasPath(m_size));
+        int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < 32) { ::close(fd); return; }
+        void *map = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return;
+
+        m_map = static_cast<const char*>(map);
+        m_mapSize = size_t(st.st_size);
+
+        WospAppDb::Cursor c{m_map + 8, m_map + m_mapSize};
+        bool ok = std::memcmp(m_map, MAGIC, 8) == 0 && c.u32() == VERSION
+               && c.u32() == quint32(m_size);
+        quint32 stampCount = c.u32();
+        quint32 entryCount = c.u32();
+        quint32 slotCount = c.u32();
+        quint32 pixelOffset = c.u32();
+
+        bool fresh = true;
+        for (quint32 i = 0; ok && c.ok && i < stampCount; ++i) {
+            qint64 stamp = c.i64();
+            quint32 len;
+            const char *s = c.raw(len);
+            fresh &= WospAppDb::mtimeNs(QByteArray(s, int(len))) == stamp;
+        }
+
+        quint64 pixelEnd = quint64(pixelOffset) + quint64(slotCount) * m_size * m_size * 4;
+        ok = ok && c.ok && quint64(c.end - c.p) >= quint64(entryCount) * 4 && pixelEnd <= m_mapSize;
+        if (!ok) { unmap(); return; }
+
+        m_offsets = c.p;
+        m_entryCount = entryCount;
+        m_slotCount = slotCount;
+        m_pixelOffset = pixelOffset;
+        m_stale = !fresh;   // stale tables are still served until rebuilt
+    }
+
+    qint32 lookup(const QByteArray &key) const {
+        int lo = 0, hi = int(m_entryCount) - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            quint32 off;
+            std::memcpy(&off, m_offsets + size_t(mid) * 4, 4);
+            if (off >= m_mapSize) return UNKNOWN;
+
+            WospAppDb::Cursor c{m_map + off, m_map + m_mapSize};
+            quint32 len;
+            const char *s = c.raw(len);
+            if (!c.ok) return UNKNOWN;
+
+            int cmp = compareKey(s, len, key);
+            if (cmp == 0) {
+                c.raw(len);                       // resolved file
+                qint32 slot = qint32(c.u32());
+                if (!c.ok || slot >= qint32(m_slotCount)) return NO_ICON;
+                return slot;
+            }
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return UNKNOWN;
+    }
+
+    void rewatch() {
+        if (!m_watch.files().isEmpty()) m_watch.removePaths(m_watch.files());
+        if (!m_watch.directories().isEmpty()) m_watch.removePaths(m_watch.directories());
+        for (const QString &p : watchedPaths(m_theme))
+            if (QFileInfo::exists(p)) m_watch.addPath(p);
+    }
+
+    void rebuild() {
+        if (m_worker) { m_again = true; return; }
+        if (m_wanted.isEmpty()) return;
+
+        QStringList names = m_wanted.values();
+        QString theme = m_theme;
+        int size = m_size;
+
+        m_worker = QThread::create([names, theme, size]{ buildAtlas(names, theme, size); });
+        QObject::connect(m_worker, &QThread::finished, this, [this]{
+            m_worker->deleteLater();
+            m_worker = nullptr;
+
+            remap();
+            rewatch();   // cache files are replaced by rename
+            if (onUpdated) onUpdated();
+
+            if (m_again) { m_again = false; m_rebuild.start(200); }
+        });
+        m_worker->start(QThread::LowPriority);
+    }
+};
+
+} // namespace WospIcons
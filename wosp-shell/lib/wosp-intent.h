@@ -0,0 +1,199 @@
+// wosp-intent.h
+// In-memory search index behind the "Type your intent…" bar.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Items come from source callbacks (apps, recents, settings pages, folders)
+// that run together on a worker thread whenever invalidate() is called; the
+// finished list replaces the live one in one swap. search() ranks items by
+// prefix, word-prefix, substring and then subsequence ("fzy"-style) match
+// on a case-folded key. Typing more characters only re-scores the previous
+// hits. Scoring runs in slices of FRAME_BUDGET_MS so a keystroke never
+// stalls a frame; onResults fires once the ranking is complete.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <functional>
+
+namespace WospIntent {
+
+static const int FRAME_BUDGET_MS = 8;
+static const int REBUILD_DELAY_MS = 500;   // sources tend to change in bursts
+
+enum Kind { App, Setting, Folder, Recent };
+
+struct Item {
+    Kind kind;
+    QString title;    // pill text
+    QString target;   // exec line, settings module, path or URL
+    QString key;      // extra match terms; the index folds in the title
+};
+
+using Source = std::function<QVector<Item>()>;
+
+// Higher is better, < 0 is no match. q and key are already case-folded.
+inline int score(const QString &q, const QString &key) {
+    if (key.startsWith(q)) return 1000 - key.size();
+
+    int at = key.indexOf(q);
+    if (at > 0) {
+        QChar before = key.at(at - 1);
+        bool wordStart = !before.isLetterOrNumber();
+        return (wordStart ? 800 : 600) - at;
+    }
+
+    // Subsequence: every query char in order; contiguous runs score higher
+    int pos = 0, gaps = 0, last = -1;
+    for (QChar c : q) {
+        pos = key.indexOf(c, pos);
+        if (pos < 0) return -1;
+        if (last >= 0 && pos != last + 1) ++gaps;
+        last = pos++;
+    }
+    return 400 - gaps * 20 - last;
+}
+
+class Index : public QObject {
+public:
+    std::function<void(const QVector<Item>&)> onResults;
+
+    explicit Index(QObject *parent = nullptr) : QObject(parent) {
+        m_rebuild.setSingleShot(true);
+        m_rebuild.setInterval(REBUILD_DELAY_MS);
+        QObject::connect(&m_rebuild, &QTimer::timeout, this, [this]{ rebuild(); });
+    }
+
+    ~Index() override {
+        if (m_worker) m_worker->wait();
+    }
+
+    void addSource(Source s) { m_sources.append(std::move(s)); }
+
+    // Schedule a background rebuild from all sources
+    void invalidate() { m_rebuild.start(); }
+
+    void rebuildNow() { rebuild(); }
+
+    void setLimit(int n) { m_limit = n; }
+
+    void search(const QString &text) {
+        QString q = text.trimmed().toCaseFolded();
+        ++m_gen;
+        m_pos = 0;
+        m_hits.clear();
+
+        if (q.isEmpty()) {
+            m_query.clear();
+            m_prevQuery.clear();
+            if (onResults) onResults({});
+            return;
+        }
+
+        bool narrow = !m_prevQuery.isEmpty() && q.startsWith(m_prevQuery);
+        m_query = q;
+        m_candidates.clear();
+        if (narrow) {
+            for (const Hit &h : m_prevHits) m_candidates.append(h.index);
+        } else {
+            m_candidates.resize(m_items.size());
+            for (int i = 0; i < m_items.size(); ++i) m_candidates[i] = i;
+        }
+        step(m_gen);
+    }
+
+private:
+    struct Hit {
+        int index;
+        int score;
+    };
+
+    QVector<Source> m_sources;
+    QVector<Item> m_items;
+    QThread *m_worker = nullptr;
+    QVector<Item> m_built;
+    bool m_rebuildAgain = false;
+    QTimer m_rebuild;
+
+    QString m_query, m_prevQuery;
+    QVector<int> m_candidates;
+    QVector<Hit> m_hits, m_prevHits;
+    int m_pos = 0;
+    int m_gen = 0;
+    int m_limit = 6;
+
+    void step(int gen) {
+        if (gen != m_gen) return;
+
+        QElapsedTimer t;
+        t.start();
+        while (m_pos < m_candidates.size()) {
+            int i = m_candidates[m_pos++];
+            int s = score(m_query, m_items[i].key);
+            if (s >= 0) m_hits.append({i, s + kindBias(m_items[i].kind)});
+
+            if ((m_pos & 63) == 0 && t.elapsed() >= FRAME_BUDGET_MS) {
+                QTimer::singleShot(0, this, [this, gen]{ step(gen); });
+                return;
+            }
+        }
+
+        std::stable_sort(m_hits.begin(), m_hits.end(),
+                         [](const Hit &a, const Hit &b){ return a.score > b.score; });
+        m_prevQuery = m_query;
+        m_prevHits = m_hits;
+
+        QVector<Item> out;
+        for (int k = 0; k < m_hits.size() && k < m_limit; ++k)
+            out.append(m_items[m_hits[k].index]);
+        if (onResults) onResults(out);
+    }
+
+    static int kindBias(Kind k) {
+        switch (k) {
+        case App:     return 30;
+        case Setting: return 20;
+        case Folder:  return 10;
+        default:      return 0;
+        }
+    }
+
+    void rebuild() {
+        if (m_worker) { m_rebuildAgain = true; return; }
+
+        QVector<Source> sources = m_sources;
+        m_worker = QThread::create([this, sources]{
+            QVector<Item> items;
+            for (const Source &src : sources) items += src();
+            for (Item &it : items) {
+                it.key = (it.key.isEmpty() ? it.title : it.title + " " + it.key).toCaseFolded();
+            }
+            m_built = items;
+        });
+        QObject::connect(m_worker, &QThread::finished, this, [this]{
+            m_worker->deleteLater();
+            m_worker = nullptr;
+
+            m_items = m_built;
+            m_built.clear();
+
+            // Hit indices refer to the old list: re-run the live query
+            m_prevQuery.clear();
+            m_prevHits.clear();
+            if (!m_query.isEmpty()) search(m_query);
+
+            if (m_rebuildAgain) {
+                m_rebuildAgain = false;
+                invalidate();
+            }
+        });
+        m_worker->start(QThread::LowPriority);
+    }
+};
+
+} // namespace WospIntent
@@ -0,0 +1,184 @@
+// wosp-launchstats.h
+// Per-app launch statistics (frecency) and predictive prefetch.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Each launch adds 1 to an app's score after decaying the old score with
+// a 3 day half-life, so frequent *and* recent apps rank first. A few
+// seconds after a launch the file-backed mappings of the new process
+// (its executable and shared libraries) are recorded from /proc/<pid>/maps,
+// replacing the previous list so library upgrades never leave it stale.
+// prefetch() replays those lists for the top apps with
+// posix_fadvise(WILLNEED) on a worker thread, so they start warm.
+// Stored in ~/.config/Alternix/wosp-shell-launches.conf through the
+// write-behind WospConfig::Store, in the layout QSettings used to write.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "wosp-config.h"
+
+class WospLaunchStats : public QObject {
+public:
+    static constexpr double HALF_LIFE_S = 3 * 24 * 3600.0;
+    static constexpr int MAPS_DELAY_MS = 5000;   // let the app finish loading
+    static constexpr int MAX_FILES = 64;          // per app
+
+    explicit WospLaunchStats(QObject *parent = nullptr)
+        : QObject(parent),
+          m_store(WospConfig::Store::open(
+              QDir::homePath() + "/.config/Alternix/wosp-shell-launches.conf"))
+    {
+        for (const QString &key : m_store->keys()) {
+            if (!key.endsWith("/score")) continue;
+            QString id = key.left(key.size() - 6);
+            m_stats.insert(id, {
+                m_store->value(key).toDouble(),
+                m_store->value(id + "/last").toLongLong(),
+                splitFiles(m_store->value(id + "/files"))
+            });
+        }
+    }
+
+    ~WospLaunchStats() override {
+        if (m_worker) m_worker->wait();
+    }
+
+    double frecency(const QString &id, qint64 now = QDateTime::currentSecsSinceEpoch()) const {
+        auto it = m_stats.constFind(id);
+        if (it == m_stats.constEnd()) return 0.0;
+        return it->score * std::pow(0.5, double(now - it->last) / HALF_LIFE_S);
+    }
+
+    void recordLaunch(const QString &id, const QString &program, qint64 pid) {
+        if (id.isEmpty()) return;
+        qint64 now = QDateTime::currentSecsSinceEpoch();
+
+        Stat &s = m_stats[id];
+        s.score = frecency(id, now) + 1.0;
+        s.last = now;
+
+        QString exe = QStandardPaths::findExecutable(program);
+        if (!exe.isEmpty() && !s.files.contains(exe)) s.files.prepend(exe);
+        save(id);
+
+        if (pid > 0) {
+            QTimer::singleShot(MAPS_DELAY_MS, this,
+                               [this, id, pid, exe]{ recordMappings(id, pid, exe); });
+        }
+    }
+
+    // Ids ordered by current frecency, best first
+    QStringList top(int n) const {
+        qint64 now = QDateTime::currentSecsSinceEpoch();
+        QStringList ids = m_stats.keys();
+        std::sort(ids.begin(), ids.end(), [&](const QString &a, const QString &b) {
+            return frecency(a, now) > frecency(b, now);
+        });
+        return ids.mid(0, n);
+    }
+
+    // Page in the recorded files of the top n apps off the GUI thread
+    void prefetch(int n) {
+        if (m_worker) return;
+
+        QStringList files;
+        for (const QString &id : top(n)) files += m_stats.value(id).files;
+        files.removeDuplicates();
+        if (files.isEmpty()) return;
+
+        m_worker = QThread::create([files]{
+            for (const QString &f : files) {
+                int fd = ::open(QFile::encodeName(f).constData(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) continue;
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                ::close(fd);
+            }
+        });
+        QObject::connect(m_worker, &QThread::finished, this, [this]{
+            m_worker->deleteLater();
+            m_worker = nullptr;
+        });
+        m_worker->start(QThread::IdlePriority);
+    }
+
+private:
+    struct Stat {
+        double score = 0.0;
+        qint64 last = 0;
+        QStringList files;   // executable first, then mapped libraries
+    };
+
+    QHash<QString, Stat> m_stats;
+    WospConfig::Store *m_store;
+    QThread *m_worker = nullptr;
+
+    // QSettings' string list layout: "a, b", items with spaces quoted
+    static QStringList splitFiles(const QString &v) {
+        QStringList out;
+        for (QString f : v.split(", ", Qt::SkipEmptyParts)) {
+            if (f.size() >= 2 && f.startsWith('"') && f.endsWith('"')) f = f.mid(1, f.size() - 2);
+            out << f;
+        }
+        return out;
+    }
+
+    static QString joinFiles(const QStringList &files) {
+        QStringList quoted;
+        for (const QString &f : files) quoted << (f.contains(' ') ? '"' + f + '"' : f);
+        return quoted.join(", ");
+    }
+
+    void save(const QString &id) {
+        const Stat &s = m_stats[id];
+        m_store->setValue(id + "/score", QString::number(s.score, 'g', 17));
+        m_store->setValue(id + "/last", QString::number(s.last));
+        m_store->setValue(id + "/files", joinFiles(s.files));
+    }
+
+    // Rebuilds the list from this run; old entries only survive (if they
+    // still exist) when the app is gone before its maps could be read
+    void recordMappings(const QString &id, qint64 pid, const QString &exe) {
+        Stat &s = m_stats[id];
+        QStringList files;
+        if (!exe.isEmpty()) files << exe;
+
+        QFile maps(QString("/proc/%1/maps").arg(pid));
+        if (maps.open(QIODevice::ReadOnly)) {
+            QSet<QString> seen(files.begin(), files.end());
+            for (const QByteArray &line : maps.readAll().split('\n')) {
+                int slash = line.indexOf('/');
+                if (slash < 0 || line.endsWith("(deleted)")) continue;
+                QString path = QString::fromLocal8Bit(line.mid(slash));
+                if (path.startsWith("/dev/") || path.startsWith("/memfd:")) continue;
+                if (seen.contains(path)) continue;
+                seen.insert(path);
+                files.append(path);
+                if (files.size() >= MAX_FILES) break;
+            }
+        } else {
+            for (const QString &f : s.files)
+                if (!files.contains(f) && QFileInfo::exists(f)) files.append(f);
+        }
+
+        if (files == s.files) return;
+        s.files = files;
+        save(id);
+    }
+};
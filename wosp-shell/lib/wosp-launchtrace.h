@@ -0,0 +1,246 @@
+// wosp-launchtrace.h
+// Tap-to-first-window launch latency tracing.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary, after Qt.
+//
+// Callers start a QElapsedTimer before spawning and hand it to
+// Tracer::begin() with the PID, so the spawn itself is measured. The
+// tracer then selects SubstructureNotify + PropertyChange on the root
+// window and waits for the first MapNotify or new _NET_CLIENT_LIST entry
+// whose _NET_WM_PID is the spawned PID (or one of its descendants).
+// Windows of the tracing process itself (overlays, popups) never count.
+// The latency is added to a per-app log2 histogram in
+// ~/.config/Alternix/wosp-launch-latency.conf, shared by every process
+// that traces. Root events are only selected while a launch is pending.
+// `wosp-shell --launch-stats` prints report().
+// Link with -lX11.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSet>
+#include <QFile>
+#include <QSettings>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include "wosp-x11.h"
+
+namespace WospLaunchTrace {
+
+static const int BUCKETS = 8;          // <100ms <200 <400 ... <6.4s, slower
+static const int TIMEOUT_MS = 30000;   // give up on apps that never map
+
+inline int bucketFor(qint64 ms) {
+    int b = 0;
+    for (qint64 limit = 100; b < BUCKETS - 1 && ms >= limit; limit *= 2) ++b;
+    return b;
+}
+
+inline QString bucketLabel(int b) {
+    if (b == BUCKETS - 1) return QString(">=%1ms").arg(100 << (BUCKETS - 2));
+    return QString("<%1ms").arg(100 << b);
+}
+
+inline void record(const QString &id, qint64 ms) {
+    QSettings s("Alternix", "wosp-launch-latency");
+    s.beginGroup(id);
+    QStringList hist = s.value("hist").toStringList();
+    while (hist.size() < BUCKETS) hist << "0";
+    int b = bucketFor(ms);
+    hist[b] = QString::number(hist[b].toLongLong() + 1);
+    s.setValue("hist", hist);
+    s.setValue("count", s.value("count", 0).toLongLong() + 1);
+    s.setValue("sum_ms", s.value("sum_ms", 0).toLongLong() + ms);
+    s.setValue("last_ms", ms);
+    s.endGroup();
+}
+
+inline QString report() {
+    QSettings s("Alternix", "wosp-launch-latency");
+    QString out;
+    QStringList ids = s.childGroups();
+    if (ids.isEmpty()) return "No launches recorded yet.\n";
+
+    for (const QString &id : ids) {
+        s.beginGroup(id);
+        qint64 count = s.value("count", 0).toLongLong();
+        qint64 sum = s.value("sum_ms", 0).toLongLong();
+        QStringList hist = s.value("hist").toStringList();
+        out += QString("%1\n  launches %2   avg %3ms   last %4ms\n")
+                   .arg(id).arg(count).arg(count ? sum / count : 0)
+                   .arg(s.value("last_ms", 0).toLongLong());
+        for (int b = 0; b < BUCKETS && b < hist.size(); ++b) {
+            qint64 n = hist[b].toLongLong();
+            if (!n) continue;
+            out += QString("  %1 %2 %3\n").arg(bucketLabel(b), 9).arg(n, 5)
+                       .arg(QString(int(std::min<qint64>(n, 40)), '#'));
+        }
+        s.endGroup();
+    }
+    return out;
+}
+
+inline qint64 parentPid(qint64 pid) {
+    QFile f(QString("/proc/%1/stat").arg(pid));
+    if (!f.open(QIODevice::ReadOnly)) return 0;
+    QByteArray st = f.readAll();
+    int close = st.lastIndexOf(')');          // comm may contain spaces
+    QList<QByteArray> fields = st.mid(close + 2).split(' ');
+    return fields.size() > 1 ? fields[1].toLongLong() : 0;
+}
+
+// Apps forked by osm-zygote are not our descendants; the zygote records
+// the osm-launch client that asked for each child in
+// $XDG_RUNTIME_DIR/osm-zygote/<pid> instead.
+inline qint64 launchParent(qint64 pid) {
+    QString dir = qEnvironmentVariable("XDG_RUNTIME_DIR");
+    if (dir.isEmpty()) dir = QString("/run/user/%1").arg(getuid());
+    QFile f(QString("%1/osm-zygote/%2").arg(dir).arg(pid));
+    if (!f.open(QIODevice::ReadOnly)) return 0;
+    return f.readAll().trimmed().toLongLong();
+}
+
+inline bool descendsFrom(qint64 pid, qint64 ancestor) {
+    for (int depth = 0; pid > 1 && depth < 16; ++depth) {
+        if (pid == ancestor) return true;
+        qint64 zygoteClient = launchParent(pid);
+        pid = zygoteClient > 0 ? zygoteClient : parentPid(pid);
+    }
+    return false;
+}
+
+class Tracer : public QObject {
+public:
+    explicit Tracer(QObject *parent = nullptr) : QObject(parent) {
+        m_dpy = XOpenDisplay(nullptr);
+        if (!m_dpy) return;
+
+        m_root = DefaultRootWindow(m_dpy);
+        m_clientList = XInternAtom(m_dpy, "_NET_CLIENT_LIST", 0);
+        m_wmPid = XInternAtom(m_dpy, "_NET_WM_PID", 0);
+
+        m_sn = new QSocketNotifier(ConnectionNumber(m_dpy), QSocketNotifier::Read, this);
+        QObject::connect(m_sn, &QSocketNotifier::activated, this, [this]{ drain(); });
+    }
+
+    ~Tracer() override {
+        if (m_dpy) XCloseDisplay(m_dpy);
+    }
+
+    // since: started right before the spawn. matchAny: launchers like
+    // xdg-open hand off to an unrelated process, so the first new managed
+    // client window of another process is taken instead of a PID match.
+    void begin(const QString &id, qint64 pid, const QElapsedTimer &since, bool matchAny = false) {
+        if (!m_dpy || id.isEmpty()) return;
+
+        if (m_pending.isEmpty()) {
+            m_known = clientList();
+            XSelectInput(m_dpy, m_root, SubstructureNotifyMask | PropertyChangeMask);
+            XFlush(m_dpy);
+        }
+
+        m_pending.append(Pending{++m_seq, id, pid, matchAny, since});
+        int seq = m_seq;
+
+        QTimer::singleShot(TIMEOUT_MS, this, [this, seq]{ finish(seq, -1); });
+    }
+
+private:
+    struct Pending {
+        int seq;
+        QString id;
+        qint64 pid;
+        bool any;
+        QElapsedTimer timer;
+    };
+
+    Display *m_dpy = nullptr;
+    Window m_root = 0;
+    Atom m_clientList = 0;
+    Atom m_wmPid = 0;
+    QSocketNotifier *m_sn = nullptr;
+    QList<Pending> m_pending;
+    QSet<Window> m_known;
+    int m_seq = 0;
+
+    QSet<Window> clientList() {
+        QSet<Window> out;
+        Atom type; int fmt; unsigned long n = 0, after = 0;
+        unsigned char *data = nullptr;
+        if (XGetWindowProperty(m_dpy, m_root, m_clientList, 0, 4096, 0, XA_WINDOW,
+                               &type, &fmt, &n, &after, &data) == 0 && data) {
+            Window *w = reinterpret_cast<Window*>(data);
+            for (unsigned long i = 0; i < n; ++i) out.insert(w[i]);
+        }
+        if (data) XFree(data);
+        return out;
+    }
+
+    qint64 windowPid(Window w) {
+        qint64 pid = 0;
+        Atom type; int fmt; unsigned long n = 0, after = 0;
+        unsigned char *data = nullptr;
+        if (XGetWindowProperty(m_dpy, w, m_wmPid, 0, 1, 0, XA_CARDINAL,
+                               &type, &fmt, &n, &after, &data) == 0 && data && n == 1)
+            pid = qint64(*reinterpret_cast<unsigned long*>(data));
+        if (data) XFree(data);
+        return pid;
+    }
+
+    void drain() {
+        while (XPending(m_dpy)) {
+            XEvent ev;
+            XNextEvent(m_dpy, &ev);
+            if (m_pending.isEmpty()) continue;
+
+            if (ev.type == MapNotify) {
+                // Override-redirect popups and menus are never an app's window
+                if (!ev.xmap.override_redirect) windowMapped(ev.xmap.window, false);
+            } else if (ev.type == PropertyNotify && ev.xproperty.atom == m_clientList) {
+                QSet<Window> now = clientList();
+                for (Window w : now)
+                    if (!m_known.contains(w)) windowMapped(w, true);
+                m_known = now;
+            }
+        }
+    }
+
+    // managed: listed in _NET_CLIENT_LIST, i.e. a real top-level client
+    void windowMapped(Window w, bool managed) {
+        qint64 pid = 0;
+        {
+            // The window can be gone again before we ask
+            WospX11::ErrorTrap trap(m_dpy);
+            pid = windowPid(w);
+        }
+        if (pid == qint64(getpid())) return;
+        for (const Pending &p : m_pending) {
+            if ((pid > 0 && descendsFrom(pid, p.pid)) || (p.any && managed)) {
+                finish(p.seq, p.timer.elapsed());
+                return;
+            }
+        }
+    }
+
+    void finish(int seq, qint64 ms) {
+        auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                               [seq](const Pending &p){ return p.seq == seq; });
+        if (it == m_pending.end()) return;
+        if (ms >= 0) record(it->id, ms);
+        m_pending.erase(it);
+
+        if (m_pending.isEmpty()) {
+            XSelectInput(m_dpy, m_root, NoEventMask);
+            XFlush(m_dpy);
+        }
+    }
+};
+
+} // namespace WospLaunchTrace
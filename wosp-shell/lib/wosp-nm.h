@@ -0,0 +1,298 @@
+// wosp-nm.h
+// Async NetworkManager client (Wi-Fi side) over sd-bus.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Client keeps a cached State: radio switch, Wi-Fi interface, active SSID,
+// IPv4 address/prefix/gateway, DNS servers and visible access points. It
+// is filled by GetAll calls at start-up and then kept current from
+// NetworkManager's PropertiesChanged signals; listeners run once per
+// event-loop turn after any change. Nothing here waits for a reply.
+//
+// WOSP_NM_BUS=session (or a bus address) talks to a NetworkManager on
+// another bus instead of the system one, see wosp-sdbus.h.
+// Link with $(pkg-config --libs libsystemd).
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+#include "wosp-sdbus.h"
+
+namespace WospNm {
+
+static const char *SERVICE  = "org.freedesktop.NetworkManager";
+static const char *NM_PATH  = "/org/freedesktop/NetworkManager";
+static const char *NM_IFACE = "org.freedesktop.NetworkManager";
+static const char *DEVICE   = "org.freedesktop.NetworkManager.Device";
+static const char *WIRELESS = "org.freedesktop.NetworkManager.Device.Wireless";
+static const char *AP       = "org.freedesktop.NetworkManager.AccessPoint";
+static const char *IP4      = "org.freedesktop.NetworkManager.IP4Config";
+static const uint DEVICE_TYPE_WIFI = 2;
+
+struct AccessPoint {
+    QString path;
+    QString ssid;
+    int strength = 0;   // 0..100
+    bool secured = false;
+};
+
+struct State {
+    bool available = false;        // NetworkManager answered
+    bool wirelessEnabled = false;
+    QString iface;                 // empty without a Wi-Fi device
+    QString ssid;                  // empty when not associated
+    QString address;               // first IPv4 address
+    int prefix = 0;
+    QString gateway;
+    QStringList dns;
+    QList<AccessPoint> accessPoints;   // one per SSID, strongest first
+};
+
+class Client : public QObject {
+public:
+    explicit Client(QObject *parent = nullptr)
+        : QObject(parent), m_bus("WOSP_NM_BUS")
+    {
+        m_notify.setSingleShot(true);
+        m_notify.setInterval(0);
+        QObject::connect(&m_notify, &QTimer::timeout, this, [this]{
+            for (const auto &fn : m_listeners) fn();
+        });
+
+        m_bus.match(SERVICE, nullptr, WospBus::PROPERTIES, "PropertiesChanged",
+                    [this](sd_bus_message *m){ propertiesChanged(m); });
+        // NetworkManager restarted (or started after us)
+        m_bus.match("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+                    "NameOwnerChanged", [this](sd_bus_message *m){
+                        if (WospBus::readAll(m).value(0).toString() == SERVICE) refresh();
+                    });
+        refresh();
+    }
+
+    const State& state() const { return m_state; }
+
+    void listen(std::function<void()> fn) { m_listeners.append(std::move(fn)); }
+
+    // Re-read everything; normally only needed once
+    void refresh() {
+        m_wifi.clear();
+        m_activeAp.clear();
+        m_ip4.clear();
+        m_aps.clear();
+        State fresh;
+        fresh.available = m_state.available;
+        m_state = fresh;
+
+        m_bus.getAll(SERVICE, NM_PATH, NM_IFACE, [this](bool ok, const QVariantMap &p) {
+            m_state.available = ok;
+            m_state.wirelessEnabled = p.value("WirelessEnabled").toBool();
+            changed();
+        });
+        m_bus.call(SERVICE, NM_PATH, NM_IFACE, "GetDevices", [this](sd_bus_message *m) {
+            if (!WospBus::errorOf(m).isEmpty()) return;
+            for (const QVariant &d : WospBus::readAll(m).value(0).toList()) {
+                QString dev = d.toString();
+                m_bus.getAll(SERVICE, dev, DEVICE, [this, dev](bool ok, const QVariantMap &p) {
+                    if (!ok || !m_wifi.isEmpty()) return;
+                    if (p.value("DeviceType").toUInt() != DEVICE_TYPE_WIFI) return;
+                    adoptWifi(dev, p);
+                });
+            }
+        });
+        changed();
+    }
+
+    void setWirelessEnabled(bool on) {
+        m_bus.setProperty(SERVICE, NM_PATH, NM_IFACE, "WirelessEnabled", "b", int(on));
+    }
+
+    void requestScan() {
+        if (m_wifi.isEmpty()) return;
+        m_bus.call(SERVICE, m_wifi.toUtf8().constData(), WIRELESS, "RequestScan",
+                   [](sd_bus_message*) {}, "a{sv}", 0u);
+    }
+
+    // Joins the strongest AP named `ssid`. An empty psk activates a saved
+    // profile (or an open network); done() gets an error text or "". Like
+    // nmcli, only the psk is sent: NetworkManager picks wpa-psk or sae
+    // from the AP's flags, so WPA3 and transition networks work too.
+    void connectTo(const QString &ssid, const QString &psk,
+                   std::function<void(const QString&)> done) {
+        const AccessPoint *ap = nullptr;
+        for (const AccessPoint &a : m_state.accessPoints)
+            if (a.ssid == ssid) { ap = &a; break; }
+        if (!ap || m_wifi.isEmpty()) { done("Network not in range"); return; }
+
+        QByteArray dev = m_wifi.toUtf8(), apPath = ap->path.toUtf8();
+        auto result = [done](sd_bus_message *m){ done(WospBus::errorOf(m)); };
+
+        if (!psk.isEmpty()) {
+            QByteArray key = psk.toUtf8();
+            m_bus.call(SERVICE, NM_PATH, NM_IFACE, "AddAndActivateConnection", result,
+                       "a{sa{sv}}oo",
+                       1u, "802-11-wireless-security",
+                           1u, "psk", "s", key.constData(),
+                       dev.constData(), apPath.constData());
+            return;
+        }
+
+        bool secured = ap->secured;
+        m_bus.call(SERVICE, NM_PATH, NM_IFACE, "ActivateConnection",
+            [this, done, secured, dev, apPath](sd_bus_message *m) {
+                QString err = WospBus::errorOf(m);
+                if (err.isEmpty() || secured) { done(err); return; }
+                // No saved profile for an open network: let NM create one
+                m_bus.call(SERVICE, NM_PATH, NM_IFACE, "AddAndActivateConnection",
+                           [done](sd_bus_message *r){ done(WospBus::errorOf(r)); },
+                           "a{sa{sv}}oo", 0u, dev.constData(), apPath.constData());
+            },
+            "ooo", "/", dev.constData(), apPath.constData());
+    }
+
+private:
+    WospBus::Bus m_bus;
+    QTimer m_notify;
+    QList<std::function<void()>> m_listeners;
+    State m_state;
+
+    QString m_wifi, m_activeAp, m_ip4;
+    QHash<QString, AccessPoint> m_aps;   // by object path
+
+    void changed() { m_notify.start(); }
+
+    void adoptWifi(const QString &dev, const QVariantMap &p) {
+        m_wifi = dev;
+        m_state.iface = p.value("Interface").toString();
+        fetchIp4(p.value("Ip4Config").toString());
+
+        m_bus.getAll(SERVICE, dev, WIRELESS, [this, dev](bool ok, const QVariantMap &w) {
+            if (!ok || dev != m_wifi) return;
+            fetchActiveAp(w.value("ActiveAccessPoint").toString());
+            fetchAccessPoints(w.value("AccessPoints").toList());
+        });
+        changed();
+    }
+
+    void fetchActiveAp(const QString &path) {
+        m_activeAp = path;
+        m_state.ssid.clear();
+        changed();
+        if (path.isEmpty() || path == "/") return;
+
+        m_bus.getAll(SERVICE, path, AP, [this, path](bool ok, const QVariantMap &p) {
+            if (!ok || path != m_activeAp) return;
+            m_state.ssid = QString::fromUtf8(p.value("Ssid").toByteArray());
+            changed();
+        });
+    }
+
+    void fetchIp4(const QString &path) {
+        m_ip4 = path;
+        applyIp4({});
+        if (path.isEmpty() || path == "/") return;
+
+        m_bus.getAll(SERVICE, path, IP4, [this, path](bool ok, const QVariantMap &p) {
+            if (ok && path == m_ip4) applyIp4(p);
+        });
+    }
+
+    void applyIp4(const QVariantMap &p) {
+        QVariantMap first = p.value("AddressData").toList().value(0).toMap();
+        m_state.address = first.value("address").toString();
+        m_state.prefix = first.value("prefix").toInt();
+        m_state.gateway = p.value("Gateway").toString();
+
+        m_state.dns.clear();
+        for (const QVariant &ns : p.value("NameserverData").toList())
+            m_state.dns << ns.toMap().value("address").toString();
+        if (m_state.dns.isEmpty()) {
+            // NetworkManager < 1.14: network-order u32s
+            for (const QVariant &ns : p.value("Nameservers").toList()) {
+                uint a = ns.toUInt();
+                m_state.dns << QString("%1.%2.%3.%4").arg(a & 0xff).arg((a >> 8) & 0xff)
+                                                     .arg((a >> 16) & 0xff).arg(a >> 24);
+            }
+        }
+        changed();
+    }
+
+    void fetchAccessPoints(const QVariantList &paths) {
+        QHash<QString, AccessPoint> kept;
+        for (const QVariant &v : paths) {
+            QString path = v.toString();
+            if (m_aps.contains(path)) { kept.insert(path, m_aps.value(path)); continue; }
+
+            m_bus.getAll(SERVICE, path, AP, [this, path](bool ok, const QVariantMap &p) {
+                if (!ok) return;
+                AccessPoint ap;
+                ap.path = path;
+                updateAp(ap, p);
+                m_aps.insert(path, ap);
+                rebuildApList();
+            });
+        }
+        m_aps = kept;
+        rebuildApList();
+    }
+
+    static void updateAp(AccessPoint &ap, const QVariantMap &p) {
+        if (p.contains("Ssid")) ap.ssid = QString::fromUtf8(p.value("Ssid").toByteArray());
+        if (p.contains("Strength")) ap.strength = int(p.value("Strength").toUInt());
+        if (p.contains("Flags") && p.contains("WpaFlags") && p.contains("RsnFlags"))
+            ap.secured = (p.value("Flags").toUInt() & 0x1) || p.value("WpaFlags").toUInt()
+                      || p.value("RsnFlags").toUInt();
+    }
+
+    void rebuildApList() {
+        QHash<QString, AccessPoint> best;
+        for (const AccessPoint &ap : m_aps) {
+            if (ap.ssid.isEmpty()) continue;   // hidden networks
+            auto it = best.find(ap.ssid);
+            if (it == best.end() || it->strength < ap.strength) best.insert(ap.ssid, ap);
+        }
+        QList<AccessPoint> list = best.values();
+        std::sort(list.begin(), list.end(), [](const AccessPoint &a, const AccessPoint &b) {
+            return a.strength > b.strength;
+        });
+        m_state.accessPoints = list;
+        changed();
+    }
+
+    void propertiesChanged(sd_bus_message *m) {
+        QString path = QString::fromUtf8(sd_bus_message_get_path(m));
+        QVariantList args = WospBus::readAll(m);
+        QString iface = args.value(0).toString();
+        QVariantMap p = args.value(1).toMap();
+
+        if (path == NM_PATH && iface == NM_IFACE) {
+            if (p.contains("WirelessEnabled")) {
+                m_state.wirelessEnabled = p.value("WirelessEnabled").toBool();
+                changed();
+            }
+            if (p.contains("Devices") && m_wifi.isEmpty()) refresh();
+        } else if (path == m_wifi && iface == DEVICE) {
+            if (p.contains("Ip4Config")) fetchIp4(p.value("Ip4Config").toString());
+        } else if (path == m_wifi && iface == WIRELESS) {
+            if (p.contains("ActiveAccessPoint")) fetchActiveAp(p.value("ActiveAccessPoint").toString());
+            if (p.contains("AccessPoints")) fetchAccessPoints(p.value("AccessPoints").toList());
+        } else if (path == m_ip4 && iface == IP4) {
+            m_bus.getAll(SERVICE, path, IP4, [this, path](bool ok, const QVariantMap &all) {
+                if (ok && path == m_ip4) applyIp4(all);
+            });
+        } else if (iface == AP && m_aps.contains(path)) {
+            updateAp(m_aps[path], p);
+            if (path == m_activeAp && p.contains("Ssid"))
+                m_state.ssid = QString::fromUtf8(p.value("Ssid").toByteArray());
+            rebuildApList();
+        }
+    }
+};
+
+} // namespace WospNm
@@ -0,0 +1,202 @@
+// wosp-recents.h
+// Newest-first reader for ~/.local/share/recently-used.xbel.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// GTK appends bookmarks, so the head of the file holds the oldest ones.
+// newest() streams the file once with QXmlStreamReader, skipping each
+// bookmark's metadata, and keeps only a bounded min-heap of the N most
+// recent entries by max(modified, visited). XBEL stamps are ISO 8601 UTC,
+// so they are compared as strings without parsing. Results are cached on
+// the file's mtime and size and the cache is shared between threads. The
+// cache always holds the largest limit any caller asked for, so callers
+// with different limits share one parse instead of evicting each other.
+// Provider watches the file and re-reads it off the GUI thread.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QUrl>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QXmlStreamReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+#include <sys/stat.h>
+
+namespace WospRecents {
+
+inline QString xbelPath() {
+    return QDir::homePath() + "/.local/share/recently-used.xbel";
+}
+
+struct Stamp {
+    qint64 mtimeNs = -1;
+    qint64 size = -1;
+    bool operator==(const Stamp &o) const { return mtimeNs == o.mtimeNs && size == o.size; }
+};
+
+inline Stamp stampOf(const QString &path) {
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) != 0) return {};
+    return { qint64(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec, qint64(st.st_size) };
+}
+
+// Single pass, O(n) time, O(limit) memory
+inline QList<QUrl> parseNewest(const QString &path, int limit) {
+    struct Hit {
+        QString stamp;
+        QUrl url;
+    };
+    auto newer = [](const Hit &a, const Hit &b) { return a.stamp > b.stamp; };
+    QVector<Hit> heap;   // min-heap on stamp: heap.front() is the oldest kept
+    heap.reserve(limit + 1);
+
+    QFile f(path);
+    if (limit <= 0 || !f.open(QIODevice::ReadOnly)) return {};
+
+    QXmlStreamReader xr(&f);
+    while (!xr.atEnd()) {
+        if (xr.readNext() != QXmlStreamReader::StartElement) continue;
+        if (xr.name() != QLatin1String("bookmark")) continue;
+
+        QXmlStreamAttributes a = xr.attributes();
+        QStringRef href = a.value("href");
+        QStringRef mod = a.value("modified");
+        QStringRef vis = a.value("visited");
+        QStringRef best = mod > vis ? mod : vis;
+        if (best.isEmpty()) best = a.value("added");
+
+        // Copy out before skipping: the refs point into the reader's buffer
+        bool keep = !href.isEmpty()
+                 && (heap.size() < limit || best > QStringRef(&heap.front().stamp));
+        QString stamp, link;
+        if (keep) {
+            stamp = best.toString();
+            link = href.toString();
+        }
+        xr.skipCurrentElement();
+        if (!keep) continue;
+
+        QUrl u(link);
+        if (!u.isValid()) continue;
+
+        heap.append({ stamp, u });
+        std::push_heap(heap.begin(), heap.end(), newer);
+        if (heap.size() > limit) {
+            std::pop_heap(heap.begin(), heap.end(), newer);
+            heap.removeLast();
+        }
+    }
+
+    std::sort(heap.begin(), heap.end(), newer);
+    QList<QUrl> out;
+    for (const Hit &h : heap) out.append(h.url);
+    return out;
+}
+
+// Newest `limit` URLs, newest first; re-parses only when the file changed
+inline QList<QUrl> newest(int limit, const QString &path = xbelPath()) {
+    static QMutex lock;
+    static QString cachedPath;
+    static Stamp cachedStamp;
+    static int cachedLimit = 0;
+    static int widest = 0;          // largest limit asked for so far
+    static QList<QUrl> cached;
+
+    Stamp st = stampOf(path);
+    int parseLimit;
+    {
+        QMutexLocker l(&lock);
+        if (path == cachedPath && st == cachedStamp && limit <= cachedLimit)
+            return cached.mid(0, limit);
+        widest = std::max(widest, limit);
+        parseLimit = widest;
+    }
+
+    QList<QUrl> fresh = parseNewest(path, parseLimit);
+
+    QMutexLocker l(&lock);
+    cachedPath = path;
+    cachedStamp = st;
+    cachedLimit = parseLimit;
+    cached = fresh;
+    return fresh.mid(0, limit);
+}
+
+class Provider : public QObject {
+public:
+    std::function<void(const QList<QUrl>&)> onChanged;
+
+    explicit Provider(int limit, QObject *parent = nullptr)
+        : QObject(parent), m_limit(limit), m_path(xbelPath())
+    {
+        // GTK replaces the file atomically, so watch its directory too
+        m_watch.addPath(QFileInfo(m_path).absolutePath());
+        if (QFileInfo::exists(m_path)) m_watch.addPath(m_path);
+
+        m_debounce.setSingleShot(true);
+        m_debounce.setInterval(200);
+        QObject::connect(&m_debounce, &QTimer::timeout, this, [this]{ reload(); });
+
+        auto changed = [this]{
+            if (!m_watch.files().contains(m_path) && QFileInfo::exists(m_path))
+                m_watch.addPath(m_path);
+            if (stampOf(m_path) == m_seen) return;   // something else in the dir
+            m_debounce.start();
+        };
+        QObject::connect(&m_watch, &QFileSystemWatcher::fileChanged, this, changed);
+        QObject::connect(&m_watch, &QFileSystemWatcher::directoryChanged, this, changed);
+    }
+
+    ~Provider() override {
+        if (m_worker) m_worker->wait();
+    }
+
+    const QList<QUrl>& urls() const { return m_urls; }
+
+    // Parse on a worker thread; onChanged fires with the result
+    void reload() {
+        if (m_worker) { m_again = true; return; }
+
+        int limit = m_limit;
+        QString path = m_path;
+        m_seen = stampOf(path);
+        m_worker = QThread::create([this, limit, path]{ m_parsed = newest(limit, path); });
+        QObject::connect(m_worker, &QThread::finished, this, [this]{
+            m_worker->deleteLater();
+            m_worker = nullptr;
+
+            if (m_parsed != m_urls) {
+                m_urls = m_parsed;
+                if (onChanged) onChanged(m_urls);
+            }
+            if (m_again) {
+                m_again = false;
+                reload();
+            }
+        });
+        m_worker->start(QThread::LowPriority);
+    }
+
+private:
+    int m_limit;
+    QString m_path;
+    Stamp m_seen;
+    QFileSystemWatcher m_watch;
+    QTimer m_debounce;
+    QThread *m_worker = nullptr;
+    bool m_again = false;
+    QList<QUrl> m_parsed, m_urls;
+};
+
+} // namespace WospRecents
@@ -0,0 +1,305 @@
+// wosp-sdbus.h
+// Minimal sd-bus (libsystemd) client driven by the Qt event loop.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// QtDBus only delivers signals to moc'd slots, and nothing in this tree
+// uses moc, so D-Bus clients talk to sd-bus directly. Bus watches the
+// connection fd with QSocketNotifiers and honours sd-bus timeouts with a
+// QTimer; replies and signals go to std::function handlers and nothing
+// ever blocks. Message bodies decode to QVariant trees:
+// a{..} -> QVariantMap, ay -> QByteArray, other arrays and structs ->
+// QVariantList, o/s/g -> QString.
+//
+// serve() exports an object for services that call back into us (BlueZ
+// pairing agents); its handler may answer later with reply()/replyError().
+//
+// Each client picks its bus from an environment variable: unset = system
+// bus, "session" = the user's session bus, anything else is taken as a bus
+// address (e.g. unix:path=/run/dbus-test from a private dbus-daemon).
+// Link with $(pkg-config --libs libsystemd).
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVariantList>
+#include <QByteArray>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+
+#include <poll.h>
+#include <time.h>
+#include <systemd/sd-bus.h>
+
+namespace WospBus {
+
+using Handler = std::function<void(sd_bus_message*)>;
+
+static const char *PROPERTIES = "org.freedesktop.DBus.Properties";
+static const char *OBJECT_MANAGER = "org.freedesktop.DBus.ObjectManager";
+
+// Error text of a method error reply, empty for a normal reply
+inline QString errorOf(sd_bus_message *m) {
+    const sd_bus_error *e = sd_bus_message_get_error(m);
+    if (!e) return QString();
+    return QString::fromUtf8(e->message ? e->message : e->name);
+}
+
+inline bool readBasic(sd_bus_message *m, char type, QVariant &out) {
+    union {
+        uint8_t y; int b; int16_t n; uint16_t q; int32_t i; uint32_t u;
+        int64_t x; uint64_t t; double d; const char *s;
+    } v;
+    std::memset(&v, 0, sizeof(v));
+    if (sd_bus_message_read_basic(m, type, &v) <= 0) return false;
+
+    switch (type) {
+    case SD_BUS_TYPE_BYTE:        out = uint(v.y); break;
+    case SD_BUS_TYPE_BOOLEAN:     out = bool(v.b); break;
+    case SD_BUS_TYPE_INT16:       out = int(v.n); break;
+    case SD_BUS_TYPE_UINT16:      out = uint(v.q); break;
+    case SD_BUS_TYPE_INT32:       out = int(v.i); break;
+    case SD_BUS_TYPE_UINT32:      out = uint(v.u); break;
+    case SD_BUS_TYPE_INT64:       out = qlonglong(v.x); break;
+    case SD_BUS_TYPE_UINT64:      out = qulonglong(v.t); break;
+    case SD_BUS_TYPE_DOUBLE:      out = v.d; break;
+    case SD_BUS_TYPE_UNIX_FD:     out = int(v.i); break;
+    default:                      out = QString::fromUtf8(v.s); break;   // s, o, g
+    }
+    return true;
+}
+
+// Decode the next complete value; false (value skipped) on failure
+inline bool readValue(sd_bus_message *m, QVariant &out) {
+    char type = 0;
+    const char *contents = nullptr;
+    if (sd_bus_message_peek_type(m, &type, &contents) <= 0) return false;
+
+    if (type == SD_BUS_TYPE_ARRAY && contents && std::strcmp(contents, "y") == 0) {
+        const void *p = nullptr;
+        size_t n = 0;
+        if (sd_bus_message_read_array(m, SD_BUS_TYPE_BYTE, &p, &n) < 0) return false;
+        out = QByteArray(static_cast<const char*>(p), int(n));
+        return true;
+    }
+
+    if (type == SD_BUS_TYPE_ARRAY || type == SD_BUS_TYPE_VARIANT ||
+        type == SD_BUS_TYPE_STRUCT || type == SD_BUS_TYPE_DICT_ENTRY) {
+        if (sd_bus_message_enter_container(m, type, contents) <= 0) {
+            sd_bus_message_skip(m, nullptr);
+            return false;
+        }
+        QVariantList items;
+        QVariantMap dict;
+        bool isDict = type == SD_BUS_TYPE_ARRAY && contents && contents[0] == '{';
+        while (sd_bus_message_at_end(m, 0) == 0) {
+            QVariant v;
+            if (!readValue(m, v)) break;
+            if (isDict) {
+                QVariantList kv = v.toList();
+                if (kv.size() == 2) dict.insert(kv[0].toString(), kv[1]);
+            } else {
+                items.append(v);
+            }
+        }
+        sd_bus_message_exit_container(m);
+
+        if (isDict) out = dict;
+        else if (type == SD_BUS_TYPE_VARIANT) out = items.value(0);
+        else out = items;
+        return true;
+    }
+
+    return readBasic(m, type, out);
+}
+
+// Every remaining argument of the message body
+inline QVariantList readAll(sd_bus_message *m) {
+    QVariantList args;
+    while (sd_bus_message_at_end(m, 1) == 0) {
+        QVariant v;
+        if (!readValue(m, v)) break;
+        args.append(v);
+    }
+    return args;
+}
+
+class Bus : public QObject {
+public:
+    explicit Bus(const char *env, QObject *parent = nullptr) : QObject(parent) {
+        QByteArray where = qgetenv(env);
+        int r;
+        if (where.isEmpty()) {
+            r = sd_bus_open_system(&m_bus);
+        } else if (where == "session") {
+            r = sd_bus_open_user(&m_bus);
+        } else {
+            r = sd_bus_new(&m_bus);
+            if (r >= 0) r = sd_bus_set_address(m_bus, where.constData());
+            if (r >= 0) r = sd_bus_set_bus_client(m_bus, 1);
+            if (r >= 0) r = sd_bus_start(m_bus);
+        }
+        if (r < 0) {
+            if (m_bus) sd_bus_unref(m_bus);
+            m_bus = nullptr;
+            return;
+        }
+
+        int fd = sd_bus_get_fd(m_bus);
+        m_read = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        m_write = new QSocketNotifier(fd, QSocketNotifier::Write, this);
+        QObject::connect(m_read, &QSocketNotifier::activated, this, [this]{ process(); });
+        QObject::connect(m_write, &QSocketNotifier::activated, this, [this]{ process(); });
+
+        m_timeout.setSingleShot(true);
+        QObject::connect(&m_timeout, &QTimer::timeout, this, [this]{ process(); });
+
+        process();
+    }
+
+    ~Bus() override {
+        // Frees every slot, which deletes the handlers without calling them
+        if (m_bus) sd_bus_flush_close_unref(m_bus);
+    }
+
+    bool isOpen() const { return m_bus != nullptr; }
+
+    // Async method call; `types` and args follow sd_bus_message_append()
+    template <typename... Args>
+    void call(const char *dest, const char *path, const char *iface, const char *member,
+              Handler onReply, const char *types = nullptr, Args... args) {
+        if (!m_bus) return;
+        Handler *h = new Handler(std::move(onReply));
+        sd_bus_slot *slot = nullptr;
+        int r = sd_bus_call_method_async(m_bus, &slot, dest, path, iface, member,
+                                         &Bus::dispatch, h, types, args...);
+        adopt(r, slot, h);
+    }
+
+    // Properties.GetAll; done(ok, props)
+    void getAll(const char *dest, const QString &path, const char *iface,
+                std::function<void(bool, const QVariantMap&)> done) {
+        call(dest, path.toUtf8().constData(), PROPERTIES, "GetAll",
+             [done](sd_bus_message *m) {
+                 if (!errorOf(m).isEmpty()) { done(false, {}); return; }
+                 done(true, readAll(m).value(0).toMap());
+             }, "s", iface);
+    }
+
+    // Properties.Set with a single basic value of D-Bus type `type`
+    template <typename T>
+    void setProperty(const char *dest, const QString &path, const char *iface,
+                     const char *name, const char *type, T value, Handler onReply = {}) {
+        if (!onReply) onReply = [](sd_bus_message*) {};
+        call(dest, path.toUtf8().constData(), PROPERTIES, "Set", std::move(onReply),
+             "ssv", iface, name, type, value);
+    }
+
+    // Method calls to `path` go to onCall, which returns false for calls it
+    // does not know (answered with UnknownMethod). To answer later, keep
+    // the call with sd_bus_message_ref() and pass it to reply()/replyError().
+    void serve(const char *path, std::function<bool(sd_bus_message*)> onCall) {
+        if (!m_bus) return;
+        auto *h = new Handler([onCall](sd_bus_message *m) {
+            if (!onCall(m)) sd_bus_reply_method_errorf(m, SD_BUS_ERROR_UNKNOWN_METHOD,
+                                                       "Unknown method %s", sd_bus_message_get_member(m));
+        });
+        sd_bus_slot *slot = nullptr;
+        int r = sd_bus_add_object(m_bus, &slot, path, &Bus::dispatchCall, h);
+        adopt(r, slot, h);
+    }
+
+    // Answer a call kept from serve() and drop the reference taken on it
+    template <typename... Args>
+    void reply(sd_bus_message *call, const char *types = nullptr, Args... args) {
+        if (m_bus) sd_bus_reply_method_return(call, types, args...);
+        sd_bus_message_unref(call);
+        if (m_bus && !m_processing) rearm();
+    }
+
+    void replyError(sd_bus_message *call, const char *name, const QString &text) {
+        if (m_bus) sd_bus_reply_method_errorf(call, name, "%s", text.toUtf8().constData());
+        sd_bus_message_unref(call);
+        if (m_bus && !m_processing) rearm();
+    }
+
+    // Persistent signal subscription; null arguments match anything
+    void match(const char *sender, const char *path, const char *iface, const char *member,
+               Handler onSignal) {
+        if (!m_bus) return;
+        Handler *h = new Handler(std::move(onSignal));
+        sd_bus_slot *slot = nullptr;
+        int r = sd_bus_match_signal_async(m_bus, &slot, sender, path, iface, member,
+                                          &Bus::dispatch, nullptr, h);
+        adopt(r, slot, h);
+    }
+
+private:
+    sd_bus *m_bus = nullptr;
+    QSocketNotifier *m_read = nullptr;
+    QSocketNotifier *m_write = nullptr;
+    QTimer m_timeout;
+    bool m_processing = false;
+
+    static int dispatch(sd_bus_message *m, void *userdata, sd_bus_error *) {
+        (*static_cast<Handler*>(userdata))(m);
+        return 0;
+    }
+
+    // Method calls only; returning 1 tells sd-bus the call was taken care of
+    static int dispatchCall(sd_bus_message *m, void *userdata, sd_bus_error *) {
+        if (!sd_bus_message_is_method_call(m, nullptr, nullptr)) return 0;
+        (*static_cast<Handler*>(userdata))(m);
+        return 1;
+    }
+
+    // The bus owns the slot from here on; the handler dies with it
+    void adopt(int r, sd_bus_slot *slot, Handler *h) {
+        if (r < 0 || !slot) {
+            delete h;
+            return;
+        }
+        sd_bus_slot_set_destroy_callback(slot, [](void *p){ delete static_cast<Handler*>(p); });
+        sd_bus_slot_set_floating(slot, 1);
+        if (!m_processing) rearm();
+    }
+
+    void process() {
+        if (!m_bus) return;
+        m_processing = true;
+        while (sd_bus_process(m_bus, nullptr) > 0) {}
+        m_processing = false;
+        rearm();
+    }
+
+    void rearm() {
+        int ev = sd_bus_get_events(m_bus);
+        if (ev < 0) {
+            // Connection gone; stop spinning on a dead fd
+            m_read->setEnabled(false);
+            m_write->setEnabled(false);
+            m_timeout.stop();
+            return;
+        }
+        m_write->setEnabled(ev & POLLOUT);
+
+        uint64_t until = 0;
+        if (sd_bus_get_timeout(m_bus, &until) < 0 || until == UINT64_MAX) {
+            m_timeout.stop();
+            return;
+        }
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        uint64_t now = uint64_t(ts.tv_sec) * 1000000ULL + uint64_t(ts.tv_nsec) / 1000;
+        uint64_t ms = until > now ? (until - now + 999) / 1000 : 0;
+        m_timeout.start(int(std::min<uint64_t>(ms, INT_MAX)));
+    }
+};
+
+} // namespace WospBus
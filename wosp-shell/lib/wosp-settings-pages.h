@@ -0,0 +1,44 @@
+// wosp-settings-pages.h
+// The osm-settings page list, shared by osm-settings' main menu and the
+// shell's intent search. `osm-settings <module>` opens a page directly.
+// Header-only, NO moc, NO Q_OBJECT.
+
+#pragma once
+
+#include <QList>
+#include <QString>
+
+namespace WospSettingsPages {
+
+struct Page {
+    QString icon, title, sub, module;   // module = /usr/local/bin/<module>.so
+};
+
+inline const QList<Page>& all() {
+    static const QList<Page> pages = {
+        {"🛜", "Wireless", "Wi-Fi Networks", "wifi"},
+        {"🔃", "Bluetooth", "Bluetooth Settings", "bluetooth"},
+        {"📶", "Mobile Network", "Cellular, APN, Roaming", "mobile"},
+        {"🔗", "Ethernet", "Wired Network", "ethernet"},
+        {"📍", "Location", "GPS, Geolocation Services", "location"},
+        {"🖥️", "Display", "Brightness, Rotation", "display"},
+        {"🔊", "Sounds", "Output, Volume Levels", "sound"},
+        {"🔋", "Battery", "Battery Level & Charging", "battery"},
+        {"💾", "Storage", "Space, Usage & Cleanup", "storage"},
+        {"📦", "Installed Applications", "apt, flatpak, snap", "apps"},
+        {"🎮", "Emulation", "Android & Windows", "emulation"},
+        {"🔐", "Security", "Lockscreen, Passwords, Firewall", "security"},
+        {"👤", "Account Info", "User Account Stats", "accounts"},
+        {"💽", "Kernel", "System Drivers & Kernel", "kernel"},
+        {"⚙️", "System", "Device, OS, Hardware", "system"}
+    };
+    return pages;
+}
+
+inline QString titleFor(const QString &module) {
+    for (const Page &p : all())
+        if (p.module == module) return p.title;
+    return module;
+}
+
+} // namespace WospSettingsPages
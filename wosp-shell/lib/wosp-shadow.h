@@ -0,0 +1,149 @@
+// wosp-shadow.h
+// Cached nine-slice drop shadows for rounded panels.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// QGraphicsDropShadowEffect renders the whole widget offscreen and blurs
+// it on every repaint, so a panel with a 32 px shadow pays for the blur on
+// each animation frame and each content refresh. Here the blur runs once
+// per (blur, radius, color) on a tile just big enough for the corner arcs
+// plus a one-pixel middle; painting stretches that tile around any card
+// size with qDrawBorderPixmap, which is nine plain blits.
+//
+// attach(card, ...) paints the shadow from the card's parent before the
+// parent's own paintEvent, so it sits behind the card like the effect
+// did; the parent needs margins around the card for the shadow to show.
+
+#pragma once
+
+#include <QWidget>
+#include <QPainter>
+#include <QPixmap>
+#include <QImage>
+#include <QColor>
+#include <QHash>
+#include <QEvent>
+#include <QMargins>
+#include <qdrawutil.h>
+#include <vector>
+
+namespace WospShadow {
+
+// Three box passes of radius blur/3 approximate a gaussian that fades
+// out within `blur` pixels of the card edge
+inline int boxRadius(int blur) { return qMax(1, blur / 3); }
+inline int spread(int blur) { return 3 * boxRadius(blur); }
+
+// One box pass along n samples `step` bytes apart; outside counts as 0
+inline void boxLine(uchar *data, int n, int step, int r, std::vector<uchar> &tmp) {
+    tmp.resize(size_t(n));
+    for (int i = 0; i < n; ++i) tmp[size_t(i)] = data[i * step];
+
+    int win = 2 * r + 1;
+    int sum = 0;
+    for (int i = 0; i <= r && i < n; ++i) sum += tmp[size_t(i)];
+    for (int i = 0; i < n; ++i) {
+        data[i * step] = uchar(sum / win);
+        if (i + r + 1 < n) sum += tmp[size_t(i + r + 1)];
+        if (i - r >= 0) sum -= tmp[size_t(i - r)];
+    }
+}
+
+inline void blurAlpha(QImage &mask, int r) {
+    std::vector<uchar> tmp;
+    uchar *bits = mask.bits();
+    int bpl = mask.bytesPerLine();
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int y = 0; y < mask.height(); ++y) boxLine(bits + y * bpl, mask.width(), 1, r, tmp);
+        for (int x = 0; x < mask.width(); ++x) boxLine(bits + x, mask.height(), bpl, r, tmp);
+    }
+}
+
+// Blurred rounded square: corners of `radius`, 1 px stretchable middle
+inline QPixmap tile(int blur, int radius, const QColor &color) {
+    static QHash<QString, QPixmap> cache;
+    QString key = QString("%1:%2:%3").arg(blur).arg(radius).arg(color.rgba(), 0, 16);
+    auto it = cache.constFind(key);
+    if (it != cache.cend()) return it.value();
+
+    int pad = spread(blur);
+    int core = 2 * radius + 1;
+    int size = 2 * pad + core;
+
+    QImage mask(size, size, QImage::Format_Alpha8);
+    mask.fill(0);
+    {
+        QPainter p(&mask);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setPen(Qt::NoPen);
+        p.setBrush(Qt::black);
+        p.drawRoundedRect(QRectF(pad, pad, core, core), radius, radius);
+    }
+    blurAlpha(mask, boxRadius(blur));
+
+    QImage out(size, size, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < size; ++y) {
+        const uchar *a = mask.constScanLine(y);
+        QRgb *dst = reinterpret_cast<QRgb*>(out.scanLine(y));
+        for (int x = 0; x < size; ++x)
+            dst[x] = qPremultiply(qRgba(color.red(), color.green(), color.blue(),
+                                        a[x] * color.alpha() / 255));
+    }
+
+    QPixmap px = QPixmap::fromImage(out);
+    cache.insert(key, px);
+    return px;
+}
+
+// Shadow for a card occupying `card`; extends spread(blur) px beyond it
+inline void paint(QPainter &p, const QRect &card, int blur, int radius, const QColor &color) {
+    int pad = spread(blur);
+    int m = pad + radius;
+    qDrawBorderPixmap(&p, card.adjusted(-pad, -pad, pad, pad), QMargins(m, m, m, m),
+                      tile(blur, radius, color));
+}
+
+class Caster : public QObject {
+public:
+    Caster(QWidget *card, int blur, int radius, const QColor &color)
+        : QObject(card), m_card(card), m_blur(blur), m_radius(radius), m_color(color)
+    {
+        card->installEventFilter(this);
+        if (card->parentWidget()) card->parentWidget()->installEventFilter(this);
+    }
+
+protected:
+    bool eventFilter(QObject *o, QEvent *e) override {
+        QWidget *parent = m_card->parentWidget();
+        if (o == parent && e->type() == QEvent::Paint) {
+            if (m_card->isVisible()) {
+                QPainter p(parent);
+                paint(p, m_card->geometry(), m_blur, m_radius, m_color);
+            }
+        } else if (o == m_card && parent) {
+            switch (e->type()) {
+            case QEvent::Move:
+            case QEvent::Resize:
+            case QEvent::Show:
+            case QEvent::Hide:
+                parent->update();
+                break;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+
+private:
+    QWidget *m_card;
+    int m_blur;
+    int m_radius;
+    QColor m_color;
+};
+
+// Drop-in for setGraphicsEffect(new QGraphicsDropShadowEffect) with a zero offset
+inline void attach(QWidget *card, int blur, int radius, const QColor &color) {
+    new Caster(card, blur, radius, color);
+}
+
+} // namespace WospShadow
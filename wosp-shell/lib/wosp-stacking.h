@@ -0,0 +1,218 @@
+// wosp-stacking.h
+// Keeps edge bars and badges above other windows without polling.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary, after all
+// Qt headers (pulls in wosp-x11.h).
+//
+// The edge bars and the notification badge used to call raise() every
+// 1.5 s, waking their process and restacking the screen forever. Guard
+// opens its own X connection, selects SubstructureNotify on the root
+// window and only looks at the stacking order when the server reports a
+// top-level window was mapped, reparented or restacked; a guarded widget
+// is raised only if a visible window it does not know sits above it. An
+// unchanging screen costs no wakeups at all.
+//
+// Guarded windows are marked with _WOSP_KEEP_ABOVE so guards in different
+// processes (osm-status and osm-running) never take turns raising over
+// each other, and windows of the guarding process are ignored so the
+// slide-out panels still cover their own edge bar. The mark is read once
+// per window and cached until a PropertyNotify says it changed. A window
+// that insists on being on top as well only gets re-raised every
+// RAISE_MIN_MS.
+
+#pragma once
+
+#include <QApplication>
+#include <QWidget>
+#include <QPointer>
+#include <QList>
+#include <QSet>
+#include <QHash>
+#include <QEvent>
+#include <QSocketNotifier>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVariant>
+
+#include "wosp-x11.h"
+
+namespace WospStacking {
+
+static const int RAISE_MIN_MS = 250;
+
+class Guard : public QObject {
+public:
+    // The process-wide guard, created on first use
+    static Guard* instance() {
+        if (QObject *o = qApp->property("wosp-stacking").value<QObject*>())
+            return static_cast<Guard*>(o);
+
+        Guard *g = new Guard(qApp);
+        qApp->setProperty("wosp-stacking", QVariant::fromValue<QObject*>(g));
+        return g;
+    }
+
+    ~Guard() override {
+        if (m_dpy) XCloseDisplay(m_dpy);
+    }
+
+    void add(QWidget *w) {
+        m_widgets.append(w);
+        w->installEventFilter(this);
+        if (w->isVisible()) mark(w);
+    }
+
+protected:
+    bool eventFilter(QObject *o, QEvent *e) override {
+        // The X window exists by the time Show is delivered
+        if (e->type() == QEvent::Show) mark(static_cast<QWidget*>(o));
+        return false;
+    }
+
+private:
+    Display *m_dpy = nullptr;
+    Window m_root = 0;
+    Atom m_keepAbove = 0;
+    QSocketNotifier *m_sn = nullptr;
+    QList<QPointer<QWidget>> m_widgets;
+    QHash<Window, Window> m_below;      // last sibling each top-level sat on
+    QHash<Window, bool> m_kept;         // _WOSP_KEEP_ABOVE, per top-level
+    QElapsedTimer m_lastRaise;
+    QTimer m_retry;
+
+    explicit Guard(QObject *parent) : QObject(parent) {
+        m_retry.setSingleShot(true);
+        QObject::connect(&m_retry, &QTimer::timeout, this, [this]{ enforce(); });
+
+        m_dpy = XOpenDisplay(nullptr);
+        if (!m_dpy) return;
+
+        m_root = DefaultRootWindow(m_dpy);
+        m_keepAbove = XInternAtom(m_dpy, "_WOSP_KEEP_ABOVE", 0);
+        XSelectInput(m_dpy, m_root, SubstructureNotifyMask);
+        XFlush(m_dpy);
+
+        m_sn = new QSocketNotifier(ConnectionNumber(m_dpy), QSocketNotifier::Read, this);
+        QObject::connect(m_sn, &QSocketNotifier::activated, this, [this]{ drain(); });
+    }
+
+    void mark(QWidget *w) {
+        if (!m_dpy) return;
+        long one = 1;
+        XChangeProperty(m_dpy, Window(w->winId()), m_keepAbove, XA_CARDINAL, 32,
+                        PropModeReplace, reinterpret_cast<unsigned char*>(&one), 1);
+        XFlush(m_dpy);
+    }
+
+    QSet<Window> ownWindows() const {
+        QSet<Window> own;
+        for (QWidget *w : QApplication::topLevelWidgets())
+            if (w->internalWinId()) own.insert(Window(w->internalWinId()));
+        return own;
+    }
+
+    void drain() {
+        QSet<Window> own = ownWindows();
+        bool restacked = false;
+        while (XPending(m_dpy)) {
+            XEvent ev;
+            XNextEvent(m_dpy, &ev);
+            switch (ev.type) {
+            case ConfigureNotify: {
+                // Moves and resizes keep the sibling below; only restacks change it
+                const XConfigureEvent &c = ev.xconfigure;
+                auto it = m_below.find(c.window);
+                if (it != m_below.end() && it.value() == c.above) break;
+                m_below.insert(c.window, c.above);
+                if (!own.contains(c.window)) restacked = true;
+                break;
+            }
+            case MapNotify:
+                if (!own.contains(ev.xmap.window)) restacked = true;
+                break;
+            case CirculateNotify:
+            case ReparentNotify:
+                restacked = true;
+                break;
+            case PropertyNotify:
+                if (ev.xproperty.atom == m_keepAbove) m_kept.remove(ev.xproperty.window);
+                break;
+            case DestroyNotify:
+                m_below.remove(ev.xdestroywindow.window);
+                m_kept.remove(ev.xdestroywindow.window);
+                break;
+            default:
+                break;
+            }
+        }
+        if (restacked) enforce();
+    }
+
+    bool keptAbove(Window w) {
+        auto it = m_kept.constFind(w);
+        if (it != m_kept.cend()) return it.value();
+
+        // Selected before the read, so no change slips in between
+        XSelectInput(m_dpy, w, PropertyChangeMask);
+        Atom type = 0;
+        int format = 0;
+        unsigned long n = 0, after = 0;
+        unsigned char *data = nullptr;
+        XGetWindowProperty(m_dpy, w, m_keepAbove, 0, 1, 0, AnyPropertyType,
+                           &type, &format, &n, &after, &data);
+        if (data) XFree(data);
+        m_kept.insert(w, type != 0);
+        return type != 0;
+    }
+
+    bool covers(Window w) {
+        XWindowAttributes a;
+        if (!XGetWindowAttributes(m_dpy, w, &a)) return false;
+        return a.map_state == IsViewable && a.c_class == InputOutput;
+    }
+
+    void enforce() {
+        QList<QWidget*> guarded;
+        for (const QPointer<QWidget> &w : m_widgets)
+            if (w && w->isVisible() && w->internalWinId()) guarded << w;
+        if (guarded.isEmpty()) return;
+
+        // Windows can vanish between the tree query and the per-window ones
+        WospX11::ErrorTrap trap(m_dpy);
+
+        Window rootRet = 0, parentRet = 0, *children = nullptr;
+        unsigned int n = 0;
+        if (!XQueryTree(m_dpy, m_root, &rootRet, &parentRet, &children, &n)) return;
+
+        // children[] runs bottom to top
+        QSet<Window> own = ownWindows();
+        QList<QWidget*> buried;
+        for (QWidget *w : guarded) {
+            Window id = Window(w->internalWinId());
+            unsigned int i = 0;
+            while (i < n && children[i] != id) ++i;
+            for (unsigned int j = i + 1; j < n; ++j) {
+                Window c = children[j];
+                if (own.contains(c) || keptAbove(c) || !covers(c)) continue;
+                buried << w;
+                break;
+            }
+        }
+        if (children) XFree(children);
+        if (buried.isEmpty()) return;
+
+        // Something else re-raises itself too: back off instead of fighting
+        if (m_lastRaise.isValid() && m_lastRaise.elapsed() < RAISE_MIN_MS) {
+            if (!m_retry.isActive()) m_retry.start(int(RAISE_MIN_MS - m_lastRaise.elapsed()));
+            return;
+        }
+        m_lastRaise.start();
+        for (QWidget *w : buried) w->raise();
+    }
+};
+
+// Keep a top-level widget above every other window, without a timer
+inline void keepOnTop(QWidget *w) {
+    Guard::instance()->add(w);
+}
+
+} // namespace WospStacking
@@ -0,0 +1,261 @@
+// wosp-state.h
+// Shared system-state snapshot published by wosp-stated.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// wosp-stated keeps one Segment in POSIX shared memory (/wosp-state-<uid>)
+// and rewrites it under a seqlock whenever a uevent or rtnetlink message
+// changes battery, network, rfkill or backlight state. Readers map it
+// read-only once; read() is plain memory loads, no syscalls. Change
+// notification goes over $XDG_RUNTIME_DIR/wosp-stated.sock: the daemon
+// writes one byte per published generation to every connected client, so
+// a client only wakes when something actually changed.
+//
+// The socket also carries one message the other way: a client that writes
+// LOCK_HELD is the lock screen, and `locked` stays set until it writes
+// LOCK_RELEASED or disconnects, so a crashed locker never leaves the rest
+// of the shell paused. `displayOff` follows the X server's DPMS state.
+//
+// The plain C++ part is shared with the daemon. Qt programs (QT_CORE_LIB,
+// set by pkg-config) also get Client, which maps the segment, watches the
+// socket with a QSocketNotifier and reconnects if the daemon restarts.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace WospState {
+
+static const uint32_t MAGIC = 0x57535431;   // "WST1"
+static const uint32_t VERSION = 2;          // bump on any layout change
+
+static const char LOCK_HELD = 'L';          // client -> daemon
+static const char LOCK_RELEASED = 'U';
+
+enum BatteryStatus : int32_t { Unknown, Charging, Discharging, Full, NotCharging };
+
+struct Snapshot {
+    int32_t batteryPct = -1;        // -1 without a battery
+    int32_t batteryStatus = Unknown;
+    int32_t powerMw = -1;           // battery charge/discharge power, -1 unknown
+    int32_t minutesLeft = -1;       // to empty (discharging) or full (charging)
+    int32_t onAc = 0;               // a mains supply is online
+    int32_t backlightPct = -1;      // -1 without a backlight device
+    int32_t wifiUp = 0;             // operstate "up"
+    int32_t ethUp = 0;
+    int32_t btPresent = 0;          // an hci controller exists
+    int32_t wifiBlocked = 0;        // rfkill, soft or hard
+    int32_t btBlocked = 0;
+    int32_t wwanBlocked = 0;
+    int32_t displayOff = 0;         // DPMS standby, suspend or off
+    int32_t locked = 0;             // wosp-lock is up
+    char wifiIface[16] = {};
+    char ethIface[16] = {};
+
+    // Nobody can see the screen: pollers and clocks can sleep
+    bool idle() const { return displayOff || locked; }
+
+    bool operator==(const Snapshot &o) const { return std::memcmp(this, &o, sizeof(*this)) == 0; }
+    bool operator!=(const Snapshot &o) const { return !(*this == o); }
+};
+
+struct Segment {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> seq;      // odd while the writer is inside
+    uint32_t reserved;
+    uint64_t generation;            // bumped on every publish
+    Snapshot state;
+};
+
+inline std::string shmName() {
+    return "/wosp-state-" + std::to_string(getuid());
+}
+
+inline std::string socketPath() {
+    const char *rt = getenv("XDG_RUNTIME_DIR");
+    std::string dir = (rt && *rt) ? rt : "/run/user/" + std::to_string(getuid());
+    return dir + "/wosp-stated.sock";
+}
+
+// Writer side (wosp-stated only)
+inline void publish(Segment *seg, const Snapshot &s) {
+    uint32_t q = seg->seq.load(std::memory_order_relaxed);
+    seg->seq.store(q + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&seg->state), &s, sizeof(s));
+    seg->generation = seg->generation + 1;
+    seg->seq.store(q + 2, std::memory_order_release);
+}
+
+// Consistent copy of the snapshot; false if the writer kept it busy
+inline bool read(const Segment *seg, Snapshot &out, uint64_t *generation = nullptr) {
+    for (int tries = 0; tries < 1000; ++tries) {
+        uint32_t before = seg->seq.load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        Snapshot copy;
+        std::memcpy(static_cast<void*>(&copy), &seg->state, sizeof(copy));
+        uint64_t gen = seg->generation;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (seg->seq.load(std::memory_order_relaxed) == before) {
+            out = copy;
+            if (generation) *generation = gen;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read-only mapping of the daemon's segment; nullptr if it is not running
+inline const Segment* mapSegment() {
+    int fd = shm_open(shmName().c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) return nullptr;
+    void *p = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return nullptr;
+
+    const Segment *seg = static_cast<const Segment*>(p);
+    if (seg->magic != MAGIC || seg->version != VERSION) {
+        munmap(p, sizeof(Segment));
+        return nullptr;
+    }
+    return seg;
+}
+
+// Non-blocking connection to the notification socket, -1 on failure
+inline int connectNotify() {
+    std::string path = socketPath();
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    std::strcpy(addr.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace WospState
+
+#ifdef QT_CORE_LIB
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <functional>
+
+namespace WospState {
+
+class Client : public QObject {
+public:
+    std::function<void(const Snapshot&)> onChanged;
+
+    explicit Client(QObject *parent = nullptr) : QObject(parent) {
+        m_retry.setInterval(5000);
+        QObject::connect(&m_retry, &QTimer::timeout, this, [this]{ attach(); });
+        attach();
+    }
+
+    ~Client() override { detach(); }
+
+    // False while wosp-stated is not running; callers keep their own fallback
+    bool available() const { return m_seg != nullptr; }
+
+    // Marks this process as the lock screen until released or closed
+    void holdLock(bool on) {
+        m_lock = on;
+        sendLock();
+    }
+
+    // Latest snapshot straight from shared memory
+    Snapshot state() const {
+        Snapshot s;
+        if (m_seg) read(m_seg, s);
+        return s;
+    }
+
+private:
+    const Segment *m_seg = nullptr;
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer m_retry;
+    uint64_t m_seen = 0;
+    bool m_lock = false;
+
+    void sendLock() {
+        if (m_fd < 0) return;
+        char b = m_lock ? LOCK_HELD : LOCK_RELEASED;
+        ::send(m_fd, &b, 1, MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+
+    void attach() {
+        m_seg = mapSegment();
+        m_fd = m_seg ? connectNotify() : -1;
+        if (m_fd < 0) {
+            detach();
+            m_retry.start();
+            return;
+        }
+        m_retry.stop();
+
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        QObject::connect(m_notifier, &QSocketNotifier::activated, this, [this]{ drain(); });
+        m_seen = 0;
+        if (m_lock) sendLock();     // a restarted daemon forgot us
+        deliver();
+    }
+
+    void detach() {
+        // May run from inside the notifier's own activated()
+        if (m_notifier) {
+            m_notifier->setEnabled(false);
+            m_notifier->deleteLater();
+        }
+        m_notifier = nullptr;
+        if (m_fd >= 0) ::close(m_fd);
+        m_fd = -1;
+        if (m_seg) munmap(const_cast<Segment*>(m_seg), sizeof(Segment));
+        m_seg = nullptr;
+    }
+
+    void drain() {
+        char buf[64];
+        ssize_t n;
+        while ((n = ::read(m_fd, buf, sizeof(buf))) > 0) {}
+        if (n == 0) {
+            // Daemon went away; poll slowly until it is back
+            detach();
+            m_retry.start();
+            if (onChanged) onChanged(Snapshot());
+            return;
+        }
+        deliver();
+    }
+
+    void deliver() {
+        Snapshot s;
+        uint64_t gen = 0;
+        if (!read(m_seg, s, &gen) || gen == m_seen) return;
+        m_seen = gen;
+        if (onChanged) onChanged(s);
+    }
+};
+
+} // namespace WospState
+
+#endif
@@ -0,0 +1,340 @@
+// wosp-theme.h
+// Native rounded pills, cards and buttons without per-widget stylesheets.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Every setStyleSheet() string is parsed on its own, and the widget (plus
+// everything below it) is then polished by QStyleSheetStyle, which
+// matches rules again on each polish and on every restyle. A settings page
+// with a dozen buttons parsed a dozen copies of the same CSS, and a file
+// list parsed one per entry and re-parsed it on each selection change.
+//
+// Here the look is a Shape: fill per state, border, radius and padding.
+// setShape() interns it in the process-wide Style, a QProxyStyle over the
+// normal application style installed on qApp (and so shared by plugins
+// and hosted components), and tags the widget with the shape's index.
+// Style draws tagged push buttons from its drawPrimitive/drawControl and
+// sizes them with the padding; other widgets (label pills, cards) get the
+// shape painted under their own paintEvent. Restyling is swapping the
+// index and an update(). Text colour and font come from the shape and a
+// plain QFont, so nothing is parsed at all.
+//
+// Widgets below an ancestor stylesheet are handed to QStyleSheetStyle,
+// which would fill tagged buttons with the inherited background; those
+// are painted straight through Style instead, so a shape looks the same
+// anywhere. Stylesheets stay where they still earn their keep (sliders,
+// line edits, one-off layouts).
+
+#pragma once
+
+#include <QApplication>
+#include <QWidget>
+#include <QPushButton>
+#include <QProxyStyle>
+#include <QStyleOption>
+#include <QPainter>
+#include <QPalette>
+#include <QColor>
+#include <QFont>
+#include <QFontMetrics>
+#include <QIcon>
+#include <QPixmap>
+#include <QMargins>
+#include <QHash>
+#include <QVector>
+#include <QEvent>
+#include <QVariant>
+
+namespace WospTheme {
+
+static const int ICON_GAP = 6;      // between a button's icon and its text
+
+struct Shape {
+    QColor background;
+    QColor hover;                   // invalid: background
+    QColor pressed;                 // invalid: background
+    QColor disabled;                // invalid: background
+    QColor text;                    // invalid: the widget palette
+    QColor disabledText;            // invalid: text
+    QColor border;
+    int borderWidth = 0;
+    Qt::PenStyle borderStyle = Qt::SolidLine;
+    int radius = 0;
+    QMargins padding;
+    Qt::Alignment align = Qt::AlignCenter;
+
+    bool operator==(const Shape &o) const {
+        return background == o.background && hover == o.hover && pressed == o.pressed
+            && disabled == o.disabled && text == o.text && disabledText == o.disabledText
+            && border == o.border && borderWidth == o.borderWidth
+            && borderStyle == o.borderStyle && radius == o.radius
+            && padding == o.padding && align == o.align;
+    }
+};
+
+class Style : public QProxyStyle {
+public:
+    // The process-wide theme; installs itself as the application style
+    static Style* instance() {
+        QStyle *current = QApplication::style();
+        if (current->property("wosp-theme").toBool())
+            return static_cast<Style*>(current);
+
+        Style *s = new Style(current->objectName());
+        QApplication::setStyle(s);
+        return s;
+    }
+
+    // Index of an equal shape, added on first use
+    int intern(const Shape &s) {
+        int id = m_shapes.indexOf(s);
+        if (id >= 0) return id;
+        m_shapes.append(s);
+        return m_shapes.size() - 1;
+    }
+
+    void tag(QWidget *w, int id) {
+        if (!m_tagged.contains(w)) {
+            w->installEventFilter(this);
+            QObject::connect(w, &QObject::destroyed, this, [this, w]{ m_tagged.remove(w); });
+        }
+        m_tagged.insert(w, id);
+    }
+
+    const Shape *shapeOf(const QWidget *w) const {
+        if (!w) return nullptr;
+        auto it = m_tagged.constFind(w);
+        return it == m_tagged.cend() ? nullptr : &m_shapes.at(it.value());
+    }
+
+    void paintShape(const Shape &s, const QRect &rect, QStyle::State state, QPainter *p) const {
+        QColor fill = s.background;
+        if (!(state & State_Enabled)) {
+            if (s.disabled.isValid()) fill = s.disabled;
+        } else if (state & State_Sunken) {
+            if (s.pressed.isValid()) fill = s.pressed;
+        } else if (state & State_MouseOver) {
+            if (s.hover.isValid()) fill = s.hover;
+        }
+
+        p->save();
+        p->setRenderHint(QPainter::Antialiasing);
+        QRectF box(rect);
+        if (s.borderWidth > 0) {
+            // The pen straddles the path; keep its outer edge on the rect
+            qreal half = s.borderWidth / 2.0;
+            box.adjust(half, half, -half, -half);
+            p->setPen(QPen(s.border, s.borderWidth, s.borderStyle));
+        } else {
+            p->setPen(Qt::NoPen);
+        }
+        p->setBrush(fill);
+        qreal r = qMax<qreal>(0, s.radius - s.borderWidth / 2.0);
+        p->drawRoundedRect(box, r, r);
+        p->restore();
+    }
+
+    void drawPrimitive(PrimitiveElement pe, const QStyleOption *opt, QPainter *p,
+                       const QWidget *w) const override {
+        if (const Shape *s = shapeOf(w)) {
+            switch (pe) {
+            case PE_PanelButtonCommand:
+                paintShape(*s, w->rect(), opt->state, p);
+                return;
+            case PE_FrameFocusRect:
+            case PE_FrameDefaultButton:
+                return;
+            default:
+                break;
+            }
+        }
+        QProxyStyle::drawPrimitive(pe, opt, p, w);
+    }
+
+    void drawControl(ControlElement ce, const QStyleOption *opt, QPainter *p,
+                     const QWidget *w) const override {
+        const Shape *s = shapeOf(w);
+        const QStyleOptionButton *b = qstyleoption_cast<const QStyleOptionButton*>(opt);
+        if (s && b && ce == CE_PushButtonLabel) {
+            QColor c = s->text.isValid() ? s->text : b->palette.color(QPalette::ButtonText);
+            if (!(b->state & State_Enabled) && s->disabledText.isValid()) c = s->disabledText;
+
+            QRect r = contentRect(*s, w->rect());
+            int align = int(s->align);
+            p->save();
+            if (!b->icon.isNull()) {
+                // Icon and text travel together, placed as one block
+                QIcon::Mode mode = (b->state & State_Enabled) ? QIcon::Normal : QIcon::Disabled;
+                QPixmap px = b->icon.pixmap(b->iconSize, mode);
+                QSize ps = px.size() / px.devicePixelRatio();
+                int gap = b->text.isEmpty() ? 0 : ICON_GAP;
+                int block = ps.width() + gap + p->fontMetrics().horizontalAdvance(b->text);
+                int x = r.left() + (r.width() - block) / 2;
+                if (align & Qt::AlignLeft) x = r.left();
+                else if (align & Qt::AlignRight) x = r.right() + 1 - block;
+                p->drawPixmap(x, r.top() + (r.height() - ps.height()) / 2, px);
+                r.setLeft(x + ps.width() + gap);
+                align = int(Qt::AlignLeft) | (align & int(Qt::AlignVertical_Mask));
+            }
+            p->setPen(c);
+            p->drawText(r, align | Qt::TextShowMnemonic, b->text);
+            p->restore();
+            return;
+        }
+        QProxyStyle::drawControl(ce, opt, p, w);
+    }
+
+    QSize sizeFromContents(ContentsType ct, const QStyleOption *opt, const QSize &size,
+                           const QWidget *w) const override {
+        const Shape *s = shapeOf(w);
+        if (s && ct == CT_PushButton) {
+            QMargins m = frame(*s);
+            return QSize(size.width() + m.left() + m.right(), size.height() + m.top() + m.bottom());
+        }
+        return QProxyStyle::sizeFromContents(ct, opt, size, w);
+    }
+
+    static QMargins frame(const Shape &s) {
+        int bw = s.borderWidth;
+        return s.padding + QMargins(bw, bw, bw, bw);
+    }
+
+    static QRect contentRect(const Shape &s, const QRect &r) {
+        return r.marginsRemoved(frame(s));
+    }
+
+protected:
+    bool eventFilter(QObject *o, QEvent *e) override {
+        QWidget *w = o->isWidgetType() ? static_cast<QWidget*>(o) : nullptr;
+        const Shape *s = shapeOf(w);
+        if (!s) return QProxyStyle::eventFilter(o, e);
+
+        QPushButton *button = qobject_cast<QPushButton*>(w);
+        switch (e->type()) {
+        case QEvent::Paint:
+            if (button) {
+                if (w->style() == this) return false;
+                paintButton(button);
+                return true;
+            }
+            paintUnder(w, *s);
+            return false;
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+            if (!button && s->pressed.isValid()) {
+                w->setProperty("wosp-down", e->type() == QEvent::MouseButtonPress);
+                w->update();
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
+private:
+    QVector<Shape> m_shapes;
+    QHash<const QWidget*, int> m_tagged;
+
+    explicit Style(const QString &base) : QProxyStyle(base) {
+        setProperty("wosp-theme", true);
+    }
+
+    // What QPushButton::paintEvent would do, through this style rather
+    // than the QStyleSheetStyle an ancestor's stylesheet put in between
+    void paintButton(QPushButton *b) const {
+        QStyleOptionButton opt;
+        opt.initFrom(b);
+        opt.features = QStyleOptionButton::None;
+        if (b->isFlat()) opt.features |= QStyleOptionButton::Flat;
+        if (b->menu()) opt.features |= QStyleOptionButton::HasMenu;
+        if (b->isDown()) opt.state |= State_Sunken;
+        if (b->isChecked()) opt.state |= State_On;
+        if (!b->isFlat() && !b->isDown()) opt.state |= State_Raised;
+        opt.text = b->text();
+        opt.icon = b->icon();
+        opt.iconSize = b->iconSize();
+
+        QPainter p(b);
+        p.setFont(b->font());
+        drawControl(CE_PushButton, &opt, &p, b);
+    }
+
+    // Label pills and cards: the shape goes under their own paintEvent
+    void paintUnder(QWidget *w, const Shape &s) const {
+        QStyleOption opt;
+        opt.initFrom(w);
+        if (w->property("wosp-down").toBool()) opt.state |= State_Sunken;
+        QPainter p(w);
+        paintShape(s, w->rect(), opt.state, &p);
+    }
+};
+
+// Load the theme before building widgets; otherwise the first setShape()
+// installs it and every existing widget is polished once more
+inline void install() {
+    Style::instance();
+}
+
+// Give a widget a shape, or swap it for another; cheap enough for every
+// selection change. Buttons are drawn by the theme, other widgets get the
+// shape under their contents and its padding as contents margins.
+inline void setShape(QWidget *w, const Shape &s) {
+    Style *style = Style::instance();
+    const Shape *old = style->shapeOf(w);
+    if (old && *old == s) return;
+    bool resized = old && Style::frame(*old) != Style::frame(s);
+
+    style->tag(w, style->intern(s));
+    if (s.hover.isValid()) w->setAttribute(Qt::WA_Hover);
+    if (!qobject_cast<QPushButton*>(w))
+        w->setContentsMargins(Style::frame(s));
+    else if (resized)
+        w->updateGeometry();
+    w->update();
+}
+
+// Solid background from the palette, in place of "background:#rrggbb"
+inline void setBackground(QWidget *w, const QColor &color) {
+    QPalette pal = w->palette();
+    pal.setColor(QPalette::Window, color);
+    w->setPalette(pal);
+    w->setAutoFillBackground(true);
+}
+
+// A font with only size and weight set; the family still comes from the parent
+inline QFont font(int px, bool bold = false) {
+    QFont f;
+    f.setPixelSize(px);
+    if (bold) f.setBold(true);
+    return f;
+}
+
+// Text colour and font for a label, in place of "color:..; font-size:.."
+inline void setText(QWidget *w, const QColor &color, int px, bool bold = false) {
+    QPalette pal = w->palette();
+    pal.setColor(QPalette::WindowText, color);
+    w->setPalette(pal);
+    w->setFont(font(px, bold));
+}
+
+// ───────────────────────── shared shapes ─────────────────────────
+
+// The dark settings button: #444 with a #222 rim, lighter on hover
+inline Shape darkButton(const QColor &text, int radius = 16, const QMargins &padding = QMargins(16, 6, 16, 6)) {
+    Shape s;
+    s.background = QColor("#444444");
+    s.hover = QColor("#555555");
+    s.pressed = QColor("#333333");
+    s.text = text;
+    s.border = QColor("#222222");
+    s.borderWidth = 1;
+    s.radius = radius;
+    s.padding = padding;
+    return s;
+}
+
+// The 180x60 on/off and refresh buttons of the connection pages
+inline Shape toggleButton(const QColor &text) {
+    return darkButton(text, 16, QMargins(24, 10, 24, 10));
+}
+
+} // namespace WospTheme
@@ -0,0 +1,298 @@
+// wosp-timers.h
+// Aligned periodic timers and a wakeup auditor for shell processes.
+// Header-only, NO moc, NO Q_OBJECT — include once per binary.
+//
+// Every independent QTimer wakes the CPU on its own phase, so five 2 s
+// pollers started at different moments cost five wakeups per period and
+// the SoC rarely reaches deep idle. Periodic timers here are grouped by
+// period and fired on a shared grid: a period-P group fires when
+// CLOCK_MONOTONIC is a multiple of P. Every process on the device uses
+// the same clock, so equal periods in different processes land in the
+// same window, and because the grid is nested (4 s boundaries are also
+// 2 s boundaries) a 4 s poll never adds a wakeup to a 2 s one. All
+// callbacks in a group run back to back from one timer.
+//
+// minute() timers align to the wall-clock minute instead, for "HH:mm"
+// clocks that had been waking every second to show the same text.
+//
+// Nothing runs while nobody can see it: the scheduler follows the
+// displayOff/locked flags wosp-stated publishes (see wosp-state.h) and
+// stops every group while the display is off or wosp-lock is up. When
+// that clears, each group fires once to catch up and goes back on its
+// grid. The lock screen calls holdLock(), which raises the flag and keeps
+// its own timers running while locked.
+//
+// WOSP_WAKEUP_AUDIT=1 in the environment turns on the auditor: every
+// AUDIT_MS it prints, per timer name, how often it fired, plus how often
+// the GUI thread actually woke up (voluntary context switches, which
+// includes sockets, inotify and plain QTimers). Lines go to stderr and
+// are appended to $XDG_RUNTIME_DIR/wosp-wakeups.log so one file shows
+// every shell process side by side.
+
+#pragma once
+
+#include <QCoreApplication>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QTimer>
+#include <QVariant>
+#include <functional>
+#include <cstdio>
+
+#include <time.h>
+#include <unistd.h>
+
+#include "wosp-state.h"
+
+namespace WospTimers {
+
+static const int MINUTE_MS = 60000;
+static const int WALL_LAG_MS = 20;      // land just past the minute, not before
+static const int AUDIT_MS = 10000;
+
+inline qint64 monotonicMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Milliseconds until the next grid line of a period
+inline int untilNext(int period, bool wall) {
+    if (wall) {
+        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        return int(period - now % period) + WALL_LAG_MS;
+    }
+    return int(period - monotonicMs() % period);
+}
+
+// voluntary_ctxt_switches of the GUI thread: one per sleep in the event loop
+inline qint64 wakeupCount() {
+    QFile f("/proc/self/status");
+    if (!f.open(QFile::ReadOnly)) return -1;
+    for (const QByteArray &line : f.readAll().split('\n'))
+        if (line.startsWith("voluntary_ctxt_switches:"))
+            return line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+    return -1;
+}
+
+class Periodic;
+
+class Scheduler : public QObject {
+public:
+    // The process-wide scheduler, shared by osm-settings plugins via qApp
+    static Scheduler* instance() {
+        QCoreApplication *app = QCoreApplication::instance();
+        if (QObject *o = app->property("wosp-timers").value<QObject*>())
+            return static_cast<Scheduler*>(o);
+
+        Scheduler *s = new Scheduler(app);
+        app->setProperty("wosp-timers", QVariant::fromValue<QObject*>(s));
+        return s;
+    }
+
+    void join(Periodic *p, int period, bool wall);
+    void leave(Periodic *p, int period, bool wall);
+
+    // This process is the lock screen: flag the session locked, keep running
+    void holdLock() {
+        m_holdsLock = true;
+        m_state->holdLock(true);
+        if (m_state->available()) setPaused(m_state->state().displayOff);
+    }
+
+    bool paused() const { return m_paused; }
+
+private:
+    struct Group {
+        QTimer timer;
+        QList<Periodic*> members;
+    };
+
+    QMap<qint64, Group*> m_groups;      // key: period, negated for wall time
+    WospState::Client *m_state = nullptr;
+    bool m_paused = false;
+    bool m_holdsLock = false;
+    bool m_audit = false;
+    QTimer m_auditTimer;
+    QHash<QString, int> m_fired;
+    int m_batches = 0;
+    qint64 m_lastWakeups = -1;
+    qint64 m_lastAudit = 0;
+
+    explicit Scheduler(QObject *parent) : QObject(parent) {
+        // Snapshot() (daemon gone) is not idle, so timers never stay paused
+        m_state = new WospState::Client(this);
+        m_state->onChanged = [this](const WospState::Snapshot &s) {
+            setPaused(s.displayOff || (s.locked && !m_holdsLock));
+        };
+        if (m_state->available()) {
+            WospState::Snapshot s = m_state->state();
+            m_paused = s.idle();
+        }
+
+        m_audit = !qEnvironmentVariableIsEmpty("WOSP_WAKEUP_AUDIT");
+        if (!m_audit) return;
+        m_lastWakeups = wakeupCount();
+        m_lastAudit = monotonicMs();
+        QObject::connect(&m_auditTimer, &QTimer::timeout, this, [this]{ report(); });
+        m_auditTimer.start(AUDIT_MS);
+    }
+
+    ~Scheduler() override { qDeleteAll(m_groups); }
+
+    static qint64 keyOf(int period, bool wall) { return wall ? -qint64(period) : qint64(period); }
+
+    void arm(Group *g, int period, bool wall, bool fired = false) {
+        int ms = untilNext(period, wall);
+        // Woken a hair before the line (ms rounding): that line is done
+        if (fired && ms < qMin(50, period / 2)) ms += period;
+        g->timer.start(ms);
+    }
+
+    void setPaused(bool paused) {
+        if (paused == m_paused) return;
+        m_paused = paused;
+        if (paused) {
+            for (Group *g : m_groups) g->timer.stop();
+            return;
+        }
+        // Catch up once; fire() puts each group back on its grid
+        for (qint64 key : m_groups.keys()) {
+            Group *g = m_groups.value(key);
+            if (!g->members.isEmpty()) fire(key);
+        }
+    }
+
+    void fire(qint64 key);
+    void report();
+};
+
+class Periodic : public QObject {
+public:
+    // Like a QTimer with interval periodMs and fn on timeout, but fired on
+    // the shared grid; name labels it in audit reports
+    Periodic(const QString &name, int periodMs, QObject *parent, std::function<void()> fn)
+        : QObject(parent), m_name(name), m_period(qMax(1, periodMs)), m_fn(std::move(fn)) {}
+
+    ~Periodic() override { stop(); }
+
+    // Fires on the wall-clock minute; started already
+    static Periodic* minute(const QString &name, QObject *parent, std::function<void()> fn) {
+        Periodic *p = new Periodic(name, MINUTE_MS, parent, std::move(fn));
+        p->m_wall = true;
+        p->start();
+        return p;
+    }
+
+    void start() {
+        if (m_sched) return;
+        m_sched = Scheduler::instance();
+        m_sched->join(this, m_period, m_wall);
+    }
+
+    void stop() {
+        if (!m_sched) return;
+        m_sched->leave(this, m_period, m_wall);
+        m_sched = nullptr;
+    }
+
+    bool isActive() const { return !m_sched.isNull(); }
+    int interval() const { return m_period; }
+
+    void setInterval(int ms) {
+        bool active = isActive();
+        stop();
+        m_period = qMax(1, ms);
+        if (active) start();
+    }
+
+    const QString &name() const { return m_name; }
+
+private:
+    friend class Scheduler;
+
+    QString m_name;
+    int m_period;
+    bool m_wall = false;
+    std::function<void()> m_fn;
+    QPointer<Scheduler> m_sched;
+};
+
+inline void Scheduler::join(Periodic *p, int period, bool wall) {
+    qint64 key = keyOf(period, wall);
+    Group *g = m_groups.value(key);
+    if (!g) {
+        g = new Group;
+        g->timer.setSingleShot(true);
+        // Precise: Qt's coarse timers shift by up to 5% and would leave the grid
+        g->timer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&g->timer, &QTimer::timeout, this, [this, key]{ fire(key); });
+        m_groups.insert(key, g);
+    }
+    if (!g->timer.isActive() && !m_paused) arm(g, period, wall);
+    if (!g->members.contains(p)) g->members.append(p);
+}
+
+inline void Scheduler::leave(Periodic *p, int period, bool wall) {
+    qint64 key = keyOf(period, wall);
+    Group *g = m_groups.value(key);
+    if (!g) return;
+    g->members.removeAll(p);
+    // Kept for the next join: this may run inside the group's own timeout
+    if (g->members.isEmpty()) g->timer.stop();
+}
+
+inline void Scheduler::fire(qint64 key) {
+    Group *g = m_groups.value(key);
+    if (!g) return;
+
+    // A callback may stop or delete any member, including itself
+    QList<QPointer<Periodic>> batch;
+    for (Periodic *p : g->members) batch.append(p);
+    for (const QPointer<Periodic> &p : batch) {
+        if (!p || !p->m_sched) continue;
+        if (m_audit) m_fired[p->m_name]++;
+        p->m_fn();
+    }
+    if (m_audit) m_batches++;
+
+    // Re-armed from the clock each time, so slow callbacks never drift
+    if (!g->members.isEmpty() && !m_paused)
+        arm(g, int(key < 0 ? -key : key), key < 0, true);
+}
+
+inline void Scheduler::report() {
+    qint64 now = monotonicMs();
+    double secs = qMax<qint64>(1, now - m_lastAudit) / 1000.0;
+    qint64 wakeups = wakeupCount();
+
+    QByteArray line = QCoreApplication::applicationName().toUtf8()
+                      + '[' + QByteArray::number(qint64(getpid())) + "]:";
+    if (wakeups >= 0 && m_lastWakeups >= 0)
+        line += ' ' + QByteArray::number((wakeups - m_lastWakeups) / secs, 'f', 2) + " wakeups/s,";
+    line += " timer batches " + QByteArray::number(m_batches / secs, 'f', 2) + "/s";
+    for (auto it = m_fired.cbegin(); it != m_fired.cend(); ++it)
+        line += ", " + it.key().toUtf8() + ' ' + QByteArray::number(it.value() / secs, 'f', 2) + "/s";
+
+    fprintf(stderr, "wosp-timers: %s\n", line.constData());
+
+    QByteArray dir = qgetenv("XDG_RUNTIME_DIR");
+    if (dir.isEmpty()) dir = "/run/user/" + QByteArray::number(uint(getuid()));
+    QFile log(QFile::decodeName(dir + "/wosp-wakeups.log"));
+    if (log.open(QFile::WriteOnly | QFile::Append))
+        log.write(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8() + ' ' + line + '\n');
+
+    m_fired.clear();
+    m_batches = 0;
+    m_lastWakeups = wakeups;
+    m_lastAudit = now;
+}
+
+} // namespace WospTimers
@@ -0,0 +1,60 @@
+// wosp-x11.h
+// Xlib for the Qt binaries. Include after all Qt headers.
+//
+// Xlib defines short macros (None, Bool, Status, KeyPress, FocusIn, ...)
+// that collide with Qt enums used further down in the includer; they are
+// removed here once the prototypes that need them have been parsed, so
+// code below must use 0/1 instead of None/True/False/Success.
+//
+// XSetErrorHandler() is process-wide, so nothing installs a handler for
+// good; WospX11::ErrorTrap swallows errors only around the requests that
+// can race with another client destroying its window.
+
+#pragma once
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/Xrandr.h>
+
+#undef Bool
+#undef Status
+#undef None
+#undef True
+#undef False
+#undef Success
+#undef KeyPress
+#undef KeyRelease
+#undef FocusIn
+#undef FocusOut
+#undef FontChange
+#undef Expose
+#undef CursorShape
+#undef Unsorted
+
+namespace WospX11 {
+
+class ErrorTrap {
+public:
+    // Errors already queued still go to the previous handler
+    explicit ErrorTrap(Display *dpy) : m_dpy(dpy) {
+        XSync(m_dpy, 0);
+        m_previous = XSetErrorHandler(&ErrorTrap::ignore);
+    }
+
+    ~ErrorTrap() {
+        XSync(m_dpy, 0);
+        XSetErrorHandler(m_previous);
+    }
+
+    ErrorTrap(const ErrorTrap&) = delete;
+    ErrorTrap& operator=(const ErrorTrap&) = delete;
+
+private:
+    Display *m_dpy;
+    XErrorHandler m_previous = nullptr;
+
+    static int ignore(Display*, XErrorEvent*) { return 0; }
+};
+
+} // namespace WospX11
@@ -0,0 +1,98 @@
+// wosp-zygote.h
+// Client side of osm-zygote (see apps/osm-zygote.cpp).
+// Header-only, no Qt — include once per binary.
+//
+// osm-launch is the usual client, but a resident component that opens an
+// app (the shell for power.menu) would pay a fork/exec of osm-launch just
+// to write one request. launch() writes it itself: one socket round-trip,
+// then the zygote's fork.
+//
+// Every socket call is bounded by REPLY_TIMEOUT_MS, so a wedged zygote
+// costs the caller (the shell's GUI thread, for power.menu) a short stall
+// and a fallback, not a freeze.
+//
+// Wire format: struct { uint32 len, argc, envc } followed by `len` bytes of
+// NUL-terminated strings (app, cwd, argv..., env...). Reply: int32 pid, or
+// -1 if the app could not be started.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+extern char **environ;
+
+namespace WospZygote {
+
+static const int REPLY_TIMEOUT_MS = 1000;   // the zygote only has to fork
+
+inline std::string socketPath() {
+    const char *rt = getenv("XDG_RUNTIME_DIR");
+    return std::string((rt && *rt) ? rt : "/run/user/" + std::to_string(getuid()))
+         + "/osm-zygote.sock";
+}
+
+inline bool writeFull(int fd, const void *buf, size_t n) {
+    const char *p = static_cast<const char*>(buf);
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= size_t(w);
+    }
+    return true;
+}
+
+// argv[0] is the app name. Forked pid, or -1 if the zygote is not running,
+// does not know the app or did not answer in time (exec it yourself then).
+inline int32_t launch(const std::vector<std::string> &argv) {
+    if (argv.empty()) return -1;
+
+    std::string path = socketPath();
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    // Send timeout also covers connect() on a full backlog
+    timeval tv{ REPLY_TIMEOUT_MS / 1000, (REPLY_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd))) strcpy(cwd, "/");
+
+    std::string payload;
+    auto add = [&payload](const char *s) { payload.append(s); payload.push_back('\0'); };
+    add(argv[0].c_str());
+    add(cwd);
+    for (const std::string &a : argv) add(a.c_str());
+    uint32_t envc = 0;
+    for (char **e = environ; *e; e++, envc++) add(*e);
+
+    uint32_t hdr[3] = { uint32_t(payload.size()), uint32_t(argv.size()), envc };
+    int32_t pid = -1;
+    bool ok = writeFull(fd, hdr, sizeof(hdr))
+           && writeFull(fd, payload.data(), payload.size())
+           && read(fd, &pid, sizeof(pid)) == sizeof(pid);
+    close(fd);
+    return ok && pid > 0 ? pid : -1;
+}
+
+} // namespace WospZygote
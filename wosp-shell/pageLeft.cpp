@@ -13,10 +13,43 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QUrl>
-#include <QXmlStreamReader>
 #include <QMouseEvent>
 #include <QStringList>
+#include <QFileSystemWatcher>
+#include <QElapsedTimer>
 #include <functional>
+#include <memory>
+
+#include "lib/wosp-launchtrace.h"
+#include "lib/wosp-appdb.h"
+#include "lib/wosp-settings-pages.h"
+#include "lib/wosp-intent.h"
+#include "lib/wosp-recents.h"
+#include "lib/wosp-theme.h"
+
+/* ───────────────────────── Launch tracing ───────────────────────── */
+
+static WospLaunchTrace::Tracer *g_trace = nullptr;
+
+// xdg-open hands off to whichever app owns the type, so trace by type
+static void openTraced(const QUrl &u) {
+    QString target = u.isLocalFile() ? u.toLocalFile() : u.toString();
+    QString kind = u.scheme().startsWith("http") ? "web" : QFileInfo(target).suffix().toLower();
+
+    QElapsedTimer since;
+    since.start();
+    qint64 pid = 0;
+    if (QProcess::startDetached("xdg-open", { target }, QString(), &pid) && g_trace)
+        g_trace->begin("pageLeft:" + (kind.isEmpty() ? "file" : kind), pid, since, true);
+}
+
+static void launchTraced(const QString &id, const QString &program, const QStringList &args) {
+    QElapsedTimer since;
+    since.start();
+    qint64 pid = 0;
+    if (QProcess::startDetached(program, args, QString(), &pid) && g_trace)
+        g_trace->begin(id, pid, since);
+}
 
 /* ───────────────────────── Clickable row ───────────────────────── */
 
@@ -58,19 +91,18 @@ static QFrame* dividerLine() {
 static QPushButton* pillButton(const QString &t) {
     QPushButton *b = new QPushButton(t);
     b->setFixedHeight(34);
-    b->setStyleSheet(
-        "QPushButton{"
-        " background:rgba(160,160,160,170);"
-        " border:none;"
-        " border-radius:17px;"
-        " color:white;"
-        " font-size:16px;"
-        " padding:0px 12px;"
-        "}"
-        "QPushButton:pressed{"
-        " background:rgba(190,190,190,190);"
-        "}"
-    );
+
+    WospTheme::Shape pill;
+    pill.background = QColor(160,160,160,170);
+    pill.pressed = QColor(190,190,190,190);
+    pill.disabled = QColor(160,160,160,120);
+    pill.text = Qt::white;
+    pill.disabledText = Qt::transparent;
+    pill.radius = 17;
+    pill.padding = QMargins(12, 0, 12, 0);
+    WospTheme::setShape(b, pill);
+    b->setFont(WospTheme::font(16));
+
     b->setCursor(Qt::PointingHandCursor);
     return b;
 }
@@ -94,30 +126,7 @@ static QString niceNameForUrl(const QUrl &u) {
     return u.toString();
 }
 
-/* ───────────────────────── Recents loader (XBEL) ───────────────────────── */
-
-static QList<QUrl> loadRecentXbel(int maxItems = 50) {
-    QList<QUrl> out;
-
-    QString path = QDir::homePath() + "/.local/share/recently-used.xbel";
-    QFile f(path);
-    if (!f.open(QIODevice::ReadOnly)) return out;
-
-    QXmlStreamReader xr(&f);
-    while (!xr.atEnd()) {
-        xr.readNext();
-        if (xr.isStartElement() && xr.name() == "bookmark") {
-            auto attrs = xr.attributes();
-            if (attrs.hasAttribute("href")) {
-                QString href = attrs.value("href").toString();
-                QUrl u(href);
-                if (u.isValid()) out.append(u);
-                if (out.size() >= maxItems) break;
-            }
-        }
-    }
-    return out;
-}
+/* ───────────────────────── Recents categories ───────────────────────── */
 
 static bool extIn(const QString &ext, const QStringList &set) {
     QString e = ext.toLower();
@@ -160,12 +169,85 @@ static QString categoryForUrl(const QUrl &u) {
     return "System";
 }
 
+/* ───────────────────────── Intent search ───────────────────────── */
+
+static QVector<WospIntent::Item> intentApps() {
+    QVector<WospIntent::Item> out;
+    for (const WospAppDb::Entry &e : WospAppDb::load()) {
+        if (e.noDisplay || e.name.isEmpty() || e.exec.isEmpty()) continue;
+        QString exec = e.exec;
+        for (auto r : {"%U","%u","%F","%f","%i","%c","%k"}) exec.replace(r, "");
+        exec = exec.trimmed();
+        out.append({ WospIntent::App, e.name, exec,
+                     QFileInfo(e.path).completeBaseName() + " " + exec.section(' ', 0, 0) });
+    }
+    return out;
+}
+
+static QVector<WospIntent::Item> intentSettings() {
+    QVector<WospIntent::Item> out;
+    for (const WospSettingsPages::Page &p : WospSettingsPages::all())
+        out.append({ WospIntent::Setting, p.title, p.module, "settings " + p.sub });
+    return out;
+}
+
+// Top-level folders in $HOME and one level below them
+static QVector<WospIntent::Item> intentFolders() {
+    QVector<WospIntent::Item> out;
+    QDir home = QDir::home();
+    for (const QFileInfo &top : home.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        out.append({ WospIntent::Folder, top.fileName(), top.absoluteFilePath(), "folder" });
+        QDir sub(top.absoluteFilePath());
+        for (const QFileInfo &fi : sub.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+            out.append({ WospIntent::Folder, fi.fileName(), fi.absoluteFilePath(),
+                         top.fileName() + " folder" });
+    }
+    return out;
+}
+
+static QVector<WospIntent::Item> intentRecents() {
+    QVector<WospIntent::Item> out;
+    for (const QUrl &u : WospRecents::newest(200)) {
+        QString label = niceNameForUrl(u);
+        if (label.isEmpty()) continue;
+        out.append({ WospIntent::Recent, label, u.toString(),
+                     u.isLocalFile() ? u.toLocalFile() : u.host() });
+    }
+    return out;
+}
+
+static void activateIntent(const WospIntent::Item &it) {
+    switch (it.kind) {
+    case WospIntent::App: {
+        QStringList a = it.target.split(' ', Qt::SkipEmptyParts);
+        if (a.isEmpty()) return;
+        QString program = a.takeFirst();
+        launchTraced("pageLeft:" + QFileInfo(program).fileName(), program, a);
+        break;
+    }
+    case WospIntent::Setting:
+        launchTraced("osm-settings", "osm-settings", { it.target });
+        break;
+    case WospIntent::Folder:
+        launchTraced("osm-files", "osm-launch", { "osm-files", it.target });
+        break;
+    case WospIntent::Recent:
+        openTraced(QUrl(it.target));
+        break;
+    }
+}
+
 /* ───────────────────────── Section widget ───────────────────────── */
 
-static QWidget* makeSection(const QString &title, const QList<QUrl> &items, int takeN = 4) {
+// Pills are created once; fill() swaps labels and targets in place
+struct Section {
+    QWidget *widget;
+    std::function<void(const QList<QUrl>&)> fill;
+};
+
+static Section makeSection(const QString &title, int takeN = 4) {
     QWidget *w = new QWidget;
     w->setAttribute(Qt::WA_TranslucentBackground);
-    w->setStyleSheet("background:transparent;");
 
     QVBoxLayout *v = new QVBoxLayout(w);
     v->setContentsMargins(0,0,0,0);
@@ -178,46 +260,45 @@ static QWidget* makeSection(const QString &title, const QList<QUrl> &items, int
     row->setContentsMargins(0,0,0,0);
     row->setSpacing(12);
 
-    int added = 0;
-    for (const QUrl &u : items) {
-        if (added >= takeN) break;
-        QString label = niceNameForUrl(u);
-        if (label.isEmpty()) continue;
-
-        // keep pills compact
-        if (label.size() > 20) label = label.left(20) + "…";
-
-        QPushButton *b = pillButton(label);
-
-        QObject::connect(b, &QPushButton::clicked, b, [=]() {
-            QString target = u.toString();
-            if (u.isLocalFile()) target = u.toLocalFile();
-            QProcess::startDetached("xdg-open", { target });
-        });
-
-        row->addWidget(b);
-        added++;
-    }
-
-    // placeholders if empty
-    while (added < takeN) {
+    auto targets = std::make_shared<QList<QUrl>>();
+    QList<QPushButton*> pills;
+    for (int i = 0; i < takeN; ++i) {
         QPushButton *b = pillButton(" ");
-        b->setEnabled(false);
-        b->setStyleSheet(
-            "QPushButton{"
-            " background:rgba(160,160,160,120);"
-            " border:none;"
-            " border-radius:17px;"
-            " color:transparent;"
-            "}"
-        );
+        QObject::connect(b, &QPushButton::clicked, b, [targets, i]() {
+            if (i < targets->size()) openTraced(targets->at(i));
+        });
         row->addWidget(b);
-        added++;
+        pills.append(b);
     }
 
     row->addStretch();
     v->addLayout(row);
-    return w;
+
+    auto fill = [pills, targets, takeN](const QList<QUrl> &items) {
+        targets->clear();
+        for (const QUrl &u : items) {
+            if (targets->size() >= takeN) break;
+            if (!niceNameForUrl(u).isEmpty()) targets->append(u);
+        }
+
+        for (int i = 0; i < pills.size(); ++i) {
+            QPushButton *b = pills[i];
+            if (i < targets->size()) {
+                // keep pills compact
+                QString label = niceNameForUrl(targets->at(i));
+                if (label.size() > 20) label = label.left(20) + "…";
+                b->setText(label);
+                b->setEnabled(true);
+            } else {
+                // placeholder
+                b->setText(" ");
+                b->setEnabled(false);
+            }
+        }
+    };
+    fill({});
+
+    return { w, fill };
 }
 
 /* ───────────────────────── Entry point ───────────────────────── */
@@ -227,12 +308,12 @@ QWidget* make_page(QWidget *parent) {
 
     QWidget *root = new QWidget(parent);
     root->setAttribute(Qt::WA_TranslucentBackground);
-    root->setStyleSheet("background:transparent;");
+
+    if (!g_trace) g_trace = new WospLaunchTrace::Tracer(root);
 
     // Column matches your quicksettings sizing approach
     QWidget *column = new QWidget(root);
     column->setAttribute(Qt::WA_TranslucentBackground);
-    column->setStyleSheet("background:transparent;");
     column->setFixedWidth(560);
 
     QVBoxLayout *pv = new QVBoxLayout(column);
@@ -258,9 +339,96 @@ QWidget* make_page(QWidget *parent) {
         "}"
     );
 
+    pv->addWidget(search);
+
+    // Search results reuse a fixed set of pills; only text and target change
+    static const int RESULT_COLS = 3, RESULT_ROWS = 2;
+
+    QWidget *results = new QWidget;
+    results->setAttribute(Qt::WA_TranslucentBackground);
+    QVBoxLayout *rv = new QVBoxLayout(results);
+    rv->setContentsMargins(0,0,0,0);
+    rv->setSpacing(12);
+
+    auto hits = std::make_shared<QVector<WospIntent::Item>>();
+    QList<QPushButton*> pills;
+    for (int r = 0; r < RESULT_ROWS; ++r) {
+        QHBoxLayout *row = new QHBoxLayout;
+        row->setContentsMargins(0,0,0,0);
+        row->setSpacing(12);
+        for (int c = 0; c < RESULT_COLS; ++c) {
+            QPushButton *b = pillButton(" ");
+            int slot = pills.size();
+            QObject::connect(b, &QPushButton::clicked, b, [hits, slot]() {
+                if (slot < hits->size()) activateIntent(hits->at(slot));
+            });
+            row->addWidget(b);
+            pills.append(b);
+        }
+        row->addStretch();
+        rv->addLayout(row);
+    }
+    results->hide();
+    pv->addWidget(results);
+
+    auto *index = new WospIntent::Index(root);
+    index->setLimit(RESULT_COLS * RESULT_ROWS);
+    index->addSource(intentApps);
+    index->addSource(intentSettings);
+    index->addSource(intentFolders);
+    index->addSource(intentRecents);
+    index->rebuildNow();
+
+    // Rebuild when the app index or home folders change; recents below.
+    // The index is replaced by rename, so its directory is watched, but that
+    // directory also holds the icon and image atlases: only a new apps.db
+    // mtime counts.
+    auto *watch = new QFileSystemWatcher(root);
+    watch->addPath(QDir::homePath());
+    QString cacheDir = QFileInfo(WospAppDb::indexPath()).absolutePath();
+    watch->addPath(cacheDir);
+    QByteArray indexFile = QFile::encodeName(WospAppDb::indexPath());
+    auto indexStamp = std::make_shared<qint64>(WospAppDb::mtimeNs(indexFile));
+    QObject::connect(watch, &QFileSystemWatcher::directoryChanged, index,
+                     [index, cacheDir, indexFile, indexStamp](const QString &dir) {
+        if (dir == cacheDir) {
+            qint64 now = WospAppDb::mtimeNs(indexFile);
+            if (now == *indexStamp) return;
+            *indexStamp = now;
+        }
+        index->invalidate();
+    });
+
+    QWidget *recentsBox = new QWidget;
+    recentsBox->setAttribute(Qt::WA_TranslucentBackground);
+
+    index->onResults = [=](const QVector<WospIntent::Item> &found) {
+        *hits = found;
+        for (int i = 0; i < pills.size(); ++i) {
+            if (i < found.size()) {
+                QString label = found[i].title;
+                if (label.size() > 20) label = label.left(20) + "…";
+                pills[i]->setText(label);
+                pills[i]->show();
+            } else {
+                pills[i]->hide();
+            }
+        }
+        bool searching = !search->text().trimmed().isEmpty();
+        results->setVisible(searching);
+        recentsBox->setVisible(!searching);
+    };
+
+    QObject::connect(search, &QLineEdit::textChanged, index, [index](const QString &t) {
+        index->search(t);
+    });
+
+    // Enter opens the best local match; the web is only a fallback
     QObject::connect(search, &QLineEdit::returnPressed, search, [=]() {
         QString q = search->text().trimmed();
-        if (q.isEmpty()) {
+        if (!hits->isEmpty()) {
+            activateIntent(hits->first());
+        } else if (q.isEmpty()) {
             QProcess::startDetached("xdg-open", { "https://google.com" });
         } else {
             QString url = "https://www.google.com/search?q=" + QUrl::toPercentEncoding(q);
@@ -268,23 +436,36 @@ QWidget* make_page(QWidget *parent) {
         }
     });
 
-    pv->addWidget(search);
-
-    // Load and split recents
-    QList<QUrl> recents = loadRecentXbel(80);
-
-    QList<QUrl> comms, docs, sys;
-    for (const QUrl &u : recents) {
-        QString c = categoryForUrl(u);
-        if (c == "Comms") comms.append(u);
-        else if (c == "Documents") docs.append(u);
-        else sys.append(u);
-    }
+    Section comms = makeSection("Comms", 4);
+    Section docs = makeSection("Documents", 4);
+    Section sys = makeSection("System", 4);
+
+    QVBoxLayout *sv = new QVBoxLayout(recentsBox);
+    sv->setContentsMargins(0,0,0,0);
+    sv->setSpacing(22);
+    sv->addWidget(comms.widget);
+    sv->addWidget(docs.widget);
+    sv->addWidget(sys.widget);
+
+    // Newest recents, split by category; refreshed whenever the file changes
+    auto *recents = new WospRecents::Provider(80, root);
+    recents->onChanged = [=](const QList<QUrl> &urls) {
+        QList<QUrl> c, d, y;
+        for (const QUrl &u : urls) {
+            QString cat = categoryForUrl(u);
+            if (cat == "Comms") c.append(u);
+            else if (cat == "Documents") d.append(u);
+            else y.append(u);
+        }
+        comms.fill(c);
+        docs.fill(d);
+        sys.fill(y);
+        index->invalidate();
+    };
+    recents->reload();
 
     pv->addSpacing(8);
-    pv->addWidget(makeSection("Comms", comms, 4));
-    pv->addWidget(makeSection("Documents", docs, 4));
-    pv->addWidget(makeSection("System", sys, 4));
+    pv->addWidget(recentsBox);
     pv->addStretch();
 
     // Center the column like quicksettings page
@@ -7,14 +7,33 @@
 #include <QPushButton>
 #include <QProcess>
 #include <QDir>
+#include <QFile>
+#include <QRegularExpression>
 #include <QMouseEvent>
 #include <QTimer>
 #include <functional>
 
+#include "lib/wosp-nm.h"
+#include "lib/wosp-bluez.h"
+#include "lib/wosp-state.h"
+#include "lib/wosp-atlas.h"
+#include "lib/wosp-timers.h"
+#include "lib/wosp-theme.h"
+
+/* ───────────────────────── Page state ───────────────────────── */
+
+// Cards register themselves here; nothing is read until page_show()
+class Card;
+static QList<Card*> g_cards;
+static bool g_visible = false;
+static WospTimers::Periodic *g_tick = nullptr;   // re-fills polled cards while visible
+static const int POLL_MS = 10000;
+static const int BT_SCAN_SECONDS = 20;
+
 /* ───────────────────────── Paths ───────────────────────── */
 
-static QString imgPath(const QString &n) {
-    return QDir::homePath() + "/.config/wosp-shell/images/" + n;
+static WospAtlas::Atlas* images() {
+    return WospAtlas::Atlas::open(QDir::homePath() + "/.config/wosp-shell/images");
 }
 
 /* ───────────────────────── Clickable row ───────────────────────── */
@@ -51,18 +70,28 @@ public:
 
     void setState(State s) {
         state = s;
-        QString fn =
-            (s == On)  ? "on.png" :
-            (s == Off) ? "off.png" : "disabled.png";
-
-        QPixmap px(imgPath(fn));
-        setPixmap(px.scaled(size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        setPixmap(pixmapFor(s));
     }
 
 protected:
     void mousePressEvent(QMouseEvent*) override {
         if (onClick) onClick();
     }
+
+private:
+    // Scaled once per process from the shared atlas, then reused by every card
+    QPixmap pixmapFor(State s) const {
+        static QPixmap cache[3];
+        QPixmap &px = cache[s];
+        if (px.isNull()) {
+            const char *fn =
+                (s == On)  ? "on.png" :
+                (s == Off) ? "off.png" : "disabled.png";
+            px = QPixmap::fromImage(images()->load(fn).scaled(
+                size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        }
+        return px;
+    }
 };
 
 /* ─────────────────────────  info label (NO background) ───────────────────────── */
@@ -83,14 +112,16 @@ static QLabel* infoLabel(const QString &t) {
 
 static QLabel* dropItemLabel(const QString &t) {
     QLabel *l = new QLabel(t);
-    l->setStyleSheet(
-        "background:rgba(255,255,255,30);"
-        "border-radius:18px;"
-        "color:white;"
-        "font-size:20px;"
-        "line-height:26px;"
-        "padding:10px 12px;"
-    );
+
+    // Keeps the hairline the drop panel's stylesheet used to hand down
+    WospTheme::Shape item;
+    item.background = QColor(255,255,255,30);
+    item.border = QColor(255,255,255,60);
+    item.borderWidth = 1;
+    item.radius = 18;
+    item.padding = QMargins(12, 10, 12, 10);
+    WospTheme::setShape(l, item);
+    WospTheme::setText(l, Qt::white, 20);
     return l;
 }
 
@@ -107,11 +138,12 @@ public:
         l->addWidget(body);
         body->setVisible(false);
 
-        setStyleSheet(
-            "background:rgba(80,80,80,180);"
-            "border-radius:22px;"
-            "border:1px solid rgba(255,255,255,60);"
-        );
+        WospTheme::Shape panel;
+        panel.background = QColor(80,80,80,180);
+        panel.border = QColor(255,255,255,60);
+        panel.borderWidth = 1;
+        panel.radius = 22;
+        WospTheme::setShape(this, panel);
     }
 
     void toggle() {
@@ -121,68 +153,125 @@ public:
     }
 };
 
-/* ───────────────────────── Card setup ───────────────────────── */
-
-static QWidget* makeCard(
-    const QString &title,
-    ToggleLight *toggle,
-    QLabel *summary,
-    QWidget *dropBody
-) {
-    QFrame *card = new QFrame;
-    card->setStyleSheet(
-        "background:rgba(140,135,125,190);"
-        "border-radius:30px;"
-    );
+/* ───────────────────────── Async process ───────────────────────── */
+
+// Runs a program without waiting on it; done(stdout) on exit, "" if it
+// could not start. Stuck tools are killed after timeoutMs.
+static void readProcess(QObject *owner, const QString &prog, const QStringList &args,
+                        std::function<void(const QString&)> done, int timeoutMs = 5000)
+{
+    QProcess *p = new QProcess(owner);
+    QObject::connect(p, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), owner,
+                     [p, done](int, QProcess::ExitStatus) {
+        done(QString::fromUtf8(p->readAllStandardOutput()));
+        p->deleteLater();
+    });
+    QObject::connect(p, &QProcess::errorOccurred, owner, [p, done](QProcess::ProcessError e) {
+        if (e != QProcess::FailedToStart) return;   // finished() follows otherwise
+        done(QString());
+        p->deleteLater();
+    });
+    QTimer::singleShot(timeoutMs, p, [p]() { p->kill(); });
+    p->start(prog, args);
+}
 
-    QVBoxLayout *v = new QVBoxLayout(card);
-    v->setContentsMargins(22,18,22,22);
-    v->setSpacing(14);
+/* ───────────────────────── Card ───────────────────────── */
 
-    ClickRow *header = new ClickRow;
-    QHBoxLayout *h = new QHBoxLayout(header);
-    h->setContentsMargins(0,0,0,0);
+// A card is built at once with placeholder text and a Disabled light, so
+// make_page() never waits on anything. fill() starts the card's reads and
+// calls done() once the values are in. request() coalesces: any number of
+// requests in one event-loop turn cost one fill(), requests while the page
+// is hidden wait for page_show(), and a request during a running fill()
+// queues exactly one more.
+class Card : public QFrame {
+public:
+    ToggleLight *light;
+    QLabel *summary;
+    QVBoxLayout *body;              // drop-down contents
+    std::function<void()> fill;
+    bool poll = false;              // re-fill on g_tick while visible
+
+    Card(const QString &title, const QString &placeholder) {
+        WospTheme::Shape shape;
+        shape.background = QColor(140,135,125,190);
+        shape.radius = 30;
+        WospTheme::setShape(this, shape);
+
+        QVBoxLayout *v = new QVBoxLayout(this);
+        v->setContentsMargins(22,18,22,22);
+        v->setSpacing(14);
+
+        ClickRow *header = new ClickRow;
+        QHBoxLayout *h = new QHBoxLayout(header);
+        h->setContentsMargins(0,0,0,0);
+
+        QLabel *lbl = new QLabel(title);
+        lbl->setStyleSheet(
+            "background:transparent;"
+            "color:white;"
+            "font-size:36px;"
+        );
 
-    QLabel *lbl = new QLabel(title);
-    lbl->setStyleSheet(
-        "background:transparent;"
-        "color:white;"
-        "font-size:36px;"
-    );
+        light = new ToggleLight;
+        h->addWidget(lbl);
+        h->addStretch();
+        h->addWidget(light);
 
-    h->addWidget(lbl);
-    h->addStretch();
-    h->addWidget(toggle);
+        QWidget *dropBody = new QWidget;
+        dropBody->setAttribute(Qt::WA_TranslucentBackground);
+        dropBody->setStyleSheet("background:transparent;");
+        body = new QVBoxLayout(dropBody);
+        body->setSpacing(12);
 
-    DropPanel *drop = new DropPanel(dropBody);
-    header->onClick = [=]() { drop->toggle(); };
+        DropPanel *drop = new DropPanel(dropBody);
+        header->onClick = [=]() { drop->toggle(); };
 
-    ClickRow *summaryRow = new ClickRow;
-    QHBoxLayout *sr = new QHBoxLayout(summaryRow);
-    sr->setContentsMargins(0,0,0,0);
-    sr->addWidget(summary);
-    summaryRow->onClick = [=]() { drop->toggle(); };
+        summary = infoLabel(placeholder);
+        ClickRow *summaryRow = new ClickRow;
+        QHBoxLayout *sr = new QHBoxLayout(summaryRow);
+        sr->setContentsMargins(0,0,0,0);
+        sr->addWidget(summary);
+        summaryRow->onClick = [=]() { drop->toggle(); };
 
-    v->addWidget(header);
-    v->addWidget(summaryRow);
-    v->addWidget(drop);
+        v->addWidget(header);
+        v->addWidget(summaryRow);
+        v->addWidget(drop);
 
-    return card;
-}
+        g_cards.append(this);
+    }
 
-/* ───────────────────────── Wi-Fi card ───────────────────────── */
+    ~Card() override { g_cards.removeOne(this); }
+
+    void request() {
+        m_stale = true;
+        if (!g_visible || m_busy || m_queued || !fill) return;
+        m_queued = true;
+        QTimer::singleShot(0, this, [this]() {
+            m_queued = false;
+            if (!g_visible || m_busy) return;
+            m_stale = false;
+            m_busy = true;
+            fill();
+        });
+    }
 
-static QWidget* wifiCard() {
-    QWidget *body = new QWidget;
-    body->setAttribute(Qt::WA_TranslucentBackground);
-    body->setStyleSheet("background:transparent;");
-    QVBoxLayout *v = new QVBoxLayout(body);
-    v->setSpacing(12);
+    void done() {
+        m_busy = false;
+        if (m_stale) request();
+    }
+
+    // page_show(): catch up on anything requested while hidden
+    void resume() {
+        if (m_stale) request();
+    }
 
-    QLabel *ssid = dropItemLabel("SSID:");
-    QLabel *ip   = dropItemLabel("IP Address:");
-    QLabel *dns  = dropItemLabel("DNS Server:");
+private:
+    bool m_stale = true;    // first show always fills
+    bool m_busy = false;
+    bool m_queued = false;
+};
 
+static QPushButton* scanButton() {
     QPushButton *scan = new QPushButton("SCAN");
     scan->setStyleSheet(
         "background:#3cff3c;"
@@ -192,131 +281,248 @@ static QWidget* wifiCard() {
         "padding:12px;"
         "font-size:20px;"
     );
+    return scan;
+}
 
-    v->addWidget(ssid);
-    v->addWidget(ip);
-    v->addWidget(dns);
-    v->addWidget(scan);
+/* ───────────────────────── Wi-Fi card ───────────────────────── */
 
-    QLabel *summary = infoLabel("SSID:");
-    ToggleLight *t = new ToggleLight;
+static QWidget* wifiCard() {
+    Card *card = new Card("WIFI", "SSID: …");
 
-    auto refresh = [=]() {
-        QProcess p;
+    QLabel *ssid = dropItemLabel("SSID: …");
+    QLabel *ip   = dropItemLabel("IP Address: …");
+    QLabel *dns  = dropItemLabel("DNS Server: …");
+    QPushButton *scan = scanButton();
 
-        p.start("nmcli", {"-t","-f","ACTIVE,SSID","dev","wifi"});
-        p.waitForFinished();
-        QString ss;
-        for (const QString &l : QString::fromUtf8(p.readAll()).split('\n')) {
-            if (l.startsWith("yes:")) ss = l.mid(4);
-        }
+    card->body->addWidget(ssid);
+    card->body->addWidget(ip);
+    card->body->addWidget(dns);
+    card->body->addWidget(scan);
 
-        p.start("nmcli", {"-g","IP4.ADDRESS","dev","show"});
-        p.waitForFinished();
-        QString ipaddr = QString::fromUtf8(p.readAll()).split('\n').value(0);
+    // NetworkManager pushes changes; the card only repaints while shown
+    auto *nm = new WospNm::Client(card);
+    nm->listen([card]() { card->request(); });
 
-        p.start("nmcli", {"-g","IP4.DNS","dev","show"});
-        p.waitForFinished();
-        QString dnsaddr = QString::fromUtf8(p.readAll()).split('\n').value(0);
+    card->fill = [=]() {
+        const WospNm::State &st = nm->state();
+        QString ipaddr = st.address.isEmpty() ? QString()
+                       : st.address + "/" + QString::number(st.prefix);
 
-        ssid->setText("SSID: " + ss);
+        ssid->setText("SSID: " + st.ssid);
         ip->setText("IP Address: " + ipaddr);
-        dns->setText("DNS Server: " + dnsaddr);
-        summary->setText("SSID: " + ss);
+        dns->setText("DNS Server: " + st.dns.value(0));
+        card->summary->setText("SSID: " + st.ssid);
 
-        p.start("nmcli", {"radio","wifi"});
-        p.waitForFinished();
-        bool on = QString::fromUtf8(p.readAll()).trimmed() == "enabled";
-        t->setState(on ? ToggleLight::On : ToggleLight::Off);
+        if (!st.available) card->light->setState(ToggleLight::Disabled);
+        else card->light->setState(st.wirelessEnabled ? ToggleLight::On : ToggleLight::Off);
+        card->done();
     };
 
-    t->onClick = [=]() {
-        bool on = (t->state == ToggleLight::On);
-        QProcess::startDetached("nmcli", {"radio","wifi", on ? "off" : "on"});
-        QTimer::singleShot(400, refresh);
+    card->light->onClick = [=]() {
+        if (card->light->state == ToggleLight::Disabled) return;
+        nm->setWirelessEnabled(card->light->state != ToggleLight::On);
     };
 
-    QObject::connect(scan, &QPushButton::clicked, scan, refresh);
+    QObject::connect(scan, &QPushButton::clicked, scan, [nm]() { nm->requestScan(); });
 
-    refresh();
-    return makeCard("WIFI", t, summary, body);
+    return card;
 }
 
 /* ───────────────────────── Bluetooth card ───────────────────────── */
 
 static QWidget* btCard() {
-    QWidget *body = new QWidget;
-    body->setAttribute(Qt::WA_TranslucentBackground);
-    body->setStyleSheet("background:transparent;");
-    QVBoxLayout *v = new QVBoxLayout(body);
-    v->setSpacing(12);
+    Card *card = new Card("Bluetooth", "Connected: …");
 
     QLabel *label = dropItemLabel("Devices:");
     QLabel *list  = dropItemLabel("");
+    QPushButton *scan = scanButton();
 
-    QPushButton *scan = new QPushButton("SCAN");
-    scan->setStyleSheet(
-        "background:#3cff3c;"
-        "border-radius:18px;"
-        "border:none;"
-        "background-clip:padding;"
-        "padding:12px;"
-        "font-size:20px;"
-    );
+    card->body->addWidget(label);
+    card->body->addWidget(list);
+    card->body->addWidget(scan);
 
-    v->addWidget(label);
-    v->addWidget(list);
-    v->addWidget(scan);
+    // BlueZ signals keep the device table current; repaint only while shown
+    auto *bluez = new WospBluez::Client(card);
+    bluez->listen([card]() { card->request(); });
 
-    QLabel *summary = infoLabel("Connected:");
-    ToggleLight *t = new ToggleLight;
+    card->fill = [=]() {
+        const WospBluez::State &st = bluez->state();
+        if (!st.available) card->light->setState(ToggleLight::Disabled);
+        else card->light->setState(st.powered ? ToggleLight::On : ToggleLight::Off);
 
-    auto refreshBt = [=]() {
-        QProcess p;
-        p.start("bluetoothctl", {"show"});
-        p.waitForFinished();
-        bool on = QString::fromUtf8(p.readAll()).contains("Powered: yes");
-        t->setState(on ? ToggleLight::On : ToggleLight::Off);
+        QStringList connected, names;
+        for (const WospBluez::Device &d : bluez->devices()) {
+            if (d.connected) connected << d.name;
+            if (d.connected || d.paired || d.inRange) names << d.name;
+        }
+        card->summary->setText("Connected: " + connected.join(", "));
+        label->setText(st.discovering ? "Devices: scanning…" : "Devices:");
+        list->setText(names.join("\n"));
+        card->done();
     };
 
-    t->onClick = [=]() {
-        bool on = (t->state == ToggleLight::On);
-        QProcess::startDetached("bluetoothctl", {"power", on ? "off" : "on"});
-        QTimer::singleShot(400, refreshBt);
+    card->light->onClick = [=]() {
+        if (card->light->state == ToggleLight::Disabled) return;
+        bluez->setPowered(card->light->state != ToggleLight::On);
     };
 
-    QObject::connect(scan, &QPushButton::clicked, scan, [=]() {
-        QProcess::startDetached("bluetoothctl", {"scan","on"});
-        QTimer::singleShot(2000, [=]() {
-            QProcess p;
-            p.start("bluetoothctl", {"devices"});
-            p.waitForFinished();
-            list->setText(QString::fromUtf8(p.readAll()).trimmed());
-            refreshBt();
-        });
+    QObject::connect(scan, &QPushButton::clicked, scan, [bluez]() {
+        bluez->startDiscovery(BT_SCAN_SECONDS);
     });
 
-    refreshBt();
-    return makeCard("Bluetooth", t, summary, body);
+    return card;
 }
 
-/* ───────────────────────── Simple cards (place holders) ───────────────────────── */
+/* ───────────────────────── GPS card ───────────────────────── */
+
+static QWidget* gpsCard() {
+    Card *card = new Card("GPS", "Visible Satellites: …");
+    QLabel *fix = dropItemLabel("Position: …");
+    card->body->addWidget(fix);
+    card->poll = true;
+
+    // Same source and satellite count as osm-settings' Location page
+    card->fill = [=]() {
+        readProcess(card, "gpspipe", {"-w", "-n", "10"}, [=](const QString &out) {
+            if (out.isEmpty()) {
+                card->light->setState(ToggleLight::Disabled);
+                card->summary->setText("Visible Satellites: gpsd not running");
+                fix->setText("Position: -");
+                card->done();
+                return;
+            }
+
+            QRegularExpression latRe("\"lat\"\\s*:\\s*([-0-9\\.]+)");
+            QRegularExpression lonRe("\"lon\"\\s*:\\s*([-0-9\\.]+)");
+            QRegularExpressionMatch lat = latRe.match(out), lon = lonRe.match(out);
+            bool hasFix = lat.hasMatch() && lon.hasMatch();
+
+            card->light->setState(hasFix ? ToggleLight::On : ToggleLight::Off);
+            card->summary->setText(QString("Visible Satellites: %1").arg(out.count("\"PRN\"")));
+            fix->setText(hasFix ? QString("Position: %1, %2").arg(lat.captured(1), lon.captured(1))
+                                : QString("Position: no fix"));
+            card->done();
+        }, 8000);
+    };
 
-static QWidget* simpleCard(const QString &title, const QString &text) {
-    QLabel *summary = infoLabel(text);
+    return card;
+}
 
-    QWidget *body = new QWidget;
-    body->setAttribute(Qt::WA_TranslucentBackground);
-    body->setStyleSheet("background:transparent;");
-    QVBoxLayout *v = new QVBoxLayout(body);
-    v->setSpacing(12);
+/* ───────────────────────── Mobile Data card ───────────────────────── */
 
-    v->addWidget(dropItemLabel(text));
+static QWidget* mobileCard() {
+    Card *card = new Card("Mobile Data", "Carrier: …");
+    QLabel *state  = dropItemLabel("State: …");
+    QLabel *signal = dropItemLabel("Signal: …");
+    card->body->addWidget(state);
+    card->body->addWidget(signal);
+    card->poll = true;
 
-    ToggleLight *t = new ToggleLight;
-    t->setState(ToggleLight::Disabled);
+    auto field = [](const QString &out, const QString &key) {
+        for (const QString &line : out.split('\n')) {
+            QString t = line.section('|', -1).trimmed();
+            if (t.startsWith(key + ":", Qt::CaseInsensitive)) return t.section(':', 1).trimmed();
+        }
+        return QString();
+    };
 
-    return makeCard(title, t, summary, body);
+    card->fill = [=]() {
+        readProcess(card, "mmcli", {"-L"}, [=](const QString &list) {
+            if (!list.contains("Modem", Qt::CaseInsensitive)) {
+                card->light->setState(ToggleLight::Disabled);
+                card->summary->setText("No modem detected");
+                state->setText("State: -");
+                signal->setText("Signal: -");
+                card->done();
+                return;
+            }
+            readProcess(card, "mmcli", {"-m", "0"}, [=](const QString &out) {
+                QString st = field(out, "state");
+                bool on = st.contains("connected") || st.contains("registered")
+                       || st.contains("enabled");
+                QString carrier = field(out, "operator name");
+
+                card->light->setState(on ? ToggleLight::On : ToggleLight::Off);
+                card->summary->setText("Carrier: " + (carrier.isEmpty() ? QString("-") : carrier));
+                state->setText("State: " + st);
+                signal->setText("Signal: " + field(out, "signal quality"));
+                card->done();
+            });
+        });
+    };
+
+    return card;
+}
+
+/* ───────────────────────── Battery Saver card ───────────────────────── */
+
+static QString readSys(const QString &path) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromLatin1(f.readAll()).trimmed();
+}
+
+static QString batteryDir() {
+    QDir dir("/sys/class/power_supply");
+    for (const QString &e : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (readSys(dir.filePath(e) + "/type") == "Battery") return dir.filePath(e);
+    }
+    return QString();
+}
+
+// Fallback while wosp-stated is not running
+static void readBatterySysfs(int &pct, int &minutesLeft) {
+    pct = minutesLeft = -1;
+    QString bat = batteryDir();
+    if (bat.isEmpty()) return;
+
+    QString cap = readSys(bat + "/capacity");
+    if (!cap.isEmpty()) pct = cap.toInt();
+
+    if (readSys(bat + "/status") != "Discharging") return;
+    double now = readSys(bat + "/energy_now").toDouble();
+    double rate = readSys(bat + "/power_now").toDouble();
+    if (rate <= 0) {
+        now = readSys(bat + "/charge_now").toDouble();
+        rate = readSys(bat + "/current_now").toDouble();
+    }
+    if (rate > 0) minutesLeft = int(now / rate * 60.0);
+}
+
+static QWidget* batteryCard() {
+    Card *card = new Card("Battery Saver", "Battery: …");
+    QLabel *remain = dropItemLabel("Time Remaining: …");
+    card->body->addWidget(remain);
+
+    // wosp-stated pushes battery changes; poll sysfs only without it
+    auto *sysState = new WospState::Client(card);
+    sysState->onChanged = [card](const WospState::Snapshot&) { card->request(); };
+
+    card->fill = [=]() {
+        int pct, mins;
+        card->poll = !sysState->available();
+        if (sysState->available()) {
+            WospState::Snapshot st = sysState->state();
+            pct = st.batteryPct;
+            mins = st.batteryStatus == WospState::Discharging ? st.minutesLeft : -1;
+        } else {
+            readBatterySysfs(pct, mins);
+        }
+
+        card->summary->setText("Battery: " + (pct < 0 ? QString("-") : QString("%1 %").arg(pct)));
+        remain->setText("Time Remaining: " + (mins < 0 ? QString("-")
+                        : QString("%1h %2m").arg(mins / 60).arg(mins % 60)));
+
+        readProcess(card, "powerprofilesctl", {"get"}, [=](const QString &out) {
+            QString profile = out.trimmed();
+            if (profile.isEmpty()) card->light->setState(ToggleLight::Disabled);
+            else card->light->setState(profile == "power-saver" ? ToggleLight::On
+                                                                : ToggleLight::Off);
+            card->done();
+        });
+    };
+
+    return card;
 }
 
 /* ───────────────────────── Entry point ───────────────────────── */
@@ -326,11 +532,9 @@ QWidget* make_page(QWidget *parent) {
 
     QWidget *root = new QWidget(parent);
     root->setAttribute(Qt::WA_TranslucentBackground);
-    root->setStyleSheet("background:transparent;");
 
     QWidget *column = new QWidget(root);
     column->setAttribute(Qt::WA_TranslucentBackground);
-    column->setStyleSheet("background:transparent;");
     column->setFixedWidth(560); // +1/3 width
 
     QVBoxLayout *pv = new QVBoxLayout(column);
@@ -339,9 +543,9 @@ QWidget* make_page(QWidget *parent) {
 
     pv->addWidget(wifiCard());
     pv->addWidget(btCard());
-    pv->addWidget(simpleCard("GPS","Visible Satellites"));
-    pv->addWidget(simpleCard("Mobile Data","Visible Stations"));
-    pv->addWidget(simpleCard("Battery Saver","Battery %, Time Remaining"));
+    pv->addWidget(gpsCard());
+    pv->addWidget(mobileCard());
+    pv->addWidget(batteryCard());
     pv->addStretch();
 
     QHBoxLayout *center = new QHBoxLayout(root);
@@ -354,5 +558,29 @@ QWidget* make_page(QWidget *parent) {
     root->setGeometry(parent->rect());
     root->lower();
     root->show();
+
+    g_tick = new WospTimers::Periodic("quick-poll", POLL_MS, root, []() {
+        for (Card *c : g_cards)
+            if (c->poll) c->request();
+    });
     return root;
 }
+
+extern "C"
+void page_show(QWidget *) {
+    g_visible = true;
+    for (Card *c : g_cards) c->resume();
+    if (g_tick) g_tick->start();
+}
+
+extern "C"
+void page_hide(QWidget *) {
+    g_visible = false;
+    if (g_tick) g_tick->stop();
+}
+
+extern "C"
+void page_suspend(QWidget *) {
+    g_visible = false;
+    if (g_tick) g_tick->stop();
+}
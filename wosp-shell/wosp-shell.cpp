@@ -4,11 +4,15 @@
 #include <QWidget>
 #include <QPainter>
 #include <QPixmap>
-#include <QPropertyAnimation>
-#include <QParallelAnimationGroup>
+#include <QVariantAnimation>
+#include <QPaintEvent>
+#include <QRegion>
 #include <QVBoxLayout>
-#include <QGridLayout>
-#include <QScrollArea>
+#include <QListView>
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QResizeEvent>
+#include <QHash>
 #include <QMouseEvent>
 #include <QDirIterator>
 #include <QSettings>
@@ -25,9 +29,24 @@
 #include <QLibrary>
 #include <QTime>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFileInfo>
 #include <QDebug>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+
+#include "lib/wosp-appdb.h"
+#include "lib/wosp-iconcache.h"
+#include "lib/wosp-launchstats.h"
+#include "lib/wosp-backlight.h"
+#include "lib/wosp-launchtrace.h"
+#include "lib/wosp-bus.h"
+#include "lib/wosp-config.h"
+#include "lib/wosp-atlas.h"
+#include "lib/wosp-timers.h"
+#include "lib/wosp-theme.h"
+#include "lib/wosp-zygote.h"
 
 /* ───────────────────────── CONFIG ───────────────────────── */
 
@@ -37,12 +56,27 @@ static constexpr int BRIGHTNESS_TOP_MARGIN = 10;
 static constexpr int BRIGHTNESS_HEIGHT = 80;
 static constexpr int ACTIVATION_BAR_W = 720 / 3; // 240
 
+static constexpr int APP_COLUMNS = 4;
+static constexpr int APP_SPACING = 12;
+static constexpr int APP_MARGIN = 20;
+static constexpr int APP_ICON = 64;
+static constexpr int APP_TILE_H = 190;
+
+static constexpr int PREWARM_DELAY_MS = 3000;   // idle time before building pages
+static constexpr int PREFETCH_APPS = 8;          // top apps kept warm in page cache
+static constexpr int PREFETCH_PERIOD_MS = 600000; // re-warm them while idle
+
 /* ───────────────────────── HELPERS ───────────────────────── */
 
-static QString imgPath(const QString &name) {
+static QString imageDir() {
     return QStandardPaths::writableLocation(
         QStandardPaths::ConfigLocation
-    ) + "/wosp-shell/images/" + name;
+    ) + "/wosp-shell/images";
+}
+
+// Decoded once into the shared atlas; see lib/wosp-atlas.h
+static QImage image(const QString &name) {
+    return WospAtlas::Atlas::open(imageDir())->load(name);
 }
 
 static QString cleanExec(QString s) {
@@ -53,31 +87,17 @@ static QString cleanExec(QString s) {
 /* ───────────────────────── APP LOADING ───────────────────────── */
 
 struct AppEntry {
+    QString id;     // desktop file name, keys launch stats
     QString name;
     QString exec;
     QString icon;
 };
 
-static QList<AppEntry> loadApps() {
+static QList<AppEntry> launcherApps(const QVector<WospAppDb::Entry> &db) {
     QList<AppEntry> out;
-    QStringList dirs = {
-        QDir::homePath() + "/.local/share/applications",
-        "/usr/share/applications"
-    };
-
-    for (const QString &d : dirs) {
-        QDirIterator it(d, {"*.desktop"}, QDir::Files, QDirIterator::Subdirectories);
-        while (it.hasNext()) {
-            QSettings s(it.next(), QSettings::IniFormat);
-            s.beginGroup("Desktop Entry");
-            if (s.value("NoDisplay","false").toString() == "true") continue;
-            out.append({
-                s.value("Name").toString(),
-                cleanExec(s.value("Exec").toString()),
-                s.value("Icon").toString()
-            });
-            s.endGroup();
-        }
+    for (const WospAppDb::Entry &e : db) {
+        if (e.noDisplay) continue;
+        out.append({ QFileInfo(e.path).fileName(), e.name, cleanExec(e.exec), e.icon });
     }
 
     std::sort(out.begin(), out.end(),
@@ -115,36 +135,184 @@ protected:
     void mouseReleaseEvent(QMouseEvent*) override;
 };
 
-/* ───────────────────────── APP TILE ───────────────────────── */
+/* ───────────────────────── APP GRID ───────────────────────── */
 
-class AppTile : public QFrame {
-    AppEntry entry;
-    WospShell *shell;
+// Virtualized launcher grid: one model row per app, cells are painted by
+// AppDelegate only while visible, so widget count stays flat.
+
+class AppModel : public QAbstractListModel {
+    QList<AppEntry> apps;
+    WospIcons::Cache *icons;
+
+public:
+    explicit AppModel(QObject *parent=nullptr)
+        : QAbstractListModel(parent), icons(new WospIcons::Cache(APP_ICON, this))
+    {
+        // Cells showing the placeholder pick up their icon once the atlas lands
+        icons->onUpdated = [this]{
+            if (!apps.isEmpty())
+                emit dataChanged(index(0), index(apps.size() - 1), {Qt::DecorationRole});
+        };
+    }
+
+    // Optional "top apps" row first, padded to a full row, then all apps
+    void setApps(const QList<AppEntry> &all, const QList<AppEntry> &top) {
+        beginResetModel();
+        apps = top;
+        if (!top.isEmpty())
+            while (apps.size() % APP_COLUMNS) apps.append(AppEntry());
+        apps += all;
+        endResetModel();
+
+        QStringList names;
+        for (const AppEntry &e : all) names << e.icon;
+        icons->request(names);
+    }
+
+    static bool isSpacer(const AppEntry &e) { return e.id.isEmpty() && e.exec.isEmpty(); }
+
+    const AppEntry &at(int row) const { return apps.at(row); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : apps.size();
+    }
+
+    QVariant data(const QModelIndex &i, int role) const override {
+        if (!i.isValid() || i.row() >= apps.size()) return {};
+        const AppEntry &e = apps.at(i.row());
+
+        if (role == Qt::UserRole) return isSpacer(e);
+        if (role == Qt::DisplayRole) return e.name;
+        if (role == Qt::DecorationRole) return icons->pixmap(e.icon);
+        return {};
+    }
+};
+
+class AppDelegate : public QStyledItemDelegate {
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *p, const QStyleOptionViewItem &opt, const QModelIndex &i) const override {
+        static const QColor tileBg("#00000099");
+        if (i.data(Qt::UserRole).toBool()) return;   // top row padding
+
+        QRect r = opt.rect.adjusted(APP_SPACING/2, APP_SPACING/2, -APP_SPACING/2, -APP_SPACING/2);
+        QRect inner = r.adjusted(16, 16, -16, -16);
+
+        p->save();
+        p->setRenderHint(QPainter::Antialiasing);
+        p->setPen(Qt::NoPen);
+        p->setBrush(tileBg);
+        p->drawRoundedRect(r, 20, 20);
+
+        QRect iconRect(inner.x() + (inner.width() - APP_ICON) / 2, inner.y(), APP_ICON, APP_ICON);
+        QPixmap pix = i.data(Qt::DecorationRole).value<QPixmap>();
+
+        QFont f = opt.font;
+        p->setPen(Qt::white);
+        if (pix.isNull()) {
+            f.setPointSize(32);
+            p->setFont(f);
+            p->drawText(iconRect, Qt::AlignCenter, "🧩");
+        } else {
+            QSize ps = pix.size() / pix.devicePixelRatio();
+            p->drawPixmap(QRect(iconRect.center() - QPoint(ps.width()/2, ps.height()/2), ps), pix);
+        }
+
+        f.setPointSize(16);
+        p->setFont(f);
+        QRect textRect(inner.x(), iconRect.bottom() + 8, inner.width(), inner.bottom() - iconRect.bottom() - 8);
+        p->drawText(textRect, Qt::AlignHCenter | Qt::AlignTop | Qt::TextWordWrap, i.data().toString());
+        p->restore();
+    }
+
+    QSize sizeHint(const QStyleOptionViewItem &opt, const QModelIndex &) const override {
+        auto *view = qobject_cast<const QListView*>(opt.widget);
+        if (view && view->gridSize().isValid()) return view->gridSize();
+        return QSize(APP_TILE_H, APP_TILE_H + APP_SPACING);
+    }
+};
 
+class AppGridView : public QListView {
 public:
-    AppTile(const AppEntry &e, WospShell *s, QWidget *parent=nullptr);
+    explicit AppGridView(QWidget *parent=nullptr) : QListView(parent) {
+        setViewMode(QListView::IconMode);
+        setFlow(QListView::LeftToRight);
+        setWrapping(true);
+        setMovement(QListView::Static);
+        setResizeMode(QListView::Adjust);
+        setUniformItemSizes(true);
+        setSelectionMode(QAbstractItemView::NoSelection);
+        setEditTriggers(QAbstractItemView::NoEditTriggers);
+        setFocusPolicy(Qt::NoFocus);
+        setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+        setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        setFrameShape(QFrame::NoFrame);
+        setViewportMargins(APP_MARGIN - APP_SPACING/2, APP_MARGIN - APP_SPACING/2,
+                           APP_MARGIN - APP_SPACING/2, APP_MARGIN - APP_SPACING/2);
+        setStyleSheet("QListView{border:none;background:transparent;}");
+        viewport()->setAutoFillBackground(false);
+    }
 
 protected:
-    void mousePressEvent(QMouseEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override {
+        QListView::resizeEvent(e);
+        int cell = viewport()->width() / APP_COLUMNS;
+        if (cell > 0 && gridSize().width() != cell)
+            setGridSize(QSize(cell, APP_TILE_H + APP_SPACING));
+    }
+};
+
+/* ───────────────────────── PAGE PLUGINS ─────────────────────────
+   Page .so ABI (all extern "C"):
+     QWidget* make_page(QWidget *parent)   required
+     void page_show(QWidget *page)          optional, page became visible
+     void page_hide(QWidget *page)          optional, another page took over
+     void page_suspend(QWidget *page)       optional, overlay closed
+   Pages are built on first use or prewarmed once the shell is idle, so
+   make_page must stay cheap and leave polling to page_show.          */
+
+using PageHook = void(*)(QWidget*);
+
+enum PageId { PageApps, PageUp, PageLeft, PageRight, PageCount };
+
+struct PagePlugin {
+    QString soPath;
+    std::function<QWidget*()> fallback;
+    QLibrary lib;
+    QWidget *page = nullptr;
+    PageHook onShow = nullptr;
+    PageHook onHide = nullptr;
+    PageHook onSuspend = nullptr;
+    bool visible = false;
 };
 
 /* ───────────────────────── WospShell ───────────────────────── */
 
 class WospShell : public QWidget {
-    QLabel *topCurve = nullptr;
-    QLabel *bottomCurve = nullptr;
     HomeButton *home = nullptr;
 
-    QPixmap topPix, bottomPix;
+    // The dim and both curves are painted by the shell itself. While the
+    // curves slide only their old and new rects are repainted; at rest every
+    // repaint is a straight copy out of restFrame.
+    QImage topImg, bottomImg;
+    QPixmap restFrame;
+    qreal slide = 0.0;                  // 0 = curves off-screen, 1 = in place
+    QVariantAnimation *slideAnim = nullptr;
+    std::function<void()> slideDone;
 
-    QWidget *appsPage = nullptr;
-    QWidget *pageLeft = nullptr;
-    QWidget *pageRight = nullptr;
-    QWidget *pageUp = nullptr;
+    PagePlugin pages[PageCount];
 
     QWidget *brightnessWidget = nullptr;
+    WospBacklight *backlight = nullptr;
 
-    QScrollArea *scroll = nullptr;
+    AppGridView *appGrid = nullptr;
+    AppModel *appModel = nullptr;
+    WospAppDb::Watcher *appWatcher = nullptr;
+    WospLaunchStats *launchStats = nullptr;
+    WospLaunchTrace::Tracer *launchTrace = nullptr;
+    QList<AppEntry> allApps;
 
     bool openState = false;
     bool openToUp = false;
@@ -152,10 +320,6 @@ class WospShell : public QWidget {
     ActivationBar *barBottom = nullptr;
     ActivationBarTop *barTop = nullptr;
 
-    QLibrary appsLib;
-    QLibrary quickLib;
-    QLibrary leftLib;
-    QLibrary rightLib;
 
 public:
     WospShell();
@@ -174,12 +338,25 @@ public:
     void showRight();
     void showUp();
 
+    void launchApp(const AppEntry &e);
+
 protected:
     QWidget* buildAppsPage();
+    void populateApps(const QList<AppEntry> &apps);
+    void refreshAppModel();
+    void prefetchTopApps();
     QWidget* buildPlaceholder(const QString &label);
     QWidget* buildBrightness();
-    QWidget* loadPageSo(const QString &soPath, QLibrary &libKeepAlive, QWidget *fallback);
+    QWidget* page(PageId id);
+    void showPage(PageId id);
+    void hidePage(PageId id, bool suspend);
+    void prewarmPages();
+    QRect topCurveRect() const;
+    QRect bottomCurveRect() const;
+    void setSlide(qreal v);
+    void animateSlide(qreal to, int ms, std::function<void()> done);
     void paintEvent(QPaintEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
 };
 
 /* ───────────────────────── ACTIVATION BARS ───────────────────────── */
@@ -277,8 +454,8 @@ protected:
 HomeButton::HomeButton(WospShell *s, QWidget *p)
     : QLabel(p), shell(s)
 {
-    normalPix = QPixmap(imgPath("centre.png"));
-    pressPix  = QPixmap(imgPath("centre_press.png"));
+    normalPix = QPixmap::fromImage(image("centre.png"));
+    pressPix  = QPixmap::fromImage(image("centre_press.png"));
     setPixmap(normalPix);
     setFixedSize(normalPix.size());
 }
@@ -324,42 +501,6 @@ void HomeButton::mouseReleaseEvent(QMouseEvent*) {
     else if (!moved) shell->closeOverlayAnimated();
 }
 
-/* ───────────────────────── AppTile ───────────────────────── */
-
-AppTile::AppTile(const AppEntry &e, WospShell *s, QWidget *p)
-    : QFrame(p), entry(e), shell(s)
-{
-    setStyleSheet("QFrame { background:#00000099; border-radius:20px; }");
-
-    QVBoxLayout *v = new QVBoxLayout(this);
-    v->setContentsMargins(16,16,16,16);
-
-    QLabel *icon = new QLabel;
-    icon->setAlignment(Qt::AlignCenter);
-
-    QIcon ic = QIcon::fromTheme(entry.icon);
-    QPixmap pix = ic.isNull() ? QPixmap() : ic.pixmap(64,64);
-    if (pix.isNull()) icon->setText("🧩");
-    else icon->setPixmap(pix);
-
-    QLabel *lbl = new QLabel(entry.name);
-    lbl->setAlignment(Qt::AlignCenter);
-    lbl->setWordWrap(true);
-    lbl->setStyleSheet("color:white;font-size:16pt;");
-
-    v->addWidget(icon);
-    v->addWidget(lbl);
-}
-
-void AppTile::mousePressEvent(QMouseEvent *e) {
-    if (e->button() == Qt::LeftButton) {
-        shell->closeOverlayAnimated();
-        QStringList a = entry.exec.split(' ');
-        QString p = a.takeFirst();
-        QProcess::startDetached(p, a);
-    }
-}
-
 /* ───────────────────────── WospShell core ───────────────────────── */
 
 QWidget* WospShell::buildPlaceholder(const QString &label) {
@@ -395,15 +536,12 @@ QWidget* WospShell::buildBrightness() {
 
     updateClock();
 
-    QTimer *timer = new QTimer(lbl);
-    QObject::connect(timer, &QTimer::timeout, lbl, updateClock);
-    timer->start(1000);
+    // Only the minute is shown: wake on the minute, not every second
+    WospTimers::Periodic::minute("overlay-clock", lbl, updateClock);
 
-    int savedBrightness = 80;
-    {
-        QSettings s("Alternix", "wosp-shell");
-        savedBrightness = s.value("brightness", 80).toInt();
-    }
+    WospConfig::Store *cfg = WospConfig::Store::open(
+        QDir::homePath() + "/.config/Alternix/wosp-shell.conf");
+    int savedBrightness = cfg->intValue("brightness", 80);
 
     QSlider *s = new QSlider(Qt::Horizontal);
     s->setRange(20, 100);
@@ -420,17 +558,12 @@ QWidget* WospShell::buildBrightness() {
         " outline:none; border:0px solid transparent; }"
     );
 
-    QObject::connect(s, &QSlider::valueChanged, this, [](int v){
-        {
-            QSettings s("Alternix", "wosp-shell");
-            s.setValue("brightness", v);
-        }
+    backlight = new WospBacklight(this);
 
-        double f = v / 100.0;
-        QProcess::startDetached(
-            "bash",
-            {"-c", QString("xrandr --output $(xrandr | awk '/ primary/{print $1; exit}') --brightness %1").arg(f)}
-        );
+    // The store debounces, so a drag ends up as one write
+    QObject::connect(s, &QSlider::valueChanged, this, [this, cfg](int v){
+        backlight->setPercent(v);
+        cfg->setInt("brightness", v);
     });
 
     v->addWidget(lbl);
@@ -438,64 +571,115 @@ QWidget* WospShell::buildBrightness() {
     return w;
 }
 
-QWidget* WospShell::loadPageSo(const QString &soPath, QLibrary &libKeepAlive, QWidget *fallback) {
-    libKeepAlive.setFileName(soPath);
-    if (libKeepAlive.load()) {
-        auto factory = reinterpret_cast<QWidget*(*)(QWidget*)>(libKeepAlive.resolve("make_page"));
-        if (factory) {
-            QWidget *p = factory(this);
-            if (p) return p;
+QWidget* WospShell::page(PageId id) {
+    PagePlugin &pp = pages[id];
+    if (pp.page) return pp.page;
+
+    pp.lib.setFileName(pp.soPath);
+    if (pp.lib.load()) {
+        auto factory = reinterpret_cast<QWidget*(*)(QWidget*)>(pp.lib.resolve("make_page"));
+        if (factory) pp.page = factory(this);
+        if (pp.page) {
+            pp.onShow    = reinterpret_cast<PageHook>(pp.lib.resolve("page_show"));
+            pp.onHide    = reinterpret_cast<PageHook>(pp.lib.resolve("page_hide"));
+            pp.onSuspend = reinterpret_cast<PageHook>(pp.lib.resolve("page_suspend"));
         }
     }
-    return fallback;
+    if (!pp.page) pp.page = pp.fallback();
+
+    pp.page->hide();
+    brightnessWidget->raise();
+    home->raise();
+    return pp.page;
+}
+
+void WospShell::showPage(PageId id) {
+    for (int i = 0; i < PageCount; ++i)
+        if (i != id) hidePage(PageId(i), false);
+
+    PagePlugin &pp = pages[id];
+    QWidget *w = page(id);
+    w->show();
+    if (!pp.visible) {
+        pp.visible = true;
+        if (pp.onShow) pp.onShow(w);
+    }
+}
+
+void WospShell::hidePage(PageId id, bool suspend) {
+    PagePlugin &pp = pages[id];
+    if (!pp.page) return;
+
+    pp.page->hide();
+    if (pp.visible) {
+        pp.visible = false;
+        if (pp.onHide) pp.onHide(pp.page);
+    }
+    if (suspend && pp.onSuspend) pp.onSuspend(pp.page);
+}
+
+// Builds one missing page per idle slot so startup stays responsive
+void WospShell::prewarmPages() {
+    for (int i = 0; i < PageCount; ++i) {
+        if (pages[i].page) continue;
+        page(PageId(i));
+        QTimer::singleShot(250, this, [this]{ prewarmPages(); });
+        return;
+    }
 }
 
 WospShell::WospShell() {
     setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint);
     setAttribute(Qt::WA_TranslucentBackground);
+    // paintEvent writes every pixel of the dirty region; skip Qt's clear
+    setAttribute(Qt::WA_OpaquePaintEvent);
 
     QRect g = QApplication::primaryScreen()->geometry();
     setGeometry(g);
 
-    topPix    = QPixmap(imgPath("top_curve.png"));
-    bottomPix = QPixmap(imgPath("bottom_curve.png"));
+    // Painted straight from the atlas mapping, no per-process copy
+    topImg    = image("top_curve.png");
+    bottomImg = image("bottom_curve.png");
 
-    topCurve = new QLabel(this);
-    bottomCurve = new QLabel(this);
     home = new HomeButton(this, this);
 
-    topCurve->setPixmap(topPix);
-    bottomCurve->setPixmap(bottomPix);
+    slideAnim = new QVariantAnimation(this);
+    connect(slideAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
+        setSlide(v.toReal());
+    });
+    connect(slideAnim, &QVariantAnimation::finished, this, [this] {
+        if (slideDone) slideDone();
+    });
 
     brightnessWidget = buildBrightness();
     brightnessWidget->hide();
 
-    QWidget *appsFallback = buildAppsPage();
-    appsFallback->hide();
-
-    QWidget *quickFallback = buildPlaceholder("Quick Settings is under construction");
-    quickFallback->hide();
-
-    QWidget *leftFallback = buildPlaceholder("Left Page is under construction");
-    leftFallback->hide();
-
-    QWidget *rightFallback = buildPlaceholder("Right Page is under construction");
-    rightFallback->hide();
-
-    appsPage = loadPageSo("/usr/local/bin/launcher.so", appsLib, appsFallback);
-    pageUp   = loadPageSo("/usr/local/bin/quicksettings.so", quickLib, quickFallback);
-    pageLeft = loadPageSo("/usr/local/bin/pageLeft.so", leftLib, leftFallback);
-    pageRight = loadPageSo("/usr/local/bin/pageRight.so", rightLib, rightFallback);
-
-    
-
-    //pageLeft  = buildPlaceholder("Left Page is under construction");
-    //pageRight = buildPlaceholder("Right Page is under construction");
+    auto plugin = [this](PageId id, const QString &so, std::function<QWidget*()> fallback) {
+        pages[id].soPath = so;
+        pages[id].fallback = fallback;
+    };
+    plugin(PageApps,  "/usr/local/bin/launcher.so",
+           [this]{ return buildAppsPage(); });
+    plugin(PageUp,    "/usr/local/bin/quicksettings.so",
+           [this]{ return buildPlaceholder("Quick Settings is under construction"); });
+    plugin(PageLeft,  "/usr/local/bin/pageLeft.so",
+           [this]{ return buildPlaceholder("Left Page is under construction"); });
+    plugin(PageRight, "/usr/local/bin/pageRight.so",
+           [this]{ return buildPlaceholder("Right Page is under construction"); });
+
+    launchStats = new WospLaunchStats(this);
+    launchTrace = new WospLaunchTrace::Tracer(this);
+
+    QTimer::singleShot(PREWARM_DELAY_MS, this, [this]{
+        prewarmPages();
+        prefetchTopApps();
+
+        // Only while the overlay is closed, never alongside a launch
+        auto *prefetch = new WospTimers::Periodic("app-prefetch", PREFETCH_PERIOD_MS, this,
+                                                  [this]{ if (!openState) prefetchTopApps(); });
+        prefetch->start();
+    });
 
-    appsPage->hide();
-    pageLeft->hide();
-    pageRight->hide();
-    pageUp->hide();
     home->hide();
 
     hide();
@@ -505,57 +689,72 @@ QWidget* WospShell::buildAppsPage() {
     QWidget *w = new QWidget(this);
     w->setGeometry(0, 180, width(), height() - 300);
 
-    scroll = new QScrollArea(w);
-    scroll->setGeometry(w->rect());
-    scroll->setStyleSheet("border:none;background:transparent;");
-    scroll->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    appModel = new AppModel(w);
+    appGrid = new AppGridView(w);
+    appGrid->setGeometry(w->rect());
+    appGrid->setItemDelegate(new AppDelegate(appGrid));
+    appGrid->setModel(appModel);
 
-    QWidget *container = new QWidget;
-    QGridLayout *grid = new QGridLayout(container);
-    grid->setSpacing(12);
-    grid->setContentsMargins(20,20,20,20);
+    connect(appGrid, &QListView::clicked, this, [this](const QModelIndex &i) {
+        launchApp(appModel->at(i.row()));
+    });
 
-    auto apps = loadApps();
-    for (int i = 0; i < apps.size(); ++i)
-        grid->addWidget(new AppTile(apps[i], this), i/4, i%4);
+    QVector<WospAppDb::Entry> db = WospAppDb::load();
+    populateApps(launcherApps(db));
 
-    scroll->setWidget(container);
-    scroll->setWidgetResizable(true);
+    // Keep the index (and the grid) current as packages come and go
+    appWatcher = new WospAppDb::Watcher(db, this);
+    appWatcher->onChanged = [this](const QVector<WospAppDb::Entry> &e) {
+        populateApps(launcherApps(e));
+    };
 
-    QScroller::grabGesture(scroll->viewport(), QScroller::TouchGesture);
-    QScroller::grabGesture(scroll->viewport(), QScroller::LeftMouseButtonGesture);
+    QScroller::grabGesture(appGrid->viewport(), QScroller::TouchGesture);
+    QScroller::grabGesture(appGrid->viewport(), QScroller::LeftMouseButtonGesture);
 
     return w;
 }
 
-void WospShell::showApps() {
-    pageLeft->hide();
-    pageRight->hide();
-    pageUp->hide();
-    appsPage->show();
+void WospShell::populateApps(const QList<AppEntry> &apps) {
+    allApps = apps;
+    refreshAppModel();
 }
 
-void WospShell::showLeft() {
-    appsPage->hide();
-    pageRight->hide();
-    pageUp->hide();
-    pageLeft->show();
+void WospShell::refreshAppModel() {
+    QList<AppEntry> top;
+    for (const QString &id : launchStats->top(APP_COLUMNS)) {
+        auto it = std::find_if(allApps.cbegin(), allApps.cend(),
+                               [&](const AppEntry &e){ return e.id == id; });
+        if (it != allApps.cend()) top.append(*it);
+    }
+    appModel->setApps(allApps, top);
 }
 
-void WospShell::showRight() {
-    appsPage->hide();
-    pageLeft->hide();
-    pageUp->hide();
-    pageRight->show();
+void WospShell::prefetchTopApps() {
+    launchStats->prefetch(PREFETCH_APPS);
 }
 
-void WospShell::showUp() {
-    appsPage->hide();
-    pageLeft->hide();
-    pageRight->hide();
-    pageUp->show();
+void WospShell::launchApp(const AppEntry &e) {
+    if (AppModel::isSpacer(e)) return;
+
+    closeOverlayAnimated();
+    QStringList a = e.exec.split(' ');
+    QString p = a.takeFirst();
+    QElapsedTimer since;
+    since.start();
+    qint64 pid = 0;
+    if (QProcess::startDetached(p, a, QString(), &pid)) {
+        launchTrace->begin(e.id, pid, since);
+        launchStats->recordLaunch(e.id, p, pid);
+    }
+
+    if (appModel) refreshAppModel();
 }
 
+void WospShell::showApps()  { showPage(PageApps); }
+void WospShell::showLeft()  { showPage(PageLeft); }
+void WospShell::showRight() { showPage(PageRight); }
+void WospShell::showUp()    { showPage(PageUp); }
+
 void WospShell::openOverlay() {
     if (openState) return;
     openState = true;
@@ -563,27 +762,14 @@ void WospShell::openOverlay() {
     if (barBottom) barBottom->hide();
     if (barTop)    barTop->hide();
 
+    slide = 0.0;
     showFullScreen();
     raise();
 
-    topCurve->move(0, -topPix.height());
-    bottomCurve->move(0, height());
     home->hide();
     brightnessWidget->hide();
 
-    auto *aTop = new QPropertyAnimation(topCurve, "pos");
-    auto *aBot = new QPropertyAnimation(bottomCurve, "pos");
-
-    aTop->setEndValue(QPoint(0, 0));
-    aBot->setEndValue(QPoint(0, height() - bottomPix.height()));
-    aTop->setDuration(300);
-    aBot->setDuration(300);
-
-    auto *grp = new QParallelAnimationGroup(this);
-    grp->addAnimation(aTop);
-    grp->addAnimation(aBot);
-
-    connect(grp, &QParallelAnimationGroup::finished, this, [this] {
+    animateSlide(1.0, 300, [this] {
 
         brightnessWidget->setGeometry(
             0,
@@ -594,8 +780,8 @@ void WospShell::openOverlay() {
         brightnessWidget->show();
         brightnessWidget->raise();
 
-        int by = height() - bottomPix.height();
-        int hy = by + (bottomPix.height() / 2) - (home->height() / 2);
+        int by = height() - bottomImg.height();
+        int hy = by + (bottomImg.height() / 2) - (home->height() / 2);
         home->move(width() / 2 - home->width() / 2, hy);
         home->show();
         home->raise();
@@ -605,38 +791,18 @@ void WospShell::openOverlay() {
 
         openToUp = false;
     });
-
-    grp->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
 void WospShell::closeOverlayAnimated() {
     if (!openState) return;
     openState = false;
 
-    appsPage->hide();
-    pageLeft->hide();
-    pageRight->hide();
-    pageUp->hide();
+    for (int i = 0; i < PageCount; ++i)
+        hidePage(PageId(i), true);
     home->hide();
     brightnessWidget->hide();
 
-    auto *aTop = new QPropertyAnimation(topCurve, "pos");
-    auto *aBot = new QPropertyAnimation(bottomCurve, "pos");
-
-    aTop->setEndValue(QPoint(0, -topPix.height()));
-    aBot->setEndValue(QPoint(0, height()));
-    aTop->setDuration(250);
-    aBot->setDuration(250);
-
-    auto *grp = new QParallelAnimationGroup(this);
-    grp->addAnimation(aTop);
-    grp->addAnimation(aBot);
-
-    connect(grp, &QParallelAnimationGroup::finished, this, [this] {
-        finalHide();
-    });
-
-    grp->start(QAbstractAnimation::DeleteWhenStopped);
+    animateSlide(0.0, 250, [this] { finalHide(); });
 }
 
 void WospShell::finalHide() {
@@ -651,19 +817,116 @@ void WospShell::finalHide() {
     }
 }
 
-void WospShell::paintEvent(QPaintEvent *) {
+QRect WospShell::topCurveRect() const {
+    int h = topImg.height();
+    return QRect(0, qRound(-h * (1.0 - slide)), topImg.width(), h);
+}
+
+QRect WospShell::bottomCurveRect() const {
+    int h = bottomImg.height();
+    return QRect(0, height() - qRound(h * slide), bottomImg.width(), h);
+}
+
+void WospShell::setSlide(qreal v) {
+    QRegion dirty = QRegion(topCurveRect()) + bottomCurveRect();
+    slide = v;
+    dirty += topCurveRect();
+    dirty += bottomCurveRect();
+    update(dirty);
+}
+
+void WospShell::animateSlide(qreal to, int ms, std::function<void()> done) {
+    slideAnim->stop();
+    slideDone = std::move(done);
+    slideAnim->setStartValue(slide);
+    slideAnim->setEndValue(to);
+    slideAnim->setDuration(ms);
+    slideAnim->start();
+}
+
+void WospShell::paintEvent(QPaintEvent *e) {
     QPainter p(this);
-    p.fillRect(rect(), QColor(0,0,0,FADE_ALPHA));
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+
+    if (slide >= 1.0) {
+        if (restFrame.size() != size()) {
+            restFrame = QPixmap(size());
+            restFrame.fill(QColor(0,0,0,FADE_ALPHA));
+            QPainter rp(&restFrame);
+            rp.drawImage(0, 0, topImg);
+            rp.drawImage(0, height() - bottomImg.height(), bottomImg);
+        }
+        for (const QRect &r : e->region())
+            p.drawPixmap(r, restFrame, r);
+        return;
+    }
+
+    for (const QRect &r : e->region())
+        p.fillRect(r, QColor(0,0,0,FADE_ALPHA));
+
+    p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    QRect t = topCurveRect(), b = bottomCurveRect();
+    if (e->region().intersects(t)) p.drawImage(t.topLeft(), topImg);
+    if (e->region().intersects(b)) p.drawImage(b.topLeft(), bottomImg);
+}
+
+void WospShell::resizeEvent(QResizeEvent *e) {
+    restFrame = QPixmap();
+    QWidget::resizeEvent(e);
 }
 
 /* ───────────────────────── MAIN ───────────────────────── */
 
+// Everything main() builds on the QApplication; shared with wosp-host
+static void startShell() {
+    // Page plugins draw their pills and cards with it
+    WospTheme::install();
+
+    WospShell *shell = new WospShell;
+    ActivationBar *bar = new ActivationBar(shell);
+    ActivationBarTop *topBar = new ActivationBarTop(shell);
+    shell->setActivationBar(bar);
+    shell->setTopActivationBar(topBar);
+
+    // Shell actions other components trigger over wosp-bus
+    WospCommands *commands = new WospCommands(shell);
+    commands->handle("overlay.open", [shell](const QByteArray &from) {
+        shell->requestOpenToUp(from == "top");
+        shell->openOverlay();
+    });
+    commands->handle("overlay.close", [shell](const QByteArray &) {
+        shell->closeOverlayAnimated();
+    });
+    commands->handle("power.menu", [](const QByteArray &) {
+        // Straight to the zygote, without an osm-launch in between
+        if (WospZygote::launch({"osm-power"}) < 0)
+            QProcess::startDetached("osm-power", QStringList());
+    });
+}
+
+#ifdef WOSP_HOST_ENTRY
+// Built as /usr/local/lib/wosp/host/wosp-shell.so and loaded by wosp-host
+extern "C" int wosp_host_main(int, char **)
+{
+    startShell();
+    return 0;
+}
+#else
 int main(int argc, char **argv) {
+    if (argc > 1 && QString(argv[1]) == "--launch-stats") {
+        fputs(WospLaunchTrace::report().toLocal8Bit().constData(), stdout);
+        return 0;
+    }
+
     QApplication app(argc, argv);
-    WospShell shell;
-    ActivationBar bar(&shell);
-    ActivationBarTop topBar(&shell);
-    shell.setActivationBar(&bar);
-    shell.setTopActivationBar(&topBar);
+
+    // Install time: decode the images now instead of on first start
+    if (argc > 1 && QString(argv[1]) == "--pack-atlas") {
+        QString dir = imageDir();
+        return WospAtlas::pack(dir, WospAtlas::atlasPath(dir)) ? 0 : 1;
+    }
+
+    startShell();
     return app.exec();
 }
+#endif